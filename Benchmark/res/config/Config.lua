@@ -0,0 +1,20 @@
+libResFolder = "E:/Dev/SgOgl/SgOglLib/res"
+
+window = {
+    title = "Benchmark",
+    compatibleProfile = false,
+    debugContext = false,
+    antialiasing = false,
+    printFrameRate = false,
+    glMajor = 4,
+    glMinor = 3,
+    fps = 60.0
+}
+
+projection = {
+    fovDeg = 70.0,
+    width = 1024,
+    height = 768,
+    near = 0.1,
+    far = 10000.0
+}
@@ -0,0 +1,78 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: AllocationCounter.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include "AllocationCounter.h"
+
+namespace
+{
+    std::atomic<std::thread::id> mainThread;
+    std::atomic<uint64_t> mainThreadAllocations{ 0 };
+    std::atomic<uint64_t> workerThreadAllocations{ 0 };
+}
+
+//-------------------------------------------------
+// AllocationCounter
+//-------------------------------------------------
+
+void benchmark::AllocationCounter::SetMainThread()
+{
+    mainThread = std::this_thread::get_id();
+}
+
+uint64_t benchmark::AllocationCounter::GetMainThreadAllocations()
+{
+    return mainThreadAllocations;
+}
+
+uint64_t benchmark::AllocationCounter::GetWorkerThreadAllocations()
+{
+    return workerThreadAllocations;
+}
+
+void benchmark::AllocationCounter::Count()
+{
+    if (std::this_thread::get_id() == mainThread.load(std::memory_order_relaxed))
+    {
+        mainThreadAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        workerThreadAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+//-------------------------------------------------
+// Global operator new / delete
+//-------------------------------------------------
+
+void* operator new(const std::size_t t_size)
+{
+    benchmark::AllocationCounter::Count();
+
+    if (auto* ptr{ std::malloc(t_size ? t_size : 1) })
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* t_ptr) noexcept
+{
+    std::free(t_ptr);
+}
+
+void operator delete(void* t_ptr, std::size_t) noexcept
+{
+    std::free(t_ptr);
+}
@@ -0,0 +1,36 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: AllocationCounter.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <cstdint>
+
+namespace benchmark
+{
+    /**
+     * @brief Counts the calls of the global operator new, which is replaced in AllocationCounter.cpp.
+     *        The allocations of the main thread and of all other threads are counted separately.
+     */
+    class AllocationCounter
+    {
+    public:
+        /**
+         * @brief Marks the calling thread as the main thread.
+         */
+        static void SetMainThread();
+
+        [[nodiscard]] static uint64_t GetMainThreadAllocations();
+        [[nodiscard]] static uint64_t GetWorkerThreadAllocations();
+
+        /**
+         * @brief Called by the replaced operator new.
+         */
+        static void Count();
+    };
+}
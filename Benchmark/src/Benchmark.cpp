@@ -0,0 +1,62 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: Benchmark.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include "SgOgl.h"
+#include "SgOglEntryPoint.h"
+#include "BenchmarkState.h"
+
+class Benchmark final : public sg::ogl::Application
+{
+public:
+    //-------------------------------------------------
+    // Ctors. / Dtor.
+    //-------------------------------------------------
+
+    Benchmark() = delete;
+
+    explicit Benchmark(const std::string& t_configFileName)
+        : Application{ t_configFileName }
+    {
+        benchmark::AllocationCounter::SetMainThread();
+    }
+
+    Benchmark(const Benchmark& t_other) = delete;
+    Benchmark(Benchmark&& t_other) noexcept = delete;
+    Benchmark& operator=(const Benchmark& t_other) = delete;
+    Benchmark& operator=(Benchmark&& t_other) noexcept = delete;
+
+    ~Benchmark() noexcept override = default;
+
+protected:
+    //-------------------------------------------------
+    // Override
+    //-------------------------------------------------
+
+    void RegisterStates() override
+    {
+        GetStateStack().RegisterState<BenchmarkState>(sg::ogl::state::GAME);
+    }
+
+    void Init() override
+    {
+        GetStateStack().PushState(sg::ogl::state::GAME);
+    }
+
+private:
+
+};
+
+//-------------------------------------------------
+// EntryPoint
+//-------------------------------------------------
+
+std::unique_ptr<sg::ogl::Application> sg::ogl::create_application()
+{
+    return std::make_unique<Benchmark>("res/config/Config.lua");
+}
@@ -0,0 +1,79 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: BenchmarkState.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <cstdio>
+#include "SgOgl.h"
+#include "AllocationCounter.h"
+#include "DepthSorterBenchmark.h"
+#include "InstanceCullBenchmark.h"
+#include "QuadtreeBenchmark.h"
+
+/**
+ * @brief Runs all benchmarks once the OpenGL context exists and closes the window afterwards.
+ */
+class BenchmarkState : public sg::ogl::state::State
+{
+public:
+    //-------------------------------------------------
+    // Ctors. / Dtor.
+    //-------------------------------------------------
+
+    BenchmarkState() = delete;
+
+    explicit BenchmarkState(sg::ogl::state::StateStack* t_stateStack)
+        : State{ t_stateStack, "BenchmarkState" }
+    {
+        Init();
+    }
+
+    BenchmarkState(const BenchmarkState& t_other) = delete;
+    BenchmarkState(BenchmarkState&& t_other) noexcept = delete;
+    BenchmarkState& operator=(const BenchmarkState& t_other) = delete;
+    BenchmarkState& operator=(BenchmarkState&& t_other) noexcept = delete;
+
+    ~BenchmarkState() noexcept override = default;
+
+    //-------------------------------------------------
+    // Logic
+    //-------------------------------------------------
+
+    bool Input() override
+    {
+        return true;
+    }
+
+    bool Update(double t_dt) override
+    {
+        return true;
+    }
+
+    void Render() override
+    {
+    }
+
+protected:
+
+private:
+    //-------------------------------------------------
+    // Helper
+    //-------------------------------------------------
+
+    void Init() const
+    {
+        auto ok{ benchmark::RunDepthSorterBenchmark() };
+        ok = benchmark::RunQuadtreeBenchmark(GetApplicationContext()) && ok;
+        ok = benchmark::RunInstanceCullBenchmark(GetApplicationContext()) && ok;
+
+        std::printf("Benchmark %s\n", ok ? "passed" : "failed");
+
+        glfwSetWindowShouldClose(GetApplicationContext()->GetWindow().GetWindowHandle(), GLFW_TRUE);
+    }
+};
@@ -0,0 +1,167 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: DepthSorterBenchmark.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "DepthSorterBenchmark.h"
+#include "particle/DepthSorter.h"
+#include "particle/ParticleStore.h"
+
+namespace
+{
+    constexpr uint32_t NUMBER_OF_PARTICLES{ 100000 };
+    constexpr uint32_t NUMBER_OF_FRAMES{ 300 };
+
+    /**
+     * @brief The part of the particles that dies each frame.
+     */
+    constexpr float DEATH_RATE{ 0.02f };
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    struct Scenario
+    {
+        const char* name;
+
+        /**
+         * @brief The distance a particle moves per frame along each axis (at most).
+         */
+        float particleSpeed;
+
+        /**
+         * @brief The rotation of the camera around the cloud per frame in radians.
+         */
+        float cameraSpeed;
+    };
+
+    void Spawn(sg::ogl::particle::ParticleStore& t_store, std::mt19937& t_random)
+    {
+        std::uniform_real_distribution<float> position{ -100.0f, 100.0f };
+        std::uniform_real_distribution<float> velocity{ -1.0f, 1.0f };
+
+        while (t_store.aliveCount < NUMBER_OF_PARTICLES)
+        {
+            const auto i{ t_store.Add() };
+            t_store.px[i] = position(t_random);
+            t_store.py[i] = position(t_random);
+            t_store.pz[i] = position(t_random);
+            t_store.vx[i] = velocity(t_random);
+            t_store.vy[i] = velocity(t_random);
+            t_store.vz[i] = velocity(t_random);
+            t_store.life[i] = 1.0f;
+        }
+    }
+
+    bool RunScenario(const Scenario& t_scenario)
+    {
+        using sg::ogl::particle::DepthSorter;
+        using sg::ogl::particle::ParticleStore;
+
+        std::mt19937 random{ 42 };
+        std::uniform_real_distribution<float> chance{ 0.0f, 1.0f };
+
+        ParticleStore store;
+        store.Resize(NUMBER_OF_PARTICLES);
+        Spawn(store, random);
+
+        DepthSorter depthSorter;
+        std::vector<float> depths;
+        std::vector<uint32_t> reference;
+
+        Clock::duration depthSorterTime{ 0 };
+        Clock::duration stdSortTime{ 0 };
+        auto incrementalFrames{ 0u };
+        auto mismatches{ 0u };
+
+        for (auto frame{ 0u }; frame < NUMBER_OF_FRAMES; ++frame)
+        {
+            // move the particles, kill some of them and fill the gaps with new ones
+            for (auto i{ 0u }; i < store.aliveCount; ++i)
+            {
+                store.px[i] += store.vx[i] * t_scenario.particleSpeed;
+                store.py[i] += store.vy[i] * t_scenario.particleSpeed;
+                store.pz[i] += store.vz[i] * t_scenario.particleSpeed;
+
+                if (chance(random) < DEATH_RATE)
+                {
+                    store.life[i] = 0.0f;
+                }
+            }
+
+            store.RemoveDead();
+            Spawn(store, random);
+
+            // a camera which circles the cloud; the depth is the view space z
+            const auto angle{ static_cast<float>(frame) * t_scenario.cameraSpeed };
+            const auto dirX{ std::sin(angle) };
+            const auto dirZ{ std::cos(angle) };
+
+            depths.resize(store.aliveCount);
+            for (auto i{ 0u }; i < store.aliveCount; ++i)
+            {
+                depths[i] = dirX * store.px[i] + dirZ * store.pz[i] - 300.0f;
+            }
+
+            auto start{ Clock::now() };
+            const auto& order{ depthSorter.Sort(depths.data(), store.id.data(), store.aliveCount) };
+            depthSorterTime += Clock::now() - start;
+
+            incrementalFrames += depthSorter.IsIncremental() ? 1 : 0;
+
+            start = Clock::now();
+            reference.resize(store.aliveCount);
+            std::iota(reference.begin(), reference.end(), 0u);
+            std::sort(reference.begin(), reference.end(), [&depths](const uint32_t t_a, const uint32_t t_b) { return depths[t_a] < depths[t_b]; });
+            stdSortTime += Clock::now() - start;
+
+            // equal depths may be in any order, so the depths are compared
+            for (auto n{ 0u }; n < store.aliveCount; ++n)
+            {
+                if (depths[order[n]] != depths[reference[n]])
+                {
+                    ++mismatches;
+                    break;
+                }
+            }
+        }
+
+        const auto toMs{ [](const Clock::duration t_duration) { return std::chrono::duration<double, std::milli>(t_duration).count() / NUMBER_OF_FRAMES; } };
+
+        std::printf("  %s\n", t_scenario.name);
+        std::printf("    DepthSorter %8.3f ms/frame (%u of %u frames incremental)\n", toMs(depthSorterTime), incrementalFrames, NUMBER_OF_FRAMES);
+        std::printf("    std::sort   %8.3f ms/frame\n", toMs(stdSortTime));
+        std::printf("    frames with a different order: %u\n", mismatches);
+
+        return mismatches == 0;
+    }
+}
+
+bool benchmark::RunDepthSorterBenchmark()
+{
+    const Scenario scenarios[]{
+        { "drifting particles, fixed camera", 0.001f, 0.0f },
+        { "drifting particles, orbiting camera", 0.001f, 0.001f },
+        { "fast particles, fast orbiting camera", 0.1f, 0.01f },
+    };
+
+    std::printf("DepthSorter vs std::sort: %u particles, %u frames, %.0f%% of the particles replaced per frame\n", NUMBER_OF_PARTICLES, NUMBER_OF_FRAMES, DEATH_RATE * 100.0f);
+
+    auto ok{ true };
+    for (const auto& scenario : scenarios)
+    {
+        ok = RunScenario(scenario) && ok;
+    }
+
+    return ok;
+}
@@ -0,0 +1,21 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: DepthSorterBenchmark.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+namespace benchmark
+{
+    /**
+     * @brief Sorts a moving particle cloud over many frames with the DepthSorter and with
+     *        std::sort and prints the timings. Particles die and are born every frame, so
+     *        the ParticleStore is compacted between the sorts.
+     * @return True if both sorts produced the same back-to-front order in every frame.
+     */
+    bool RunDepthSorterBenchmark();
+}
@@ -0,0 +1,98 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: InstanceCullBenchmark.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include "InstanceCullBenchmark.h"
+#include "SgOgl.h"
+
+namespace
+{
+    constexpr auto NR_INSTANCES{ 200000 };
+    constexpr auto FIELD_SIZE{ 4000.0f };
+    constexpr auto NR_VIEWS{ 16 };
+    constexpr auto HEIGHT{ 50.0f };
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    std::vector<sg::ogl::math::Transform> CreateTransforms()
+    {
+        // a fixed seed, so that each run tests the same instances
+        std::mt19937 generator{ 42 };
+        std::uniform_real_distribution<float> position{ -FIELD_SIZE * 0.5f, FIELD_SIZE * 0.5f };
+        std::uniform_real_distribution<float> rotation{ 0.0f, 360.0f };
+        std::uniform_real_distribution<float> scale{ 0.5f, 3.0f };
+
+        std::vector<sg::ogl::math::Transform> transforms(NR_INSTANCES);
+        for (auto& transform : transforms)
+        {
+            transform.position = glm::vec3(position(generator), 0.0f, position(generator));
+            transform.rotation.y = rotation(generator);
+            transform.scale = glm::vec3(scale(generator));
+        }
+
+        return transforms;
+    }
+}
+
+bool benchmark::RunInstanceCullBenchmark(sg::ogl::Application* t_application)
+{
+    sg::ogl::scene::Scene scene{ t_application };
+
+    scene.cameras.emplace("benchmark_camera", std::make_unique<sg::ogl::camera::FirstPersonCamera>("benchmark_camera", t_application));
+    scene.SetCurrentCameraByName("benchmark_camera");
+    auto& camera{ scene.GetCurrentCamera() };
+
+    // a primitive of the Sandbox
+    auto model{ t_application->GetModelManager().GetModel("../Sandbox/res/primitive/sphere/sphere.obj") };
+    model->AddTransformVbo(CreateTransforms());
+
+    std::printf("Instance culling: %u instances in %u cells, %d views\n", model->GetNumberOfInstances(), model->GetNumberOfInstanceCells(), NR_VIEWS);
+
+    auto ok{ true };
+    Clock::duration cpuTime{ 0 };
+    Clock::duration gpuTime{ 0 };
+
+    for (auto view{ 0 }; view < NR_VIEWS; ++view)
+    {
+        // turning in the middle of the field; every second view without the distance test
+        camera.SetPosition(glm::vec3(0.0f, HEIGHT, 0.0f));
+        camera.SetYaw(360.0f * static_cast<float>(view) / NR_VIEWS);
+        camera.SetPitch(-5.0f);
+        camera.Update(1.0 / 60.0);
+        camera.UpdateFrustumPlanes();
+
+        const auto maxDistance{ view % 2 ? 0.0f : FIELD_SIZE * 0.25f };
+        const auto& planes{ camera.GetFrustumPlanes() };
+
+        auto start{ Clock::now() };
+        const auto cpuVisible{ model->CullInstances(planes, camera.GetPosition(), maxDistance) };
+        cpuTime += Clock::now() - start;
+
+        start = Clock::now();
+        model->CullInstancesGpu(planes, camera.GetPosition(), maxDistance);
+        const auto gpuVisible{ model->ReadNumberOfVisibleInstancesGpu() };
+        gpuTime += Clock::now() - start;
+
+        std::printf("  view %2d: %7u visible on the Cpu, %7u on the Gpu%s\n", view, cpuVisible, gpuVisible, cpuVisible == gpuVisible ? "" : " <- mismatch");
+
+        ok = cpuVisible == gpuVisible && ok;
+    }
+
+    std::printf("  %8.3f ms/view on the Cpu, %8.3f ms/view on the Gpu (with read back)\n",
+        std::chrono::duration<double, std::milli>(cpuTime).count() / NR_VIEWS,
+        std::chrono::duration<double, std::milli>(gpuTime).count() / NR_VIEWS
+    );
+
+    // the model is shared with the ModelManager
+    model->ShowAllInstances();
+
+    return ok;
+}
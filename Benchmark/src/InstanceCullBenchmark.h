@@ -0,0 +1,29 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: InstanceCullBenchmark.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+namespace sg::ogl
+{
+    class Application;
+}
+
+namespace benchmark
+{
+    /**
+     * @brief Scatters many instances of a model and culls them for several camera views with
+     *        Model::CullInstances on the worker threads and with Model::CullInstancesGpu. The
+     *        instanceCount of the indirect draw command is read back and compared with the
+     *        survivors of the Cpu test for the same planes and distance. Runs headless,
+     *        e.g. under llvmpipe.
+     * @param t_application The Application with an OpenGL 4.3 context.
+     * @return True if both paths kept the same number of instances in every view.
+     */
+    bool RunInstanceCullBenchmark(sg::ogl::Application* t_application);
+}
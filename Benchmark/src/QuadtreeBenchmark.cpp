@@ -0,0 +1,115 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: QuadtreeBenchmark.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <glm/gtc/constants.hpp>
+#include "QuadtreeBenchmark.h"
+#include "AllocationCounter.h"
+#include "SgOgl.h"
+
+namespace
+{
+    constexpr auto FRAMES_PER_LAP{ 600 };
+    constexpr auto RADIUS{ 2500.0f };
+    constexpr auto HEIGHT{ 400.0f };
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    struct LapResult
+    {
+        uint64_t mainThreadAllocations{ 0 };
+        uint64_t workerThreadAllocations{ 0 };
+        uint64_t splits{ 0 };
+        uint64_t merges{ 0 };
+        uint64_t evaluatedNodes{ 0 };
+        Clock::duration time{ 0 };
+    };
+
+    LapResult FlyLap(sg::ogl::scene::Scene& t_scene, sg::ogl::terrain::TerrainQuadtree& t_terrain)
+    {
+        auto& camera{ t_scene.GetCurrentCamera() };
+
+        LapResult result;
+        for (auto frame{ 0 }; frame < FRAMES_PER_LAP; ++frame)
+        {
+            // on a circle around the terrain center, looking along the path and a bit down
+            const auto angle{ glm::two_pi<float>() * static_cast<float>(frame) / FRAMES_PER_LAP };
+            camera.SetPosition(glm::vec3(std::cos(angle) * RADIUS, HEIGHT, std::sin(angle) * RADIUS));
+            camera.SetYaw(glm::degrees(angle) + 90.0f);
+            camera.SetPitch(-10.0f);
+
+            // no key is pressed, so this only updates the camera vectors
+            camera.Update(1.0 / 60.0);
+            camera.UpdateFrustumPlanes();
+
+            const auto mainThreadAllocations{ benchmark::AllocationCounter::GetMainThreadAllocations() };
+            const auto workerThreadAllocations{ benchmark::AllocationCounter::GetWorkerThreadAllocations() };
+            const auto start{ Clock::now() };
+
+            t_terrain.UpdateQuadtree();
+            t_terrain.WaitForUpdate();
+
+            result.time += Clock::now() - start;
+            result.mainThreadAllocations += benchmark::AllocationCounter::GetMainThreadAllocations() - mainThreadAllocations;
+            result.workerThreadAllocations += benchmark::AllocationCounter::GetWorkerThreadAllocations() - workerThreadAllocations;
+            result.splits += t_terrain.GetNumberOfSplits();
+            result.merges += t_terrain.GetNumberOfMerges();
+            result.evaluatedNodes += t_terrain.GetNumberOfEvaluatedNodes();
+        }
+
+        return result;
+    }
+
+    void PrintLap(const char* t_name, const LapResult& t_result)
+    {
+        std::printf("  %s\n", t_name);
+        std::printf("    %8.3f ms/update, %llu evaluated nodes, %llu splits, %llu merges\n",
+            std::chrono::duration<double, std::milli>(t_result.time).count() / FRAMES_PER_LAP,
+            static_cast<unsigned long long>(t_result.evaluatedNodes),
+            static_cast<unsigned long long>(t_result.splits),
+            static_cast<unsigned long long>(t_result.merges)
+        );
+        std::printf("    heap allocations: %llu on the worker threads (lod selection), %llu on the main thread (jobs and leaf deltas)\n",
+            static_cast<unsigned long long>(t_result.workerThreadAllocations),
+            static_cast<unsigned long long>(t_result.mainThreadAllocations)
+        );
+    }
+}
+
+bool benchmark::RunQuadtreeBenchmark(sg::ogl::Application* t_application)
+{
+    sg::ogl::scene::Scene scene{ t_application };
+
+    scene.cameras.emplace("benchmark_camera", std::make_unique<sg::ogl::camera::FirstPersonCamera>("benchmark_camera", t_application));
+    scene.SetCurrentCameraByName("benchmark_camera");
+
+    // the terrain of the Sandbox; the heightmap is taken from its resources
+    auto terrainConfig{ std::make_shared<sg::ogl::terrain::TerrainConfig>(t_application) };
+    terrainConfig->scaleXz = 8000.0f;
+    terrainConfig->scaleY = 1700.0f;
+    terrainConfig->rootNodes = 12;
+    terrainConfig->normalStrength = 60.0f;
+    terrainConfig->lodRanges = { 1750, 874, 386, 192, 100, 50, 0, 0 };
+    terrainConfig->use16BitHeightmap = true;
+    terrainConfig->InitMapsAndMorphing("../Sandbox/res/heightmap/ruhpolding/Ruhpolding8km.png");
+
+    sg::ogl::terrain::TerrainQuadtree terrain{ &scene, terrainConfig };
+
+    std::printf("TerrainQuadtree: %u chunks, %d frames per lap\n", terrain.GetNumberOfChunks(), FRAMES_PER_LAP);
+
+    const auto warmUp{ FlyLap(scene, terrain) };
+    const auto steadyState{ FlyLap(scene, terrain) };
+
+    PrintLap("first lap (warm-up)", warmUp);
+    PrintLap("second lap (steady state)", steadyState);
+
+    return steadyState.mainThreadAllocations == 0 && steadyState.workerThreadAllocations == 0;
+}
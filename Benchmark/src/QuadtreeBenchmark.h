@@ -0,0 +1,29 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: QuadtreeBenchmark.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+namespace sg::ogl
+{
+    class Application;
+}
+
+namespace benchmark
+{
+    /**
+     * @brief Flies a camera twice along the same circle over a terrain and counts the heap
+     *        allocations of each TerrainQuadtree update. The first lap fills the NodePool and
+     *        the leaf lists; in the second lap, neither the lod selection on the worker threads
+     *        nor the start of the chunk jobs and the publishing of the leaves on the main thread
+     *        must allocate.
+     * @param t_application The Application with an OpenGL context.
+     * @return True if no thread allocated in the second lap.
+     */
+    bool RunQuadtreeBenchmark(sg::ogl::Application* t_application);
+}
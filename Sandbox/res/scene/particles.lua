@@ -24,6 +24,7 @@ firstPersonCamera:SetMouseSensitivity(0.1)
 ------------------
 
 scene:SetCurrentCamera("first_person_camera1")
+scene:SetParticleBudget(10000)
 
 --------------------
 -- Load resources --
@@ -43,7 +44,11 @@ particleSystem:SetSpeed(1.0)
 particleSystem:SetGravityEffect(-0.1)
 particleSystem:SetLifeTime(2.0)
 particleSystem:SetMaxScale(10.0)
+particleSystem:SetCapacity(128)
+particleSystem:SetLodDistances(100.0, 400.0)
 particleSystem.instancing = true
+--particleSystem.gpu = true
+--particleSystem.alphaBlending = true
 
 --particleSystem = ParticleSystem.new("fire", textureId, 8, 24.0, 1.0, -0.1, 2.0, 10.0, scene)
 
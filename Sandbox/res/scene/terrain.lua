@@ -1,69 +1,3 @@
----------------
--- Functions --
----------------
-
-function RandomFloat(lower, greater)
-    return lower + math.random()  * (greater - lower);
-end
-
-function CreateGrassInstancesData()
-    instancesData = {}
-
-    plantHeight = 8.0
-
-    i = 1000000
-    c = 0
-
-    while (c < i)
-    do
-        x = RandomFloat(-3980.0, 3980.0)
-        z = RandomFloat(-3980.0, 3980.0)
-        height = terrainConfig:GetHeightAt(x, z, RandomFloat(0.01, 0.02), RandomFloat(0.3, 0.5))
-
-        if (height > 0.0) then
-            t = Transform.new()
-            t.position = Vec3.new(x, height + plantHeight, z)
-            t.rotation = Vec3.new(180.0, 0.0, 0.0)
-            t.scale = Vec3.new(plantHeight)
-
-            instancesData[c] = t
-
-            c = c + 1
-        end
-    end
-
-    return instancesData
-end
-
-function CreateTreeInstancesData()
-    instancesData = {}
-
-    plantHeight = 36.0
-
-    i = 250000
-    c = 0
-
-    while (c < i)
-    do
-        x = RandomFloat(-3980.0, 3980.0)
-        z = RandomFloat(-3980.0, 3980.0)
-        height = terrainConfig:GetHeightAt(x, z, RandomFloat(0.07, 0.08), 0.9)
-
-        if (height > 0.0) then
-            t = Transform.new()
-            t.position = Vec3.new(x, height + plantHeight, z)
-            t.rotation = Vec3.new(180.0, 0.0, 0.0)
-            t.scale = Vec3.new(plantHeight)
-
-            instancesData[c] = t
-
-            c = c + 1
-        end
-    end
-
-    return instancesData
-end
-
 ------------------
 -- Create Scene --
 ------------------
@@ -120,6 +54,7 @@ terrainConfig.rootNodes = 12
 terrainConfig.normalStrength = 60.0
 terrainConfig.lodRanges = { 1750, 874, 386, 192, 100, 50, 0, 0 }
 terrainConfig.use16BitHeightmap = true
+terrainConfig.mapCachePath = "res/cache/terrain"
 terrainConfig:InitMapsAndMorphing("res/heightmap/ruhpolding/Ruhpolding8km.png")
 terrainConfig:InitTextures(
     "res/terrain/terrain0/Grass (Hill).jpg",
@@ -141,13 +76,34 @@ ecs:AddTerrainQuadtreeComponent(terrainEntity, terrain)
 
 -- grass instances
 
+grassScatter = VegetationScatter.new(applicationContext)
+grassScatter.count = 1000000
+grassScatter.minHeight = 0.015
+grassScatter.maxHeight = 0.4
+grassScatter.minScale = 8.0
+grassScatter.maxScale = 8.0
+grassScatter.baseRotation = Vec3.new(180.0, 0.0, 0.0)
+grassScatter.heightOffset = 1.0
+grassScatter.seed = 1
+
 grassEntity = ecs:CreateEntity()
-ecs:AddModelInstancesComponent(grassEntity, grass, false, true, CreateGrassInstancesData())
+ecs:AddScatteredModelInstancesComponent(grassEntity, grass, false, true, grassScatter, terrainConfig)
 
 -- tree instances
 
+treeScatter = VegetationScatter.new(applicationContext)
+treeScatter.count = 250000
+treeScatter.minHeight = 0.075
+treeScatter.maxHeight = 0.9
+treeScatter.maxSlope = 40.0
+treeScatter.minScale = 30.0
+treeScatter.maxScale = 42.0
+treeScatter.baseRotation = Vec3.new(180.0, 0.0, 0.0)
+treeScatter.heightOffset = 1.0
+treeScatter.seed = 2
+
 treeEntity = ecs:CreateEntity()
-ecs:AddModelInstancesComponent(treeEntity, tree, false, true, CreateTreeInstancesData())
+ecs:AddScatteredModelInstancesComponent(treeEntity, tree, false, true, treeScatter, terrainConfig)
 
 -- sun
 
@@ -0,0 +1,54 @@
+#version 330
+
+// impostor/Fragment.frag
+
+// In
+
+in vec2 vUv;
+
+// Out
+
+out vec4 fragColor;
+
+// Types
+
+struct DirectionalLight
+{
+    vec3 direction;
+    vec3 diffuseIntensity;
+    vec3 specularIntensity;
+};
+
+// Uniforms
+
+uniform int numDirectionalLights;
+uniform DirectionalLight directionalLights[2]; // max 2 directional lights
+
+uniform vec3 ambientIntensity;
+
+uniform sampler2D impostorMap;
+
+// Main
+
+void main()
+{
+    vec4 diffuse = texture(impostorMap, vUv);
+
+    if (diffuse.a < 0.5)
+    {
+        discard;
+    }
+
+    // a quad has no useful normal; light it from above like fake normals
+    vec3 normal = vec3(0.0, 1.0, 0.0);
+
+    vec3 result = ambientIntensity * diffuse.rgb;
+
+    for(int i = 0; i < numDirectionalLights; ++i)
+    {
+        vec3 lightDir = normalize(-directionalLights[i].direction);
+        result += directionalLights[i].diffuseIntensity * max(dot(normal, lightDir), 0.0) * diffuse.rgb;
+    }
+
+    fragColor = vec4(result, 1.0);
+}
@@ -0,0 +1,59 @@
+#version 330
+
+// impostor/Vertex.vert
+
+// In
+
+layout (location = 0) in vec2 aPosition;
+layout (location = 5) in vec3 aInstancePosition;
+layout (location = 6) in vec4 aInstanceRotation;
+layout (location = 7) in float aInstanceScale;
+
+// Out
+
+out vec2 vUv;
+
+// Uniforms
+
+uniform mat4 projectionMatrix;
+uniform mat4 viewMatrix;
+uniform vec3 cameraPosition;
+
+uniform vec3 origin;         // the bottom center of the quad in model space
+uniform vec2 size;           // the half width and the height of the quad in model space
+uniform float numberOfViews;
+
+// Const
+
+const float TWO_PI = 6.28318530718;
+
+// Function
+
+vec3 Rotate(vec4 q, vec3 v)
+{
+    return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+// Main
+
+void main()
+{
+    vec4 rotation = normalize(aInstanceRotation);
+
+    // the camera in model space; the quad turns around the y axis of the model to the camera
+    vec3 camera = Rotate(vec4(-rotation.xyz, rotation.w), cameraPosition - aInstancePosition) / aInstanceScale;
+    vec2 toCamera = camera.xz - origin.xz;
+    vec2 direction = length(toCamera) > 0.0001 ? normalize(toCamera) : vec2(0.0, 1.0);
+    vec3 right = vec3(direction.y, 0.0, -direction.x);
+
+    // the view was baked from the direction (sin, 0, cos) of its angle
+    float angle = atan(direction.x, direction.y);
+    float view = mod(floor(angle / TWO_PI * numberOfViews + 0.5), numberOfViews);
+
+    vec3 corner = origin + right * aPosition.x * size.x + vec3(0.0, aPosition.y * size.y, 0.0);
+    vec3 position = aInstancePosition + Rotate(rotation, corner * aInstanceScale);
+
+    vUv = vec2((view + aPosition.x * 0.5 + 0.5) / numberOfViews, aPosition.y);
+
+    gl_Position = projectionMatrix * viewMatrix * vec4(position, 1.0);
+}
@@ -0,0 +1,36 @@
+#version 330
+
+// impostor_bake/Fragment.frag
+
+// In
+
+in vec2 vUv;
+
+// Out
+
+out vec4 fragColor;
+
+// Uniforms
+
+uniform vec3 diffuseColor;
+uniform float hasDiffuseMap;
+uniform sampler2D diffuseMap;
+
+// Main
+
+void main()
+{
+    vec4 diffuse = vec4(diffuseColor, 1.0);
+    if (hasDiffuseMap > 0.5)
+    {
+        diffuse = texture(diffuseMap, vUv);
+    }
+
+    if (diffuse.a < 0.5)
+    {
+        discard;
+    }
+
+    // the lighting is done when the impostor is drawn
+    fragColor = vec4(diffuse.rgb, 1.0);
+}
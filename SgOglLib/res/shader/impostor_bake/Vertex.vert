@@ -0,0 +1,27 @@
+#version 330
+
+// impostor_bake/Vertex.vert
+
+// In
+
+layout (location = 0) in vec3 aPosition;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aUv;
+
+// Out
+
+out vec2 vUv;
+
+// Uniforms
+
+uniform mat4 projectionMatrix;
+uniform mat4 viewMatrix;
+
+// Main
+
+void main()
+{
+    vUv = aUv;
+
+    gl_Position = projectionMatrix * viewMatrix * vec4(aPosition, 1.0);
+}
@@ -9,7 +9,9 @@ layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aUv;
 layout (location = 3) in vec3 aTangent;
 layout (location = 4) in vec3 aBiTangent;
-layout (location = 5) in mat4 aInstanceMatrix;
+layout (location = 5) in vec3 aInstancePosition;
+layout (location = 6) in vec4 aInstanceRotation;
+layout (location = 7) in float aInstanceScale;
 
 // Out
 
@@ -23,18 +25,29 @@ uniform mat4 projectionMatrix;
 uniform mat4 viewMatrix;
 uniform float fakeNormals;
 
+// Function
+
+vec3 Rotate(vec4 q, vec3 v)
+{
+    return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
 // Main
 
 void main()
 {
-    vec3 position = vec3(aInstanceMatrix * vec4(aPosition, 1.0));
+    // the quaternion was quantized to 16 bits
+    vec4 rotation = normalize(aInstanceRotation);
+
+    vec3 position = aInstancePosition + Rotate(rotation, aPosition * aInstanceScale);
 
     vPosition = position;
 
+    // the scale is the same on all axes; the normals only need the rotation
     vNormal = vec3(0.0, 1.0, 0.0);
     if (fakeNormals < 0.5)
     {
-        vNormal = mat3(transpose(inverse(aInstanceMatrix))) * aNormal;
+        vNormal = Rotate(rotation, aNormal);
     }
 
     vUv = aUv;
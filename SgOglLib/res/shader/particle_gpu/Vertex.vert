@@ -0,0 +1,76 @@
+#version 430
+
+// particle_gpu/Vertex.vert
+
+// In
+
+layout (location = 0) in vec2 aPosition;
+
+// Types
+
+struct Particle
+{
+    vec4 positionLife;
+    vec4 velocityLifeTime;
+};
+
+// Buffers
+
+layout (std430, binding = 0) readonly buffer Particles
+{
+    Particle particles[];
+};
+
+// Out
+
+out vec2 vUvCurrent;
+out vec2 vUvNext;
+out float vBlend;
+
+// Uniforms
+
+uniform mat4 projectionMatrix;
+uniform mat4 viewMatrix;
+uniform int textureRows;
+uniform float maxScale;
+
+// Function
+
+vec2 GetTextureOffset(float t_textureIndex)
+{
+    float rows = float(textureRows);
+    float col = mod(t_textureIndex, rows);
+    float row = floor(t_textureIndex / rows);
+
+    return vec2(col, row) / rows;
+}
+
+// Main
+
+void main()
+{
+    Particle particle = particles[gl_InstanceID];
+
+    float life = particle.positionLife.w / particle.velocityLifeTime.w;
+
+    // atlas progression
+    float nrTextures = float(textureRows * textureRows);
+    float progression = life * nrTextures;
+    float currentIndex = min(floor(progression), nrTextures - 1.0);
+    float nextIndex = min(currentIndex + 1.0, nrTextures - 1.0);
+
+    vec2 uv = aPosition + vec2(0.5, 0.5);
+    uv.y = 1.0 - uv.y;
+
+    uv /= textureRows;
+
+    vUvCurrent = uv + GetTextureOffset(currentIndex);
+    vUvNext = uv + GetTextureOffset(nextIndex);
+    vBlend = fract(progression);
+
+    // billboard in view space
+    vec4 viewPosition = viewMatrix * vec4(particle.positionLife.xyz, 1.0);
+    viewPosition.xy += aPosition * maxScale * life;
+
+    gl_Position = projectionMatrix * viewPosition;
+}
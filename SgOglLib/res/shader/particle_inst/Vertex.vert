@@ -8,9 +8,8 @@ layout (location = 0) in vec2 aPosition;
 
 // In  - per instance vars
 
-layout (location = 1) in mat4 modelViewMatrix;
-layout (location = 5) in vec4 texOffsets;
-layout (location = 6) in float blendFactor;
+layout (location = 1) in vec4 positionScale;
+layout (location = 2) in vec3 atlasBlendRows;
 
 // Out
 
@@ -21,20 +20,38 @@ out float vBlend;
 // Uniforms
 
 uniform mat4 projectionMatrix;
-uniform int textureRows;
+uniform mat4 viewMatrix;
+
+// Function
+
+vec2 GetTextureOffset(float t_textureIndex, float t_rows)
+{
+    float col = mod(t_textureIndex, t_rows);
+    float row = floor(t_textureIndex / t_rows);
+
+    return vec2(col, row) / t_rows;
+}
 
 // Main
 
 void main()
 {
+    // the texture rows are per instance, so that systems with different atlas layouts share a draw call
+    float rows = atlasBlendRows.z;
+    float lastIndex = rows * rows - 1.0;
+
     vec2 uv = aPosition + vec2(0.5, 0.5);
     uv.y = 1.0 - uv.y;
 
-    uv /= textureRows;
+    uv /= rows;
+
+    vUvCurrent = uv + GetTextureOffset(atlasBlendRows.x, rows);
+    vUvNext = uv + GetTextureOffset(min(atlasBlendRows.x + 1.0, lastIndex), rows);
+    vBlend = atlasBlendRows.y;
 
-    vUvCurrent = uv + texOffsets.xy;
-    vUvNext = uv + texOffsets.zw;
-    vBlend = blendFactor;
+    // billboard in view space
+    vec4 viewPosition = viewMatrix * vec4(positionScale.xyz, 1.0);
+    viewPosition.xy += aPosition * positionScale.w;
 
-    gl_Position = projectionMatrix * modelViewMatrix * vec4(aPosition, 0.0, 1.0);
+    gl_Position = projectionMatrix * viewPosition;
 }
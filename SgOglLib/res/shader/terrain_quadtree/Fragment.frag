@@ -64,7 +64,8 @@ vec4 Fog(vec4 t_color)
 
 void main()
 {
-    vec3 normal = normalize(texture(normalmap, mapCoord_FS).rgb);
+    vec2 normalXy = texture(normalmap, mapCoord_FS).rg;
+    vec3 normal = normalize(vec3(normalXy, sqrt(max(0.0, 1.0 - dot(normalXy, normalXy)))));
     vec4 blendValues = texture(splatmap, mapCoord_FS);
 
     vec4 sand = texture(sand, mapCoord_FS * 48.0);
@@ -6,25 +6,31 @@
 
 layout (location = 0) in vec2 aPosition;
 
+// per patch: location + index, gap + lod
+layout (location = 1) in vec4 aLocationIndex;
+layout (location = 2) in vec2 aGapLod;
+
 // Out
 
 out vec2 mapCoord_TC;
 
 // Uniforms
 
-uniform mat4 localMatrix;
 uniform mat4 worldMatrix;
 
 uniform vec3 cameraPosition;
-uniform int lod;
-uniform vec2 index;
-uniform float gap;
-uniform vec2 location;
 uniform int lodMorphArea[8];
 uniform float morphingEnabled;
 
 uniform sampler2D heightmap;
 
+// Patch
+
+vec2 location;
+vec2 index;
+float gap;
+int lod;
+
 // Function
 
 float MorphLatitude(vec2 t_position)
@@ -163,7 +169,12 @@ vec2 Morph(vec2 t_localPosition, float t_height, int t_morphArea)
 
 void main()
 {
-    vec2 localPosition = (localMatrix * vec4(aPosition.x, 0.0, aPosition.y, 1.0)).xz;
+    location = aLocationIndex.xy;
+    index = aLocationIndex.zw;
+    gap = aGapLod.x;
+    lod = int(aGapLod.y);
+
+    vec2 localPosition = location + aPosition * gap;
 
     float height = texture(heightmap, localPosition).r;
 
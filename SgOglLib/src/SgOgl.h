@@ -97,6 +97,8 @@
 
 // terrain
 #include "SgOglLib/terrain/TerrainConfig.h"
+#include "SgOglLib/terrain/TerrainMaps.h"
+#include "SgOglLib/terrain/TiledHeightmap.h"
 #include "SgOglLib/terrain/TerrainQuadtree.h"
 
 // water
@@ -19,6 +19,7 @@
 #include "resource/ModelManager.h"
 #include "input/MouseInput.h"
 #include "event/CircularEventQueue.h"
+#include "ThreadPool.h"
 
 //-------------------------------------------------
 // Custom Deleter
@@ -66,6 +67,12 @@ void sg::ogl::DeleteMouseInput::operator()(input::MouseInput* t_mouseInput) cons
     delete t_mouseInput;
 }
 
+void sg::ogl::DeleteThreadPool::operator()(ThreadPool* t_threadPool) const
+{
+    Log::SG_OGL_CORE_LOG_DEBUG("[DeleteThreadPool::operator()] Delete ThreadPool.");
+    delete t_threadPool;
+}
+
 //-------------------------------------------------
 // Ctors. / Dtor.
 //-------------------------------------------------
@@ -146,6 +153,11 @@ sg::ogl::input::MouseInput& sg::ogl::Application::GetMouseInput() noexcept
     return *m_mouseInput;
 }
 
+sg::ogl::ThreadPool& sg::ogl::Application::GetThreadPool() noexcept
+{
+    return *m_threadPool;
+}
+
 //-------------------------------------------------
 // Run
 //-------------------------------------------------
@@ -190,6 +202,9 @@ void sg::ogl::Application::CoreInit()
     m_modelManager.reset(new resource::ModelManager(this));
     SG_OGL_CORE_ASSERT(m_modelManager, "[Application::CoreInit()] Null pointer.");
 
+    m_threadPool.reset(new ThreadPool);
+    SG_OGL_CORE_ASSERT(m_threadPool, "[Application::CoreInit()] Null pointer.");
+
     m_stateStack.reset(new state::StateStack{ this });
     SG_OGL_CORE_ASSERT(m_stateStack, "[Application::CoreInit()] Null pointer.");
 
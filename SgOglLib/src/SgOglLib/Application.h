@@ -44,6 +44,7 @@ namespace sg::ogl::scene
 namespace sg::ogl
 {
     class Window;
+    class ThreadPool;
 
     struct DeleteWindow
     {
@@ -80,6 +81,11 @@ namespace sg::ogl
         void operator()(input::MouseInput* t_mouseInput) const;
     };
 
+    struct DeleteThreadPool
+    {
+        void operator()(ThreadPool* t_threadPool) const;
+    };
+
     class Application
     {
     public:
@@ -90,6 +96,7 @@ namespace sg::ogl
         using StateStackUniquePtr = std::unique_ptr<state::StateStack, DeleteStateStack>;
         using CircularEventQueueUniquePtr = std::unique_ptr<event::CircularEventQueue, DeleteCircularEventQueue>;
         using MouseInputUniquePtr = std::unique_ptr<input::MouseInput, DeleteMouseInput>;
+        using ThreadPoolUniquePtr = std::unique_ptr<ThreadPool, DeleteThreadPool>;
 
         //-------------------------------------------------
         // Public member
@@ -138,6 +145,7 @@ namespace sg::ogl
         state::StateStack& GetStateStack() noexcept;
         event::CircularEventQueue& GetCircularEventQueue() noexcept;
         input::MouseInput& GetMouseInput() noexcept;
+        ThreadPool& GetThreadPool() noexcept;
 
         //-------------------------------------------------
         // Run
@@ -162,6 +170,12 @@ namespace sg::ogl
         ShaderManagerUniquePtr m_shaderManager;
         TextureManagerUniquePtr m_textureManager;
         ModelManagerUniquePtr m_modelManager;
+
+        /**
+         * @brief Declared before the StateStack, so that it outlives the Scenes.
+         */
+        ThreadPoolUniquePtr m_threadPool;
+
         StateStackUniquePtr m_stateStack;
         CircularEventQueueUniquePtr m_circularEventQueue;
         MouseInputUniquePtr m_mouseInput;
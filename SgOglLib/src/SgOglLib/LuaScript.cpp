@@ -16,10 +16,13 @@
 #include "resource/ModelManager.h"
 #include "resource/TextureManager.h"
 #include "resource/SkeletalModel.h"
+#include "resource/Impostor.h"
 #include "input/MouseInput.h"
 #include "water/Water.h"
 #include "particle/ParticleSystem.h"
 #include "terrain/TerrainConfig.h"
+#include "terrain/VegetationScatter.h"
+#include "terrain/TiledHeightmap.h"
 #include "terrain/TerrainQuadtree.h"
 #include "ecs/system/ForwardRenderSystem.h"
 #include "ecs/system/DeferredRenderSystem.h"
@@ -224,7 +227,9 @@ void sg::ogl::LuaScript::CreateSceneUsertype()
             }
         ),
         "SetAmbientIntensity", &scene::Scene::SetAmbientIntensity,
-        "SetCurrentCamera", &scene::Scene::SetCurrentCameraByName
+        "SetCurrentCamera", &scene::Scene::SetCurrentCameraByName,
+        "SetParticleBudget", &scene::Scene::SetParticleBudget,
+        "GetParticleBudget", &scene::Scene::GetParticleBudget
     );
 }
 
@@ -331,6 +336,12 @@ void sg::ogl::LuaScript::CreateResourceUsertypes()
     );
 
     // ParticleSystem
+    m_lua.new_enum("TerrainCollision",
+        "NONE", particle::TerrainCollision::NONE,
+        "BOUNCE", particle::TerrainCollision::BOUNCE,
+        "KILL", particle::TerrainCollision::KILL
+    );
+
     m_lua.new_usertype<particle::ParticleSystem>(
         "ParticleSystem",
         sol::constructors<
@@ -356,8 +367,18 @@ void sg::ogl::LuaScript::CreateResourceUsertypes()
         "SetGravityEffect", &particle::ParticleSystem::SetGravityEffect,
         "SetLifeTime", &particle::ParticleSystem::SetLifeTime,
         "SetMaxScale", &particle::ParticleSystem::SetMaxScale,
+        "SetCapacity", &particle::ParticleSystem::SetCapacity,
+        "GetCapacity", &particle::ParticleSystem::GetCapacity,
+        "GetAliveCount", &particle::ParticleSystem::GetAliveCount,
+        "SetLodDistances", &particle::ParticleSystem::SetLodDistances,
+        "SetMinScreenSize", &particle::ParticleSystem::SetMinScreenSize,
+        "IsVisible", &particle::ParticleSystem::IsVisible,
         "GenerateParticles", &particle::ParticleSystem::GenerateParticles,
-        "instancing", &particle::ParticleSystem::instancing
+        "instancing", &particle::ParticleSystem::instancing,
+        "gpu", &particle::ParticleSystem::gpu,
+        "alphaBlending", &particle::ParticleSystem::alphaBlending,
+        "terrainCollision", &particle::ParticleSystem::terrainCollision,
+        "restitution", &particle::ParticleSystem::restitution
     );
 
     m_lua.new_usertype<terrain::TerrainConfig>(
@@ -374,14 +395,98 @@ void sg::ogl::LuaScript::CreateResourceUsertypes()
             }
         ),
         "InitMapsAndMorphing", &terrain::TerrainConfig::InitMapsAndMorphing,
+        "InitTiledMapsAndMorphing", &terrain::TerrainConfig::InitTiledMapsAndMorphing,
         "InitTextures", &terrain::TerrainConfig::InitTextures,
-        "GetHeightAt", &terrain::TerrainConfig::GetHeightAt,
+        "GetHeightAt", sol::resolve<float(float, float, float, float) const>(&terrain::TerrainConfig::GetHeightAt),
+        "GetHeightsInRangeAt", [](const terrain::TerrainConfig& t_terrainConfig,
+            const sol::as_table_t<std::vector<float>>& t_x,
+            const sol::as_table_t<std::vector<float>>& t_z,
+            const sol::as_table_t<std::vector<float>>& t_min,
+            const sol::as_table_t<std::vector<float>>& t_max)
+        {
+            const auto& x{ t_x.value() };
+            const auto& z{ t_z.value() };
+            const auto& min{ t_min.value() };
+            const auto& max{ t_max.value() };
+
+            if (z.size() != x.size() || min.size() != x.size() || max.size() != x.size())
+            {
+                throw SG_OGL_EXCEPTION("[LuaScript::CreateResourceUsertypes()] The tables for GetHeightsInRangeAt must have the same size.");
+            }
+
+            // one call for all positions
+            std::vector<float> heights(x.size());
+            t_terrainConfig.GetHeightsInRangeAt(x.data(), z.data(), min.data(), max.data(), heights.data(), static_cast<uint32_t>(x.size()));
+
+            return sol::as_table(std::move(heights));
+        },
+        "Raycast", [](const terrain::TerrainConfig& t_terrainConfig, const glm::vec3& t_origin, const glm::vec3& t_direction, const float t_maxDistance)
+        {
+            auto distance{ -1.0f };
+            const auto hit{ t_terrainConfig.Raycast(t_origin, t_direction, t_maxDistance, distance) };
+
+            return std::make_tuple(hit, distance);
+        },
+        "IsVisible", &terrain::TerrainConfig::IsVisible,
         "scaleXz", &terrain::TerrainConfig::scaleXz,
         "scaleY", &terrain::TerrainConfig::scaleY,
         "rootNodes", &terrain::TerrainConfig::rootNodes,
         "normalStrength", &terrain::TerrainConfig::normalStrength,
         "lodRanges", &terrain::TerrainConfig::lodRanges,
-        "use16BitHeightmap", &terrain::TerrainConfig::use16BitHeightmap
+        "lodHysteresis", &terrain::TerrainConfig::lodHysteresis,
+        "lodUpdateDistance", &terrain::TerrainConfig::lodUpdateDistance,
+        "use16BitHeightmap", &terrain::TerrainConfig::use16BitHeightmap,
+        "mapCachePath", &terrain::TerrainConfig::mapCachePath,
+        "cpuMapGeneration", &terrain::TerrainConfig::cpuMapGeneration
+    );
+
+    m_lua.new_usertype<terrain::VegetationScatter>(
+        "VegetationScatter",
+        sol::constructors<
+            terrain::VegetationScatter(Application*)
+        >(),
+        "count", &terrain::VegetationScatter::count,
+        "minHeight", &terrain::VegetationScatter::minHeight,
+        "maxHeight", &terrain::VegetationScatter::maxHeight,
+        "minSlope", &terrain::VegetationScatter::minSlope,
+        "maxSlope", &terrain::VegetationScatter::maxSlope,
+        "minScale", &terrain::VegetationScatter::minScale,
+        "maxScale", &terrain::VegetationScatter::maxScale,
+        "minRotation", &terrain::VegetationScatter::minRotation,
+        "maxRotation", &terrain::VegetationScatter::maxRotation,
+        "baseRotation", &terrain::VegetationScatter::baseRotation,
+        "heightOffset", &terrain::VegetationScatter::heightOffset,
+        "border", &terrain::VegetationScatter::border,
+        "seed", &terrain::VegetationScatter::seed
+    );
+
+    m_lua.new_usertype<terrain::TiledHeightmap>(
+        "TiledHeightmap",
+        "new", sol::factories(
+            [](Application* t_app, const std::string& t_filePath)
+            {
+                return std::make_shared<terrain::TiledHeightmap>(t_app, t_filePath);
+            }
+        ),
+        "ConvertRaw", [](const std::string& t_filePath, const std::string& t_rawFilePath, const int t_width, const int t_tileSize)
+        {
+            terrain::TiledHeightmap::ConvertRaw(t_filePath, t_rawFilePath, t_width, t_tileSize);
+        },
+        "ConvertImage", [](const std::string& t_filePath, const std::string& t_imageFilePath, const bool t_16Bit, const int t_tileSize)
+        {
+            const auto pixels{ resource::TextureManager::DecodeHeightmap(t_imageFilePath, t_16Bit) };
+            if (pixels.width != pixels.height)
+            {
+                throw SG_OGL_EXCEPTION("[LuaScript::CreateResourceUsertypes()] Width and Height of the heightmap should have the same value.");
+            }
+
+            terrain::TiledHeightmap::Write(t_filePath, pixels.values, pixels.width, t_tileSize);
+        },
+        "GetWidth", &terrain::TiledHeightmap::GetWidth,
+        "GetNumberOfResidentTiles", &terrain::TiledHeightmap::GetNumberOfResidentTiles,
+        "GetNumberOfPendingTiles", &terrain::TiledHeightmap::GetNumberOfPendingTiles,
+        "maxResidentTiles", &terrain::TiledHeightmap::maxResidentTiles,
+        "pageRadius", &terrain::TiledHeightmap::pageRadius
     );
 
     m_lua.new_usertype<terrain::TerrainQuadtree>(
@@ -407,7 +512,30 @@ void sg::ogl::LuaScript::CreateComponentUsertypes()
     );
 
     m_lua.new_usertype<ecs::component::ModelInstancesComponent>(
-        "ModelInstancesComponent"
+        "ModelInstancesComponent",
+        "frustumCulling", &ecs::component::ModelInstancesComponent::frustumCulling,
+        "gpuCulling", &ecs::component::ModelInstancesComponent::gpuCulling,
+        "cullDistance", &ecs::component::ModelInstancesComponent::cullDistance,
+        "lodDistance", &ecs::component::ModelInstancesComponent::lodDistance,
+        "impostorDistance", &ecs::component::ModelInstancesComponent::impostorDistance,
+        "AddSimplifiedLod", [](ecs::component::ModelInstancesComponent& t_component, const std::shared_ptr<resource::Model>& t_simplifiedModel, const float t_lodDistance)
+        {
+            t_component.model->AddSimplifiedLod(*t_simplifiedModel);
+            t_component.simplifiedModel = t_simplifiedModel;
+            t_component.lodDistance = t_lodDistance;
+        },
+        "AddImpostorLod", sol::overload(
+            [](ecs::component::ModelInstancesComponent& t_component, const float t_impostorDistance)
+            {
+                t_component.impostor = t_component.model->CreateImpostorLod(resource::Impostor::DEFAULT_VIEWS, resource::Impostor::DEFAULT_VIEW_SIZE);
+                t_component.impostorDistance = t_impostorDistance;
+            },
+            [](ecs::component::ModelInstancesComponent& t_component, const float t_impostorDistance, const uint32_t t_views, const int32_t t_viewSize)
+            {
+                t_component.impostor = t_component.model->CreateImpostorLod(t_views, t_viewSize);
+                t_component.impostorDistance = t_impostorDistance;
+            }
+        )
     );
 
     m_lua.new_usertype<ecs::component::SkeletalModelComponent>(
@@ -505,10 +633,22 @@ void sg::ogl::LuaScript::CreateEcsRegistryUsertype()
         "AddTextComponent", static_cast<ecs::component::TextComponent& (entt::registry::*)(entt::entity, std::string&&, float&&, float&&, float&&, glm::vec3&)>(&entt::registry::emplace<ecs::component::TextComponent, std::string, float, float, float, glm::vec3&>),
         "AddModelInstancesComponent",
         [](entt::registry& t_reg, entt::entity t_entity, std::shared_ptr<resource::Model>& t_model, bool t_showTriangles, bool t_fakeNormals, const sol::as_table_t<std::vector<math::Transform>>& t_transforms)
+            -> ecs::component::ModelInstancesComponent&
         {
             t_model->AddTransformVbo(t_transforms.value());
             auto instances{ static_cast<uint32_t>(t_transforms.value().size()) };
-            t_reg.emplace<ecs::component::ModelInstancesComponent>(t_entity, t_model, t_showTriangles, t_fakeNormals, instances);
+            return t_reg.emplace<ecs::component::ModelInstancesComponent>(t_entity, t_model, t_showTriangles, t_fakeNormals, instances);
+        },
+        "AddScatteredModelInstancesComponent",
+        [](entt::registry& t_reg, entt::entity t_entity, std::shared_ptr<resource::Model>& t_model, bool t_showTriangles, bool t_fakeNormals,
+            const terrain::VegetationScatter& t_scatter, const std::shared_ptr<terrain::TerrainConfig>& t_terrainConfig)
+            -> ecs::component::ModelInstancesComponent&
+        {
+            // the transforms do not cross the Lua boundary
+            const auto transforms{ t_scatter.Scatter(*t_terrainConfig) };
+            t_model->AddTransformVbo(transforms);
+            auto instances{ static_cast<uint32_t>(transforms.size()) };
+            return t_reg.emplace<ecs::component::ModelInstancesComponent>(t_entity, t_model, t_showTriangles, t_fakeNormals, instances);
         },
         "AddTerrainQuadtreeComponent", static_cast<ecs::component::TerrainQuadtreeComponent& (entt::registry::*)(entt::entity, terrain::TerrainQuadtree*&&)>(&entt::registry::emplace<ecs::component::TerrainQuadtreeComponent, terrain::TerrainQuadtree*>),
         "AddPlayerComponent", static_cast<ecs::component::PlayerComponent& (entt::registry::*)(entt::entity, std::string&&, uint32_t&&, float&&, float&&)>(&entt::registry::emplace<ecs::component::PlayerComponent, std::string, uint32_t, float, float>),
@@ -0,0 +1,269 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ThreadPool.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <utility>
+#include "ThreadPool.h"
+#include "Core.h"
+#include "Log.h"
+
+//-------------------------------------------------
+// Job
+//-------------------------------------------------
+
+sg::ogl::ThreadPool::Job::Job(Task t_task)
+    : m_task{ std::move(t_task) }
+{
+}
+
+bool sg::ogl::ThreadPool::Job::IsDone() const noexcept
+{
+    return m_done;
+}
+
+void sg::ogl::ThreadPool::Job::Wait()
+{
+    std::unique_lock<std::mutex> lock{ m_mutex };
+    m_condition.wait(lock, [this]() { return m_done.load(); });
+}
+
+void sg::ogl::ThreadPool::Job::Get()
+{
+    Wait();
+
+    if (m_exception)
+    {
+        std::rethrow_exception(std::exchange(m_exception, nullptr));
+    }
+}
+
+void sg::ogl::ThreadPool::Job::Execute()
+{
+    std::exception_ptr exception;
+
+    try
+    {
+        m_task();
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    // notified under the lock; a waiting thread may destroy the Job right after
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    m_exception = exception;
+    m_done = true;
+    m_condition.notify_all();
+}
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+sg::ogl::ThreadPool::ThreadPool(uint32_t t_nrThreads)
+{
+    if (t_nrThreads == 0)
+    {
+        t_nrThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[ThreadPool::ThreadPool()] Start {} worker threads.", t_nrThreads);
+
+    m_threads.reserve(t_nrThreads);
+    for (auto i{ 0u }; i < t_nrThreads; ++i)
+    {
+        m_threads.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+sg::ogl::ThreadPool::~ThreadPool() noexcept
+{
+    Log::SG_OGL_CORE_LOG_DEBUG("[ThreadPool::~ThreadPool()] Destruct ThreadPool.");
+
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_stop = true;
+    }
+
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+uint32_t sg::ogl::ThreadPool::GetNumberOfThreads() const noexcept
+{
+    return static_cast<uint32_t>(m_threads.size());
+}
+
+//-------------------------------------------------
+// Tasks
+//-------------------------------------------------
+
+std::future<void> sg::ogl::ThreadPool::Submit(Task t_task)
+{
+    std::packaged_task<void()> task{ std::move(t_task) };
+    auto future{ task.get_future() };
+
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_tasks.push(std::move(task));
+    }
+
+    m_condition.notify_one();
+
+    return future;
+}
+
+void sg::ogl::ThreadPool::ParallelFor(const uint32_t t_count, const ItemFunction& t_function)
+{
+    if (t_count == 0)
+    {
+        return;
+    }
+
+    // the helper tasks may start after this call has returned, so the state is shared
+    struct State
+    {
+        ItemFunction function;
+        uint32_t count{ 0 };
+        std::atomic<uint32_t> next{ 0 };
+        std::atomic<uint32_t> done{ 0 };
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::exception_ptr exception;
+    };
+
+    auto state{ std::make_shared<State>() };
+    state->function = t_function;
+    state->count = t_count;
+
+    auto work{ [state]()
+    {
+        for (auto i{ state->next++ }; i < state->count; i = state->next++)
+        {
+            try
+            {
+                state->function(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{ state->mutex };
+                state->exception = std::current_exception();
+            }
+
+            if (++state->done == state->count)
+            {
+                std::lock_guard<std::mutex> lock{ state->mutex };
+                state->condition.notify_all();
+            }
+        }
+    } };
+
+    const auto nrHelpers{ std::min(GetNumberOfThreads(), t_count - 1) };
+    for (auto i{ 0u }; i < nrHelpers; ++i)
+    {
+        Submit(work);
+    }
+
+    work();
+
+    // wait for the items taken by other threads
+    std::unique_lock<std::mutex> lock{ state->mutex };
+    state->condition.wait(lock, [&state]() { return state->done == state->count; });
+
+    if (state->exception)
+    {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+void sg::ogl::ThreadPool::Run(Job& t_job)
+{
+    SG_OGL_CORE_ASSERT(t_job.IsDone(), "[ThreadPool::Run()] The Job is still running.");
+
+    {
+        std::lock_guard<std::mutex> jobLock{ t_job.m_mutex };
+        t_job.m_done = false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+
+        t_job.m_next = nullptr;
+        if (m_lastJob)
+        {
+            m_lastJob->m_next = &t_job;
+        }
+        else
+        {
+            m_firstJob = &t_job;
+        }
+
+        m_lastJob = &t_job;
+    }
+
+    m_condition.notify_one();
+}
+
+//-------------------------------------------------
+// Worker
+//-------------------------------------------------
+
+void sg::ogl::ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        Job* job{ nullptr };
+        std::packaged_task<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_condition.wait(lock, [this]() { return m_stop || m_firstJob || !m_tasks.empty(); });
+
+            if (m_firstJob)
+            {
+                job = m_firstJob;
+                m_firstJob = job->m_next;
+                if (!m_firstJob)
+                {
+                    m_lastJob = nullptr;
+                }
+            }
+            else if (!m_tasks.empty())
+            {
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+            else
+            {
+                return;
+            }
+        }
+
+        if (job)
+        {
+            job->Execute();
+        }
+        else
+        {
+            task();
+        }
+    }
+}
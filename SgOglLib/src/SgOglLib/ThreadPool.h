@@ -0,0 +1,164 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ThreadPool.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <atomic>
+#include <exception>
+
+namespace sg::ogl
+{
+    /**
+     * @brief A fixed number of worker threads for the CPU work of the engine.
+     *        Tasks are either submitted and run in the background or distributed
+     *        with ParallelFor, which blocks until all items are done. Work that is
+     *        repeated every frame uses a Job instead, which doesn't allocate.
+     */
+    class ThreadPool
+    {
+    public:
+        using Task = std::function<void()>;
+        using ItemFunction = std::function<void(uint32_t)>;
+
+        /**
+         * @brief A task that is created once and can be run any number of times.
+         *        Unlike Submit, Run and Get don't allocate; the Job is queued by itself.
+         */
+        class Job
+        {
+        public:
+            explicit Job(Task t_task);
+
+            Job(const Job& t_other) = delete;
+            Job(Job&& t_other) noexcept = delete;
+            Job& operator=(const Job& t_other) = delete;
+            Job& operator=(Job&& t_other) noexcept = delete;
+
+            ~Job() noexcept = default;
+
+            /**
+             * @brief True if the last run is finished or the Job was never run.
+             */
+            [[nodiscard]] bool IsDone() const noexcept;
+
+            /**
+             * @brief Blocks until the last run is finished.
+             */
+            void Wait();
+
+            /**
+             * @brief Blocks until the last run is finished and rethrows an exception of the task.
+             */
+            void Get();
+
+        protected:
+
+        private:
+            friend class ThreadPool;
+
+            Task m_task;
+
+            /**
+             * @brief The next queued Job.
+             */
+            Job* m_next{ nullptr };
+
+            /**
+             * @brief Written under the mutex, so that Wait() doesn't miss the end of a run.
+             */
+            std::atomic<bool> m_done{ true };
+
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            std::exception_ptr m_exception;
+
+            void Execute();
+        };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        /**
+         * @brief Starts the worker threads.
+         * @param t_nrThreads The number of threads; 0 uses one thread less than the hardware threads, but at least one.
+         */
+        explicit ThreadPool(uint32_t t_nrThreads = 0);
+
+        ThreadPool(const ThreadPool& t_other) = delete;
+        ThreadPool(ThreadPool&& t_other) noexcept = delete;
+        ThreadPool& operator=(const ThreadPool& t_other) = delete;
+        ThreadPool& operator=(ThreadPool&& t_other) noexcept = delete;
+
+        /**
+         * @brief Finishes the queued tasks and joins the threads.
+         */
+        ~ThreadPool() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] uint32_t GetNumberOfThreads() const noexcept;
+
+        //-------------------------------------------------
+        // Tasks
+        //-------------------------------------------------
+
+        /**
+         * @brief Runs a task on one of the worker threads.
+         * @param t_task The task.
+         * @return A future to wait for the task; rethrows an exception of the task.
+         */
+        std::future<void> Submit(Task t_task);
+
+        /**
+         * @brief Calls a function for the items [0, t_count). The calling thread works on
+         *        the items as well and returns when all items are done.
+         * @param t_count The number of items.
+         * @param t_function The function; is called concurrently. An exception is rethrown after all items are done.
+         */
+        void ParallelFor(uint32_t t_count, const ItemFunction& t_function);
+
+        /**
+         * @brief Runs a Job on one of the worker threads. The Job must be done.
+         * @param t_job The Job; must outlive the run.
+         */
+        void Run(Job& t_job);
+
+    protected:
+
+    private:
+        std::vector<std::thread> m_threads;
+        std::queue<std::packaged_task<void()>> m_tasks;
+
+        /**
+         * @brief The queued Jobs; linked by Job::m_next.
+         */
+        Job* m_firstJob{ nullptr };
+        Job* m_lastJob{ nullptr };
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stop{ false };
+
+        //-------------------------------------------------
+        // Worker
+        //-------------------------------------------------
+
+        void WorkerLoop();
+    };
+}
@@ -201,6 +201,20 @@ void sg::ogl::buffer::Vao::DrawInstanced(const int32_t t_instanceCount, const ui
     }
 }
 
+void sg::ogl::buffer::Vao::DrawInstancedIndirect(const uint64_t t_offset, const uint32_t t_drawMode) const
+{
+    const auto* offset{ reinterpret_cast<const void*>(static_cast<uintptr_t>(t_offset)) };
+
+    if (HasIndexBuffer())
+    {
+        glDrawElementsIndirect(t_drawMode, GL_UNSIGNED_INT, offset);
+    }
+    else
+    {
+        glDrawArraysIndirect(t_drawMode, offset);
+    }
+}
+
 //-------------------------------------------------
 // CleanUp
 //-------------------------------------------------
@@ -154,6 +154,14 @@ namespace sg::ogl::buffer
         void DrawPrimitives(uint32_t t_drawMode = GL_TRIANGLES) const;
         void DrawInstanced(int32_t t_instanceCount, uint32_t t_drawMode = GL_TRIANGLES) const;
 
+        /**
+         * @brief Calls glDrawElementsIndirect or glDrawArraysIndirect with the command at the given
+         *        offset of the bound GL_DRAW_INDIRECT_BUFFER.
+         * @param t_offset The byte offset of the command.
+         * @param t_drawMode Specifies what kind of primitives to render.
+         */
+        void DrawInstancedIndirect(uint64_t t_offset, uint32_t t_drawMode = GL_TRIANGLES) const;
+
     protected:
 
     private:
@@ -124,3 +124,22 @@ void sg::ogl::buffer::Vbo::AddInstancedAttribute(
 
     UnbindVbo();
 }
+
+void sg::ogl::buffer::Vbo::AddInstancedAttribute(
+    const uint32_t t_vboId,
+    const uint32_t t_index,
+    const int32_t t_nrOfComponents,
+    const uint32_t t_type,
+    const bool t_normalized,
+    const int32_t t_stride,
+    const uint64_t t_offset
+)
+{
+    BindVbo(t_vboId);
+
+    glEnableVertexAttribArray(t_index);
+    glVertexAttribPointer(t_index, t_nrOfComponents, t_type, t_normalized ? GL_TRUE : GL_FALSE, t_stride, reinterpret_cast<uintptr_t*>(t_offset));
+    glVertexAttribDivisor(t_index, 1);
+
+    UnbindVbo();
+}
@@ -72,6 +72,18 @@ namespace sg::ogl::buffer
          */
         static void AddInstancedAttribute(uint32_t t_vboId, uint32_t t_index, int32_t t_nrOfFloatComponents, int32_t t_nrOfAllFloats, uint64_t t_startPoint);
 
+        /**
+         * @brief Function to define per instance data which is not stored as floats.
+         * @param t_vboId The Vbo for which the attribute is to be defined.
+         * @param t_index The index of the vertex attribute.
+         * @param t_nrOfComponents The number of components for this attribute. Must be 1, 2, 3, or 4.
+         * @param t_type The type of the components, e.g. GL_FLOAT, GL_SHORT or GL_HALF_FLOAT.
+         * @param t_normalized Integer values are mapped to [-1, 1] or [0, 1].
+         * @param t_stride The number of bytes of all attributes.
+         * @param t_offset The offset of this attribute in bytes.
+         */
+        static void AddInstancedAttribute(uint32_t t_vboId, uint32_t t_index, int32_t t_nrOfComponents, uint32_t t_type, bool t_normalized, int32_t t_stride, uint64_t t_offset);
+
     protected:
 
     private:
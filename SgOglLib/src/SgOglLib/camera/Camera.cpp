@@ -111,6 +111,11 @@ void sg::ogl::camera::Camera::GetFrustumPlanes(std::vector<glm::vec4>& t_planes)
     }
 }
 
+const sg::ogl::camera::Camera::FrustumPlaneContainer& sg::ogl::camera::Camera::GetFrustumPlanes() const noexcept
+{
+    return m_planes;
+}
+
 void sg::ogl::camera::Camera::UpdateFrustumPlanes()
 {
     if (m_planes.empty())
@@ -151,3 +156,67 @@ void sg::ogl::camera::Camera::UpdateFrustumPlanes()
     m_planes[4] = math::Plane::FromPoints(m_nearPts[0], m_nearPts[3], m_nearPts[2]);
     m_planes[5] = math::Plane::FromPoints(m_farPts[3], m_farPts[0], m_farPts[1]);
 }
+
+bool sg::ogl::camera::Camera::IsSphereInFrustum(const glm::vec3& t_center, const float t_radius) const
+{
+    // the normals point into the frustum
+    for (const auto& plane : m_planes)
+    {
+        if (dot(plane.normal, t_center) + plane.distance < -t_radius)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool sg::ogl::camera::Camera::IsAabbInFrustum(const glm::vec3& t_min, const glm::vec3& t_max, uint32_t& t_planeMask) const
+{
+    return IsAabbInFrustum(m_planes, t_min, t_max, t_planeMask);
+}
+
+bool sg::ogl::camera::Camera::IsAabbInFrustum(
+    const FrustumPlaneContainer& t_planes,
+    const glm::vec3& t_min,
+    const glm::vec3& t_max,
+    uint32_t& t_planeMask
+)
+{
+    for (auto i{ 0u }; i < t_planes.size(); ++i)
+    {
+        const auto bit{ 1u << i };
+        if ((t_planeMask & bit) == 0)
+        {
+            continue;
+        }
+
+        const auto& plane{ t_planes[i] };
+
+        // the corner farthest along the normal
+        const glm::vec3 p{
+            plane.normal.x >= 0.0f ? t_max.x : t_min.x,
+            plane.normal.y >= 0.0f ? t_max.y : t_min.y,
+            plane.normal.z >= 0.0f ? t_max.z : t_min.z
+        };
+
+        if (dot(plane.normal, p) + plane.distance < 0.0f)
+        {
+            return false;
+        }
+
+        // the opposite corner
+        const glm::vec3 n{
+            plane.normal.x >= 0.0f ? t_min.x : t_max.x,
+            plane.normal.y >= 0.0f ? t_min.y : t_max.y,
+            plane.normal.z >= 0.0f ? t_min.z : t_max.z
+        };
+
+        if (dot(plane.normal, n) + plane.distance >= 0.0f)
+        {
+            t_planeMask &= ~bit;
+        }
+    }
+
+    return true;
+}
@@ -37,6 +37,11 @@ namespace sg::ogl::camera
     public:
         using FrustumPlaneContainer = std::vector<math::Plane>;
 
+        /**
+         * @brief A plane mask with a bit for each of the six frustum planes.
+         */
+        static constexpr uint32_t ALL_FRUSTUM_PLANES{ 0x3F };
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -89,8 +94,38 @@ namespace sg::ogl::camera
         //-------------------------------------------------
 
         void GetFrustumPlanes(std::vector<glm::vec4>& t_planes) const;
+        [[nodiscard]] const FrustumPlaneContainer& GetFrustumPlanes() const noexcept;
         void UpdateFrustumPlanes();
 
+        /**
+         * @brief Tests a bounding sphere against the frustum planes of the last UpdateFrustumPlanes() call.
+         * @param t_center The center of the sphere in world space.
+         * @param t_radius The radius of the sphere.
+         * @return False if the sphere is completely outside of the frustum.
+         */
+        [[nodiscard]] bool IsSphereInFrustum(const glm::vec3& t_center, float t_radius) const;
+
+        /**
+         * @brief Tests an axis aligned bounding box against the frustum planes of the last UpdateFrustumPlanes() call.
+         *        Only the planes with a set bit in the mask are tested. The bits of the planes the box is completely
+         *        inside are cleared, so that the contained boxes of a hierarchy can skip them.
+         * @param t_min The min corner of the box in world space.
+         * @param t_max The max corner of the box in world space.
+         * @param t_planeMask The planes to test; receives the planes which still intersect the box.
+         * @return False if the box is completely outside of the frustum.
+         */
+        [[nodiscard]] bool IsAabbInFrustum(const glm::vec3& t_min, const glm::vec3& t_max, uint32_t& t_planeMask) const;
+
+        /**
+         * @brief The same test against a copy of the planes; can be used on other threads.
+         */
+        [[nodiscard]] static bool IsAabbInFrustum(
+            const FrustumPlaneContainer& t_planes,
+            const glm::vec3& t_min,
+            const glm::vec3& t_max,
+            uint32_t& t_planeMask
+        );
+
     protected:
         std::string m_name;
 
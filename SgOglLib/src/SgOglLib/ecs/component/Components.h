@@ -19,6 +19,7 @@ namespace sg::ogl::resource
     class Mesh;
     class Model;
     class SkeletalModel;
+    class Impostor;
 }
 
 namespace sg::ogl::terrain
@@ -87,6 +88,15 @@ namespace sg::ogl::ecs::component
         bool showTriangles{ false };
         bool fakeNormals{ false };
         uint32_t instances{ 0 };
+        bool frustumCulling{ true };
+        bool gpuCulling{ false };
+        float cullDistance{ 0.0f };
+
+        // the Lod chain of the Cpu culling path; a distance of 0 disables a Lod
+        std::shared_ptr<resource::Model> simplifiedModel;
+        std::shared_ptr<resource::Impostor> impostor;
+        float lodDistance{ 0.0f };
+        float impostorDistance{ 0.0f };
     };
 
     struct SkeletalModelComponent
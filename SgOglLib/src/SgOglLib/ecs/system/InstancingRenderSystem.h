@@ -12,12 +12,14 @@
 #include "RenderSystem.h"
 #include "ecs/component/Components.h"
 #include "resource/shaderprogram/InstancingShaderProgram.h"
+#include "resource/shaderprogram/ImpostorShaderProgram.h"
 #include "resource/ShaderManager.h"
 #include "resource/Model.h"
+#include "resource/Impostor.h"
 
 namespace sg::ogl::ecs::system
 {
-    class InstancingRenderSystem : public RenderSystem<resource::shaderprogram::InstancingShaderProgram>
+    class InstancingRenderSystem : public RenderSystem<resource::shaderprogram::InstancingShaderProgram, resource::shaderprogram::ImpostorShaderProgram>
     {
     public:
         using PointLightContainer = std::vector<light::PointLight>;
@@ -65,6 +67,7 @@ namespace sg::ogl::ecs::system
             });
 
             auto& shaderProgram{ m_scene->GetApplicationContext()->GetShaderManager().GetShaderProgram<resource::shaderprogram::InstancingShaderProgram>() };
+            auto& impostorShaderProgram{ m_scene->GetApplicationContext()->GetShaderManager().GetShaderProgram<resource::shaderprogram::ImpostorShaderProgram>() };
             shaderProgram.Bind();
 
             auto view{ m_scene->GetApplicationContext()->registry.view<component::ModelInstancesComponent>() };
@@ -73,17 +76,65 @@ namespace sg::ogl::ecs::system
             {
                 auto& modelInstancesComponent{ view.get<component::ModelInstancesComponent>(entity) };
 
+                auto& model{ *modelInstancesComponent.model };
+                const auto& camera{ m_scene->GetCurrentCamera() };
+
+                // only the instances in the view frustum are drawn; the Gpu path keeps the number on the Gpu
+                auto instances{ modelInstancesComponent.instances };
+                std::array<uint32_t, resource::Model::NUMBER_OF_LODS> lodInstances{ instances, 0, 0 };
+                const auto gpuCulling{ modelInstancesComponent.frustumCulling && modelInstancesComponent.gpuCulling };
+                if (gpuCulling)
+                {
+                    model.CullInstancesGpu(camera.GetFrustumPlanes(), camera.GetPosition(), modelInstancesComponent.cullDistance);
+                    shaderProgram.Bind();
+                }
+                else if (modelInstancesComponent.frustumCulling)
+                {
+                    const auto lodDistance{ modelInstancesComponent.simplifiedModel ? modelInstancesComponent.lodDistance : 0.0f };
+                    const auto impostorDistance{ modelInstancesComponent.impostor ? modelInstancesComponent.impostorDistance : 0.0f };
+
+                    instances = model.CullInstances(camera.GetFrustumPlanes(), camera.GetPosition(), modelInstancesComponent.cullDistance, lodDistance, impostorDistance);
+                    for (auto lod{ 0u }; lod < resource::Model::NUMBER_OF_LODS; ++lod)
+                    {
+                        lodInstances[lod] = model.GetNumberOfVisibleInstances(lod);
+                    }
+                }
+                else
+                {
+                    // the culling may have been switched off; the Vbo holds the visible instances of the last frame
+                    model.ShowAllInstances();
+                }
+
+                if (instances == 0)
+                {
+                    continue;
+                }
+
                 if (modelInstancesComponent.showTriangles)
                 {
                     OpenGl::EnableWireframeMode();
                 }
 
-                for (auto& mesh : modelInstancesComponent.model->GetMeshes())
+                if (lodInstances[resource::Model::FULL_LOD] > 0)
+                {
+                    RenderMeshes(shaderProgram, entity, model, lodInstances[resource::Model::FULL_LOD], gpuCulling, pointLights, directionalLights);
+                }
+
+                if (lodInstances[resource::Model::SIMPLIFIED_LOD] > 0)
+                {
+                    RenderMeshes(shaderProgram, entity, *modelInstancesComponent.simplifiedModel, lodInstances[resource::Model::SIMPLIFIED_LOD], false, pointLights, directionalLights);
+                }
+
+                if (lodInstances[resource::Model::IMPOSTOR_LOD] > 0)
                 {
-                    mesh->InitDraw();
-                    shaderProgram.UpdateUniforms(*m_scene, entity, *mesh, pointLights, directionalLights);
-                    mesh->DrawInstanced(modelInstancesComponent.instances);
-                    mesh->EndDraw();
+                    const auto& mesh{ modelInstancesComponent.impostor->GetMesh() };
+
+                    impostorShaderProgram.Bind();
+                    mesh.InitDraw();
+                    impostorShaderProgram.UpdateUniforms(*m_scene, entity, mesh, pointLights, directionalLights);
+                    mesh.DrawInstanced(static_cast<int32_t>(lodInstances[resource::Model::IMPOSTOR_LOD]), GL_TRIANGLE_STRIP);
+                    resource::Mesh::EndDraw();
+                    shaderProgram.Bind();
                 }
 
                 if (modelInstancesComponent.showTriangles)
@@ -108,6 +159,34 @@ namespace sg::ogl::ecs::system
     protected:
 
     private:
+        void RenderMeshes(
+            resource::ShaderProgram& t_shaderProgram,
+            const entt::entity t_entity,
+            const resource::Model& t_model,
+            const uint32_t t_instances,
+            const bool t_indirect,
+            const PointLightContainer& t_pointLights,
+            const DirectionalLightContainer& t_directionalLights
+        ) const
+        {
+            const auto& meshes{ t_model.GetMeshes() };
+            for (auto i{ 0u }; i < meshes.size(); ++i)
+            {
+                auto& mesh{ meshes[i] };
+                mesh->InitDraw();
+                t_shaderProgram.UpdateUniforms(*m_scene, t_entity, *mesh, t_pointLights, t_directionalLights);
 
+                if (t_indirect)
+                {
+                    t_model.DrawInstancesIndirect(i);
+                }
+                else
+                {
+                    mesh->DrawInstanced(static_cast<int32_t>(t_instances));
+                }
+
+                mesh->EndDraw();
+            }
+        }
     };
 }
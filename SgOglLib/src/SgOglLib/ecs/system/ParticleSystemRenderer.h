@@ -12,19 +12,23 @@
 #include "RenderSystem.h"
 #include "OpenGl.h"
 #include "Application.h"
+#include "particle/ParticleBatch.h"
 #include "resource/shaderprogram/ParticleSystemShaderProgram.h"
 #include "resource/shaderprogram/ParticleSystemInstShaderProgram.h"
+#include "resource/shaderprogram/ParticleSystemGpuShaderProgram.h"
 #include "resource/ShaderManager.h"
 
 namespace sg::ogl::ecs::system
 {
     class ParticleSystemRenderer : public RenderSystem<
         resource::shaderprogram::ParticleSystemShaderProgram,
-        resource::shaderprogram::ParticleSystemInstShaderProgram
+        resource::shaderprogram::ParticleSystemInstShaderProgram,
+        resource::shaderprogram::ParticleSystemGpuShaderProgram
     >
     {
     public:
         using MeshSharedPtr = std::shared_ptr<resource::Mesh>;
+        using BatchContainer = std::vector<std::unique_ptr<particle::ParticleBatch>>;
 
         //-------------------------------------------------
         // Ctors. / Dtor.
@@ -60,53 +64,86 @@ namespace sg::ogl::ecs::system
 
         void Render() override
         {
+            for (auto& batch : m_batches)
+            {
+                batch->Begin();
+            }
+
+            const auto viewMatrix{ m_scene->GetCurrentCamera().GetViewMatrix() };
+
             m_scene->GetApplicationContext()->registry.view<component::ParticleSystemComponent>().each(
                 [&](auto t_entity, component::ParticleSystemComponent& t_particleSystemComponent)
                 {
-                    if (t_particleSystemComponent.particleSystem->instancing)
+                    auto& particleSystem{ *t_particleSystemComponent.particleSystem };
+
+                    // the particles outside of the view frustum are only aged
+                    if (!particleSystem.IsVisible())
                     {
-                        t_particleSystemComponent.particleSystem->Render();
+                        return;
+                    }
 
-                        auto& shaderProgram{ m_scene->GetApplicationContext()->GetShaderManager().GetShaderProgram<resource::shaderprogram::ParticleSystemInstShaderProgram>() };
+                    // the instanced particles are collected in batches and drawn below
+                    if (!particleSystem.gpu && particleSystem.instancing)
+                    {
+                        if (particleSystem.GetAliveCount() > 0)
+                        {
+                            GetBatch(particleSystem.GetTextureId(), particleSystem.alphaBlending).Add(particleSystem, viewMatrix);
+                        }
+
+                        return;
+                    }
+
+                    SetBlending(particleSystem.alphaBlending);
+
+                    // the particles of the GPU path are drawn with the alive count from the GPU
+                    if (particleSystem.gpu)
+                    {
+                        auto& shaderProgram{ m_scene->GetApplicationContext()->GetShaderManager().GetShaderProgram<resource::shaderprogram::ParticleSystemGpuShaderProgram>() };
                         shaderProgram.Bind();
 
-                        t_particleSystemComponent.particleSystem->GetMesh().InitDraw();
+                        m_quadMesh->InitDraw();
                         shaderProgram.UpdateUniforms(*m_scene, t_entity, nullptr);
-                        t_particleSystemComponent.particleSystem->GetMesh().DrawInstanced(static_cast<int32_t>(t_particleSystemComponent.particleSystem->particles.size()), GL_TRIANGLE_STRIP);
+                        particleSystem.RenderGpu();
 
                         resource::Mesh::EndDraw();
+
+                        return;
                     }
-                    else
+
+                    // nothing to draw
+                    if (particleSystem.GetAliveCount() == 0)
                     {
-                        auto& shaderProgram{ m_scene->GetApplicationContext()->GetShaderManager().GetShaderProgram<resource::shaderprogram::ParticleSystemShaderProgram>() };
-                        shaderProgram.Bind();
+                        return;
+                    }
 
-                        m_quadMesh->InitDraw();
+                    auto& shaderProgram{ m_scene->GetApplicationContext()->GetShaderManager().GetShaderProgram<resource::shaderprogram::ParticleSystemShaderProgram>() };
+                    shaderProgram.Bind();
 
-                        for (auto& particle : t_particleSystemComponent.particleSystem->particles)
-                        {
-                            // skip inactive particles
-                            if (!particle.active)
-                            {
-                                continue;
-                            }
-
-                            // draw
-                            shaderProgram.UpdateUniforms(*m_scene, t_entity, &particle);
-                            m_quadMesh->DrawPrimitives(GL_TRIANGLE_STRIP);
-                        }
+                    m_quadMesh->InitDraw();
 
-                        resource::Mesh::EndDraw();
+                    const auto* order{ particleSystem.alphaBlending ? particleSystem.SortByDepth().data() : nullptr };
+
+                    for (auto n{ 0u }; n < particleSystem.GetAliveCount(); ++n)
+                    {
+                        auto particle{ particleSystem.GetParticle(order ? order[n] : n) };
+                        shaderProgram.UpdateUniforms(*m_scene, t_entity, &particle);
+                        m_quadMesh->DrawPrimitives(GL_TRIANGLE_STRIP);
                     }
+
+                    resource::Mesh::EndDraw();
                 }
             );
 
+            // one upload and one draw call per batch; the alpha blended batches last
+            RenderBatches(false);
+            RenderBatches(true);
+
             resource::ShaderProgram::Unbind();
         }
 
         void PrepareRendering() override
         {
-            //OpenGl::EnableAlphaBlending();
+            // the blend mode is set per ParticleSystem
             OpenGl::EnableAdditiveBlending();
 
             OpenGl::DisableWritingIntoDepthBuffer();
@@ -122,5 +159,65 @@ namespace sg::ogl::ecs::system
 
     private:
         MeshSharedPtr m_quadMesh;
+
+        /**
+         * @brief The instanced particles grouped by texture atlas and blend mode.
+         */
+        BatchContainer m_batches;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        static void SetBlending(const bool t_alphaBlending)
+        {
+            if (t_alphaBlending)
+            {
+                OpenGl::EnableAlphaBlending();
+            }
+            else
+            {
+                OpenGl::EnableAdditiveBlending();
+            }
+        }
+
+        particle::ParticleBatch& GetBatch(const uint32_t t_textureId, const bool t_alphaBlending)
+        {
+            for (auto& batch : m_batches)
+            {
+                if (batch->GetTextureId() == t_textureId && batch->IsAlphaBlending() == t_alphaBlending)
+                {
+                    return *batch;
+                }
+            }
+
+            m_batches.push_back(std::make_unique<particle::ParticleBatch>(t_textureId, t_alphaBlending));
+
+            return *m_batches.back();
+        }
+
+        void RenderBatches(const bool t_alphaBlending)
+        {
+            auto& shaderProgram{ m_scene->GetApplicationContext()->GetShaderManager().GetShaderProgram<resource::shaderprogram::ParticleSystemInstShaderProgram>() };
+
+            for (auto& batch : m_batches)
+            {
+                if (batch->IsAlphaBlending() != t_alphaBlending || batch->GetInstanceCount() == 0)
+                {
+                    continue;
+                }
+
+                batch->End();
+
+                SetBlending(t_alphaBlending);
+                shaderProgram.Bind();
+
+                batch->GetMesh().InitDraw();
+                shaderProgram.UpdateUniforms(*m_scene, entt::null, batch.get());
+                batch->GetMesh().DrawInstanced(static_cast<int32_t>(batch->GetInstanceCount()), GL_TRIANGLE_STRIP);
+
+                resource::Mesh::EndDraw();
+            }
+        }
     };
 }
@@ -12,7 +12,6 @@
 #include "RenderSystem.h"
 #include "resource/shaderprogram/TerrainQuadtreeShaderProgram.h"
 #include "resource/ShaderManager.h"
-#include "resource/Mesh.h"
 #include "terrain/TerrainQuadtree.h"
 #include "ecs/component/Components.h"
 
@@ -22,7 +21,6 @@ namespace sg::ogl::ecs::system
     {
     public:
         using DirectionalLightContainer = std::vector<light::DirectionalLight>;
-        using MeshSharedPtr = std::shared_ptr<resource::Mesh>;
 
         //-------------------------------------------------
         // Ctors. / Dtor.
@@ -31,14 +29,12 @@ namespace sg::ogl::ecs::system
         explicit TerrainQuadtreeRenderSystem(scene::Scene* t_scene)
             : RenderSystem(t_scene)
         {
-            m_patchMesh = m_scene->GetApplicationContext()->GetModelManager().GetStaticMeshByName(resource::ModelManager::TERRAIN_PATCH_MESH);
             name = "TerrainQuadtreeRenderer";
         }
 
         TerrainQuadtreeRenderSystem(const int t_priority, scene::Scene* t_scene)
             : RenderSystem(t_priority, t_scene)
         {
-            m_patchMesh = m_scene->GetApplicationContext()->GetModelManager().GetStaticMeshByName(resource::ModelManager::TERRAIN_PATCH_MESH);
             name = "TerrainQuadtreeRenderer";
         }
 
@@ -81,12 +77,8 @@ namespace sg::ogl::ecs::system
 
             for (auto entity : view)
             {
-                m_patchMesh->InitDraw();
-
                 auto& terrainQuadtreeComponent{ m_scene->GetApplicationContext()->registry.get<component::TerrainQuadtreeComponent>(entity) };
-                terrainQuadtreeComponent.terrainQuadtree->Render(shaderProgram, m_patchMesh, directionalLights);
-
-                m_patchMesh->EndDraw();
+                terrainQuadtreeComponent.terrainQuadtree->Render(shaderProgram, directionalLights);
             }
 
             resource::ShaderProgram::Unbind();
@@ -105,6 +97,5 @@ namespace sg::ogl::ecs::system
     protected:
 
     private:
-        MeshSharedPtr m_patchMesh;
     };
 }
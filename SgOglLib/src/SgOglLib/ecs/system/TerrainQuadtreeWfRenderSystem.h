@@ -12,7 +12,6 @@
 #include "RenderSystem.h"
 #include "resource/shaderprogram/TerrainQuadtreeWfShaderProgram.h"
 #include "resource/ShaderManager.h"
-#include "resource/Mesh.h"
 #include "terrain/TerrainQuadtree.h"
 #include "ecs/component/Components.h"
 
@@ -21,8 +20,6 @@ namespace sg::ogl::ecs::system
     class TerrainQuadtreeWfRenderSystem : public RenderSystem<resource::shaderprogram::TerrainQuadtreeWfShaderProgram>
     {
     public:
-        using MeshSharedPtr = std::shared_ptr<resource::Mesh>;
-
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -30,14 +27,12 @@ namespace sg::ogl::ecs::system
         explicit TerrainQuadtreeWfRenderSystem(scene::Scene* t_scene)
             : RenderSystem(t_scene)
         {
-            m_patchMesh = m_scene->GetApplicationContext()->GetModelManager().GetStaticMeshByName(resource::ModelManager::TERRAIN_PATCH_MESH);
             name = "TerrainQuadtreeWfRenderer";
         }
 
         TerrainQuadtreeWfRenderSystem(const int t_priority, scene::Scene* t_scene)
             : RenderSystem(t_priority, t_scene)
         {
-            m_patchMesh = m_scene->GetApplicationContext()->GetModelManager().GetStaticMeshByName(resource::ModelManager::TERRAIN_PATCH_MESH);
             name = "TerrainQuadtreeWfRenderer";
         }
 
@@ -69,12 +64,8 @@ namespace sg::ogl::ecs::system
 
             for (auto entity : view)
             {
-                m_patchMesh->InitDraw();
-
                 auto& terrainQuadtreeComponent{ m_scene->GetApplicationContext()->registry.get<component::TerrainQuadtreeComponent>(entity) };
-                terrainQuadtreeComponent.terrainQuadtree->RenderWireframe(shaderProgram, m_patchMesh);
-
-                m_patchMesh->EndDraw();
+                terrainQuadtreeComponent.terrainQuadtree->RenderWireframe(shaderProgram);
             }
 
             resource::ShaderProgram::Unbind();
@@ -95,6 +86,5 @@ namespace sg::ogl::ecs::system
     protected:
 
     private:
-        MeshSharedPtr m_patchMesh;
     };
 }
@@ -15,14 +15,15 @@
 #include "camera/Camera.h"
 #include "input/MouseInput.h"
 #include "scene/Scene.h"
+#include "terrain/TerrainConfig.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
 //-------------------------------------------------
 
-sg::ogl::input::MousePicker::MousePicker(scene::Scene* t_scene, terrain::Terrain* t_terrain)
+sg::ogl::input::MousePicker::MousePicker(scene::Scene* t_scene, terrain::TerrainConfig* t_terrainConfig)
     : m_scene{ t_scene }
-    , m_terrain{ t_terrain }
+    , m_terrainConfig{ t_terrainConfig }
 {
     SG_OGL_CORE_ASSERT(m_scene, "[MousePicker::MousePicker()] Null pointer.");
 
@@ -59,11 +60,12 @@ void sg::ogl::input::MousePicker::Update()
 
     m_currentRay = GetRayFromMouse(mouseX, mouseY);
 
-    if (m_terrain)
+    if (m_terrainConfig)
     {
-        if (IntersectionInRange(0.0f, RAY_RANGE, m_currentRay))
+        float distance;
+        if (m_terrainConfig->Raycast(m_scene->GetCurrentCamera().GetPosition(), m_currentRay, RAY_RANGE, distance))
         {
-            m_currentTerrainPoint = BinarySearch(0, 0.0f, RAY_RANGE, m_currentRay);
+            m_currentTerrainPoint = GetPointOnRay(m_currentRay, distance);
         }
     }
 }
@@ -244,41 +246,3 @@ glm::vec3 sg::ogl::input::MousePicker::GetPointOnRay(const glm::vec3 t_ray, cons
 
     return cameraPosition + scaled;
 }
-
-glm::vec3 sg::ogl::input::MousePicker::BinarySearch(const int t_count, const float t_start, const float t_end, const glm::vec3 t_ray) const
-{
-    const auto half{ t_start + ((t_end - t_start) / 2.0f) };
-
-    if (t_count >= RECURSION_COUNT)
-    {
-        return GetPointOnRay(t_ray, half);
-    }
-
-    if (IntersectionInRange(t_start, half, t_ray))
-    {
-        return BinarySearch(t_count + 1, t_start, half, t_ray);
-    }
-    else
-    {
-        return BinarySearch(t_count + 1, half, t_end, t_ray);
-    }
-}
-
-bool sg::ogl::input::MousePicker::IntersectionInRange(const float t_start, const float t_end, const glm::vec3 t_ray) const
-{
-    const auto start{ GetPointOnRay(t_ray, t_start) };
-    const auto end{ GetPointOnRay(t_ray, t_end) };
-
-    return !IsUnderground(start) && IsUnderground(end);
-}
-
-bool sg::ogl::input::MousePicker::IsUnderground(const glm::vec3 t_point) const
-{
-    /*
-    const auto height{ m_terrain->GetHeightAtWorldPosition(t_point.x, t_point.z) };
-
-    return t_point.y < height;
-    */
-
-    return false;
-}
@@ -13,7 +13,7 @@
 
 namespace sg::ogl::terrain
 {
-    class Terrain;
+    class TerrainConfig;
 }
 
 namespace sg::ogl::scene
@@ -26,7 +26,6 @@ namespace sg::ogl::input
     class MousePicker
     {
     public:
-        static constexpr int RECURSION_COUNT{ 200 };
         static constexpr float RAY_RANGE{ 600.0f };
 
         //-------------------------------------------------
@@ -35,7 +34,7 @@ namespace sg::ogl::input
 
         MousePicker() = delete;
 
-        explicit MousePicker(scene::Scene* t_scene, terrain::Terrain* t_terrain = nullptr);
+        explicit MousePicker(scene::Scene* t_scene, terrain::TerrainConfig* t_terrainConfig = nullptr);
 
         MousePicker(const MousePicker& t_other) = delete;
         MousePicker(MousePicker&& t_other) noexcept = delete;
@@ -87,9 +86,9 @@ namespace sg::ogl::input
         scene::Scene* m_scene{ nullptr };
 
         /**
-         * @brief Pointer to a Terrain object.
+         * @brief Pointer to the TerrainConfig of the picked terrain.
          */
-        terrain::Terrain* m_terrain{ nullptr };
+        terrain::TerrainConfig* m_terrainConfig{ nullptr };
 
         /**
          * @brief The current mouse ray.
@@ -118,9 +117,5 @@ namespace sg::ogl::input
         //-------------------------------------------------
 
         glm::vec3 GetPointOnRay(glm::vec3 t_ray, float t_distance) const;
-        glm::vec3 BinarySearch(int t_count, float t_start, float t_end, glm::vec3 t_ray) const;
-
-        bool IntersectionInRange(float t_start, float t_end, glm::vec3 t_ray) const;
-        bool IsUnderground(glm::vec3 t_point) const;
     };
 }
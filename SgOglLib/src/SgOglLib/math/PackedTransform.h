@@ -0,0 +1,97 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: PackedTransform.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/packing.hpp>
+#include "Transform.h"
+
+namespace sg::ogl::math
+{
+    /**
+     * @brief The compact per instance layout of the instance Vbos: 24 bytes instead of the 64 bytes
+     *        of a model matrix. The vertex shader rebuilds the transformation from it.
+     *        Only a uniform scale can be stored.
+     */
+    struct PackedTransform
+    {
+        static constexpr float SNORM16_MAX{ 32767.0f };
+
+        glm::vec3 position{ glm::vec3(0.0f) };
+
+        /**
+         * @brief The rotation quaternion (x, y, z, w) as normalized 16-bit integers.
+         */
+        int16_t rotation[4]{ 0, 0, 0, static_cast<int16_t>(SNORM16_MAX) };
+
+        /**
+         * @brief The uniform scale as half float.
+         */
+        uint16_t scale{ glm::packHalf1x16(1.0f) };
+
+        uint16_t padding{ 0 };
+
+        PackedTransform() = default;
+
+        /**
+         * @brief Packs a Transform. The largest scale component is used as uniform scale.
+         */
+        explicit PackedTransform(const Transform& t_transform)
+            : position{ t_transform.position }
+            , scale{ glm::packHalf1x16(std::max({ t_transform.scale.x, t_transform.scale.y, t_transform.scale.z })) }
+        {
+            // the same order as the matrix of the Transform: x, then y, then z
+            const auto quaternion{
+                angleAxis(glm::radians(t_transform.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f)) *
+                angleAxis(glm::radians(t_transform.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f)) *
+                angleAxis(glm::radians(t_transform.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f))
+            };
+
+            rotation[0] = PackSnorm16(quaternion.x);
+            rotation[1] = PackSnorm16(quaternion.y);
+            rotation[2] = PackSnorm16(quaternion.z);
+            rotation[3] = PackSnorm16(quaternion.w);
+        }
+
+        /**
+         * @brief The rotation as the vertex shader sees it.
+         */
+        [[nodiscard]] glm::quat GetRotation() const
+        {
+            return normalize(glm::quat(
+                static_cast<float>(rotation[3]) / SNORM16_MAX,
+                static_cast<float>(rotation[0]) / SNORM16_MAX,
+                static_cast<float>(rotation[1]) / SNORM16_MAX,
+                static_cast<float>(rotation[2]) / SNORM16_MAX
+            ));
+        }
+
+        [[nodiscard]] float GetScale() const
+        {
+            return glm::unpackHalf1x16(scale);
+        }
+
+        [[nodiscard]] static bool HasUniformScale(const Transform& t_transform)
+        {
+            return t_transform.scale.x == t_transform.scale.y && t_transform.scale.y == t_transform.scale.z;
+        }
+
+    private:
+        static int16_t PackSnorm16(const float t_value)
+        {
+            return static_cast<int16_t>(std::round(std::clamp(t_value, -1.0f, 1.0f) * SNORM16_MAX));
+        }
+    };
+
+    static_assert(sizeof(PackedTransform) == 24, "The PackedTransform must match the instance attributes.");
+}
@@ -0,0 +1,294 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: DepthSorter.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <array>
+#include <cstring>
+#include "DepthSorter.h"
+
+//-------------------------------------------------
+// Sort
+//-------------------------------------------------
+
+const sg::ogl::particle::DepthSorter::IndexContainer& sg::ogl::particle::DepthSorter::Sort(const float* t_depths, const uint64_t* t_ids, const uint32_t t_count)
+{
+    const auto lastCount{ CarryOverLastOrder(t_ids, t_count) };
+
+    // the keys in the order of the last frame
+    m_keys.resize(t_count);
+    for (auto i{ 0u }; i < t_count; ++i)
+    {
+        m_keys[i] = ToSortableKey(t_depths[m_indices[i]]);
+    }
+
+    // the new particles are behind the particles of the last frame
+    m_newKeys.assign(m_keys.begin() + lastCount, m_keys.end());
+    m_newIndices.assign(m_indices.begin() + lastCount, m_indices.end());
+    m_keys.resize(lastCount);
+    m_indices.resize(lastCount);
+
+    m_incremental = InsertionSort(static_cast<uint64_t>(lastCount) * MAX_MOVES_PER_ELEMENT);
+    if (!m_incremental)
+    {
+        RadixSort(m_keys, m_indices);
+    }
+
+    RadixSort(m_newKeys, m_newIndices);
+    MergeNew();
+
+    // remember the order by id for the next frame
+    m_lastIds.resize(t_count);
+    for (auto i{ 0u }; i < t_count; ++i)
+    {
+        m_lastIds[i] = t_ids[m_indices[i]];
+    }
+
+    return m_indices;
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+const sg::ogl::particle::DepthSorter::IndexContainer& sg::ogl::particle::DepthSorter::GetIndices() const noexcept
+{
+    return m_indices;
+}
+
+bool sg::ogl::particle::DepthSorter::IsIncremental() const noexcept
+{
+    return m_incremental;
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+uint32_t sg::ogl::particle::DepthSorter::ToSortableKey(const float t_value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &t_value, sizeof(bits));
+
+    // negative values: flip all bits; positive values: flip the sign bit
+    const auto mask{ (bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u };
+
+    return bits ^ mask;
+}
+
+//-------------------------------------------------
+// Sort
+//-------------------------------------------------
+
+uint32_t sg::ogl::particle::DepthSorter::CarryOverLastOrder(const uint64_t* t_ids, const uint32_t t_count)
+{
+    BuildLookupTable(t_ids, t_count);
+
+    m_seen.assign(t_count, 0);
+    m_indices.resize(t_count);
+
+    // keep the particles of the last frame which are still alive in their order
+    auto n{ 0u };
+    for (const auto id : m_lastIds)
+    {
+        const auto index{ FindIndex(id) };
+        if (index != EMPTY_BUCKET && !m_seen[index])
+        {
+            m_seen[index] = 1;
+            m_indices[n++] = index;
+        }
+    }
+
+    const auto lastCount{ n };
+
+    // append the new particles
+    for (auto i{ 0u }; i < t_count; ++i)
+    {
+        if (!m_seen[i])
+        {
+            m_indices[n++] = i;
+        }
+    }
+
+    return lastCount;
+}
+
+void sg::ogl::particle::DepthSorter::BuildLookupTable(const uint64_t* t_ids, const uint32_t t_count)
+{
+    // a power of two with a load factor of at most 0.5
+    size_t size{ 16 };
+    m_bucketShift = 60;
+    while (size < static_cast<size_t>(t_count) * 2)
+    {
+        size *= 2;
+        --m_bucketShift;
+    }
+
+    m_buckets.assign(size, { 0, EMPTY_BUCKET });
+
+    const auto mask{ size - 1 };
+    for (auto i{ 0u }; i < t_count; ++i)
+    {
+        auto bucket{ static_cast<size_t>((t_ids[i] * FIBONACCI_HASH) >> m_bucketShift) };
+        while (m_buckets[bucket].index != EMPTY_BUCKET)
+        {
+            bucket = (bucket + 1) & mask;
+        }
+
+        m_buckets[bucket] = { t_ids[i], i };
+    }
+}
+
+uint32_t sg::ogl::particle::DepthSorter::FindIndex(const uint64_t t_id) const
+{
+    const auto mask{ m_buckets.size() - 1 };
+
+    auto bucket{ static_cast<size_t>((t_id * FIBONACCI_HASH) >> m_bucketShift) };
+    while (m_buckets[bucket].index != EMPTY_BUCKET)
+    {
+        if (m_buckets[bucket].id == t_id)
+        {
+            return m_buckets[bucket].index;
+        }
+
+        bucket = (bucket + 1) & mask;
+    }
+
+    return EMPTY_BUCKET;
+}
+
+bool sg::ogl::particle::DepthSorter::InsertionSort(const uint64_t t_maxMoves)
+{
+    const auto n{ m_keys.size() };
+    uint64_t moves{ 0 };
+
+    for (size_t i{ 1 }; i < n; ++i)
+    {
+        const auto key{ m_keys[i] };
+        const auto index{ m_indices[i] };
+
+        auto j{ i };
+        while (j > 0 && m_keys[j - 1] > key)
+        {
+            m_keys[j] = m_keys[j - 1];
+            m_indices[j] = m_indices[j - 1];
+            --j;
+            ++moves;
+        }
+
+        m_keys[j] = key;
+        m_indices[j] = index;
+
+        // the order changed too much; the arrays are still consistent
+        if (moves > t_maxMoves)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void sg::ogl::particle::DepthSorter::RadixSort(KeyContainer& t_keys, IndexContainer& t_indices)
+{
+    const auto n{ static_cast<uint32_t>(t_keys.size()) };
+    if (n < 2)
+    {
+        return;
+    }
+
+    m_tmpKeys.resize(n);
+    m_tmpIndices.resize(n);
+
+    // all histograms in one pass
+    std::array<std::array<uint32_t, 256>, 4> histograms{};
+    for (const auto key : t_keys)
+    {
+        ++histograms[0][key & 0xFF];
+        ++histograms[1][(key >> 8) & 0xFF];
+        ++histograms[2][(key >> 16) & 0xFF];
+        ++histograms[3][key >> 24];
+    }
+
+    for (auto pass{ 0u }; pass < 4; ++pass)
+    {
+        const auto shift{ pass * 8 };
+        auto& histogram{ histograms[pass] };
+
+        // skip the pass if all keys have the same digit
+        if (histogram[(t_keys[0] >> shift) & 0xFF] == n)
+        {
+            continue;
+        }
+
+        // exclusive prefix sum
+        auto sum{ 0u };
+        for (auto& count : histogram)
+        {
+            const auto c{ count };
+            count = sum;
+            sum += c;
+        }
+
+        for (auto i{ 0u }; i < n; ++i)
+        {
+            const auto destination{ histogram[(t_keys[i] >> shift) & 0xFF]++ };
+            m_tmpKeys[destination] = t_keys[i];
+            m_tmpIndices[destination] = t_indices[i];
+        }
+
+        t_keys.swap(m_tmpKeys);
+        t_indices.swap(m_tmpIndices);
+    }
+}
+
+void sg::ogl::particle::DepthSorter::MergeNew()
+{
+    if (m_newKeys.empty())
+    {
+        return;
+    }
+
+    const auto lastCount{ m_keys.size() };
+    const auto newCount{ m_newKeys.size() };
+
+    m_tmpKeys.resize(lastCount + newCount);
+    m_tmpIndices.resize(lastCount + newCount);
+
+    // on equal keys, the particles of the last frame come first
+    size_t i{ 0 };
+    size_t j{ 0 };
+    size_t n{ 0 };
+    while (i < lastCount && j < newCount)
+    {
+        if (m_newKeys[j] < m_keys[i])
+        {
+            m_tmpKeys[n] = m_newKeys[j];
+            m_tmpIndices[n++] = m_newIndices[j++];
+        }
+        else
+        {
+            m_tmpKeys[n] = m_keys[i];
+            m_tmpIndices[n++] = m_indices[i++];
+        }
+    }
+
+    for (; i < lastCount; ++i)
+    {
+        m_tmpKeys[n] = m_keys[i];
+        m_tmpIndices[n++] = m_indices[i];
+    }
+
+    for (; j < newCount; ++j)
+    {
+        m_tmpKeys[n] = m_newKeys[j];
+        m_tmpIndices[n++] = m_newIndices[j];
+    }
+
+    m_keys.swap(m_tmpKeys);
+    m_indices.swap(m_tmpIndices);
+}
@@ -0,0 +1,136 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: DepthSorter.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace sg::ogl::particle
+{
+    /**
+     * @brief Sorts particle indices by depth for back-to-front rendering.
+     *        The order of the last frame is kept as a list of stable particle ids and used
+     *        as starting point, so that it survives the compaction of the ParticleStore and
+     *        a changing order of the ParticleSystems in a batch. If the order barely changed,
+     *        a bounded insertion sort is enough; otherwise a LSD radix sort on (key, index)
+     *        pairs is used. The new particles are radix sorted on their own and merged in.
+     */
+    class DepthSorter
+    {
+    public:
+        using IndexContainer = std::vector<uint32_t>;
+        using KeyContainer = std::vector<uint32_t>;
+        using IdContainer = std::vector<uint64_t>;
+
+        /**
+         * @brief The insertion sort gives up after (number of elements * this value) moves.
+         */
+        static constexpr uint32_t MAX_MOVES_PER_ELEMENT{ 4 };
+
+        /**
+         * @brief Marks a free bucket of the id lookup table.
+         */
+        static constexpr uint32_t EMPTY_BUCKET{ 0xFFFFFFFF };
+
+        /**
+         * @brief 2^64 divided by the golden ratio; spreads consecutive ids over the table.
+         */
+        static constexpr uint64_t FIBONACCI_HASH{ 0x9E3779B97F4A7C15ull };
+
+        //-------------------------------------------------
+        // Sort
+        //-------------------------------------------------
+
+        /**
+         * @brief Sorts the indices [0, t_count) ascending by their depth value.
+         *        With the view space z coordinates as depth values, this is back-to-front.
+         * @param t_depths The depth value for each index.
+         * @param t_ids The stable particle id for each index.
+         * @param t_count The number of depth values.
+         * @return The sorted indices.
+         */
+        const IndexContainer& Sort(const float* t_depths, const uint64_t* t_ids, uint32_t t_count);
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] const IndexContainer& GetIndices() const noexcept;
+
+        /**
+         * @brief Indicates whether the particles of the last frame were sorted without the radix sort.
+         */
+        [[nodiscard]] bool IsIncremental() const noexcept;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * @brief Maps a float to an unsigned int, so that the unsigned order is the float order.
+         */
+        static uint32_t ToSortableKey(float t_value);
+
+    protected:
+
+    private:
+        struct Bucket
+        {
+            uint64_t id;
+            uint32_t index;
+        };
+
+        IndexContainer m_indices;
+        IndexContainer m_tmpIndices;
+
+        KeyContainer m_keys;
+        KeyContainer m_tmpKeys;
+
+        /**
+         * @brief The keys and indices of the particles which are new in this frame.
+         */
+        KeyContainer m_newKeys;
+        IndexContainer m_newIndices;
+
+        std::vector<uint8_t> m_seen;
+
+        /**
+         * @brief The particle ids in the sorted order of the last frame.
+         */
+        IdContainer m_lastIds;
+
+        /**
+         * @brief Open addressing table from the particle id to the index of the current frame.
+         */
+        std::vector<Bucket> m_buckets;
+
+        /**
+         * @brief The table has 2^(64 - m_bucketShift) buckets.
+         */
+        uint32_t m_bucketShift{ 64 };
+
+        bool m_incremental{ false };
+
+        //-------------------------------------------------
+        // Sort
+        //-------------------------------------------------
+
+        /**
+         * @brief Puts the particles of the last frame in their old order, followed by the new particles.
+         * @return The number of particles of the last frame.
+         */
+        uint32_t CarryOverLastOrder(const uint64_t* t_ids, uint32_t t_count);
+        void BuildLookupTable(const uint64_t* t_ids, uint32_t t_count);
+        [[nodiscard]] uint32_t FindIndex(uint64_t t_id) const;
+        bool InsertionSort(uint64_t t_maxMoves);
+        void RadixSort(KeyContainer& t_keys, IndexContainer& t_indices);
+        void MergeNew();
+    };
+}
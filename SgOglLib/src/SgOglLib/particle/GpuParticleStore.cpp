@@ -0,0 +1,234 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: GpuParticleStore.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <cstddef>
+#include <algorithm>
+#include "GpuParticleStore.h"
+#include "OpenGl.h"
+#include "Core.h"
+#include "buffer/Vbo.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+sg::ogl::particle::GpuParticleStore::GpuParticleStore(const uint32_t t_capacity)
+    : m_capacity{ t_capacity }
+{
+    SG_OGL_CORE_ASSERT(t_capacity, "[GpuParticleStore::GpuParticleStore()] Invalid value.");
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[GpuParticleStore::GpuParticleStore()] Create GpuParticleStore.");
+
+    Init();
+}
+
+sg::ogl::particle::GpuParticleStore::~GpuParticleStore() noexcept
+{
+    Log::SG_OGL_CORE_LOG_DEBUG("[GpuParticleStore::~GpuParticleStore()] Destruct GpuParticleStore.");
+
+    CleanUp();
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+uint32_t sg::ogl::particle::GpuParticleStore::GetCapacity() const noexcept
+{
+    return m_capacity;
+}
+
+uint32_t sg::ogl::particle::GpuParticleStore::GetCurrentIndex() const noexcept
+{
+    return m_current;
+}
+
+uint32_t sg::ogl::particle::GpuParticleStore::GetNextIndex() const noexcept
+{
+    return 1 - m_current;
+}
+
+uint32_t sg::ogl::particle::GpuParticleStore::GetNumberOfWorkGroups() const noexcept
+{
+    return (m_capacity + WORK_GROUP_SIZE - 1) / WORK_GROUP_SIZE;
+}
+
+float sg::ogl::particle::GpuParticleStore::GetTimeStep() const noexcept
+{
+    return m_dt;
+}
+
+uint32_t sg::ogl::particle::GpuParticleStore::GetEmitCount() const noexcept
+{
+    return m_emitCount;
+}
+
+const glm::vec3& sg::ogl::particle::GpuParticleStore::GetEmitCenter() const noexcept
+{
+    return m_emitCenter;
+}
+
+uint32_t sg::ogl::particle::GpuParticleStore::GetSeed() const noexcept
+{
+    return m_seed;
+}
+
+//-------------------------------------------------
+// Setter
+//-------------------------------------------------
+
+void sg::ogl::particle::GpuParticleStore::SetTimeStep(const float t_dt)
+{
+    m_dt = t_dt;
+}
+
+void sg::ogl::particle::GpuParticleStore::SetEmission(const uint32_t t_emitCount, const glm::vec3& t_emitCenter, const uint32_t t_seed)
+{
+    m_emitCount = t_emitCount;
+    m_emitCenter = t_emitCenter;
+    m_seed = t_seed;
+}
+
+void sg::ogl::particle::GpuParticleStore::Resize(const uint32_t t_capacity)
+{
+    SG_OGL_CORE_ASSERT(t_capacity, "[GpuParticleStore::Resize()] Invalid value.");
+
+    if (t_capacity == m_capacity)
+    {
+        return;
+    }
+
+    // the shaders must have finished writing the counter before it is read back
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    DrawArraysIndirectCommand command;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_commandBufferId);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, m_current * sizeof(DrawArraysIndirectCommand), sizeof(DrawArraysIndirectCommand), &command);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    const auto aliveCount{ std::min(command.instanceCount, t_capacity) };
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[GpuParticleStore::Resize()] Resize from {} to {} particles, keep {} living particles.", m_capacity, t_capacity, aliveCount);
+
+    const auto oldBufferId{ m_particleBufferIds[m_current] };
+    const auto oldParticleBufferIds{ m_particleBufferIds };
+    const auto oldCommandBufferId{ m_commandBufferId };
+
+    m_capacity = t_capacity;
+    m_current = 0;
+    Init();
+
+    // copy the living particles to the front of the new current buffer
+    if (aliveCount > 0)
+    {
+        glBindBuffer(GL_COPY_READ_BUFFER, oldBufferId);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_particleBufferIds[m_current]);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<size_t>(aliveCount) * NUMBER_OF_FLOATS_PER_PARTICLE * sizeof(float));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_commandBufferId);
+        glBufferSubData(
+            GL_SHADER_STORAGE_BUFFER,
+            m_current * sizeof(DrawArraysIndirectCommand) + offsetof(DrawArraysIndirectCommand, instanceCount),
+            sizeof(uint32_t),
+            &aliveCount
+        );
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    for (const auto bufferId : oldParticleBufferIds)
+    {
+        buffer::Vbo::DeleteVbo(bufferId);
+    }
+
+    buffer::Vbo::DeleteVbo(oldCommandBufferId);
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void sg::ogl::particle::GpuParticleStore::BeginSimulation() const
+{
+    // reset the alive counter of the output buffer
+    const uint32_t zero{ 0 };
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_commandBufferId);
+    glBufferSubData(
+        GL_SHADER_STORAGE_BUFFER,
+        GetNextIndex() * sizeof(DrawArraysIndirectCommand) + offsetof(DrawArraysIndirectCommand, instanceCount),
+        sizeof(uint32_t),
+        &zero
+    );
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, IN_BINDING, m_particleBufferIds[m_current]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OUT_BINDING, m_particleBufferIds[GetNextIndex()]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMAND_BINDING, m_commandBufferId);
+}
+
+void sg::ogl::particle::GpuParticleStore::EndSimulation()
+{
+    m_current = GetNextIndex();
+}
+
+void sg::ogl::particle::GpuParticleStore::BeginEmission() const
+{
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OUT_BINDING, m_particleBufferIds[m_current]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMAND_BINDING, m_commandBufferId);
+}
+
+void sg::ogl::particle::GpuParticleStore::Draw() const
+{
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, IN_BINDING, m_particleBufferIds[m_current]);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBufferId);
+
+    glDrawArraysIndirect(GL_TRIANGLE_STRIP, reinterpret_cast<void*>(static_cast<uintptr_t>(m_current * sizeof(DrawArraysIndirectCommand))));
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+//-------------------------------------------------
+// Init
+//-------------------------------------------------
+
+void sg::ogl::particle::GpuParticleStore::Init()
+{
+    const auto bufferSize{ static_cast<size_t>(m_capacity) * NUMBER_OF_FLOATS_PER_PARTICLE * sizeof(float) };
+
+    for (auto& bufferId : m_particleBufferIds)
+    {
+        bufferId = buffer::Vbo::GenerateVbo();
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, bufferId);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, bufferSize, nullptr, GL_DYNAMIC_COPY);
+    }
+
+    // one command for each particle buffer; four vertices for the quad as triangle strip
+    const std::array<DrawArraysIndirectCommand, 2> commands{};
+
+    m_commandBufferId = buffer::Vbo::GenerateVbo();
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_commandBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(commands), commands.data(), GL_DYNAMIC_DRAW);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+//-------------------------------------------------
+// CleanUp
+//-------------------------------------------------
+
+void sg::ogl::particle::GpuParticleStore::CleanUp() const
+{
+    for (const auto bufferId : m_particleBufferIds)
+    {
+        buffer::Vbo::DeleteVbo(bufferId);
+    }
+
+    buffer::Vbo::DeleteVbo(m_commandBufferId);
+}
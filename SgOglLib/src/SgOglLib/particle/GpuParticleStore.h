@@ -0,0 +1,165 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: GpuParticleStore.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <glm/vec3.hpp>
+
+namespace sg::ogl::particle
+{
+    /**
+     * @brief GPU resident particle state for the compute shader path of a ParticleSystem.
+     *        Two shader storage buffers are used as ping-pong buffers: the simulation reads
+     *        the living particles from one buffer and appends the survivors to the other one.
+     *        The number of living particles of each buffer is the instanceCount of a
+     *        DrawArraysIndirectCommand, which is incremented atomically by the compute shaders
+     *        and consumed directly by glDrawArraysIndirect.
+     */
+    class GpuParticleStore
+    {
+    public:
+        struct DrawArraysIndirectCommand
+        {
+            uint32_t count{ 4 };
+            uint32_t instanceCount{ 0 };
+            uint32_t first{ 0 };
+            uint32_t baseInstance{ 0 };
+        };
+
+        /**
+         * @brief A particle has two vec4: position + life and velocity + lifetime.
+         */
+        static constexpr uint32_t NUMBER_OF_FLOATS_PER_PARTICLE{ 8 };
+
+        /**
+         * @brief The local size of the compute shaders.
+         */
+        static constexpr uint32_t WORK_GROUP_SIZE{ 256 };
+
+        /**
+         * @brief The binding points of the buffers in the shaders.
+         */
+        static constexpr uint32_t IN_BINDING{ 0 };
+        static constexpr uint32_t OUT_BINDING{ 1 };
+        static constexpr uint32_t COMMAND_BINDING{ 2 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        GpuParticleStore() = delete;
+
+        explicit GpuParticleStore(uint32_t t_capacity);
+
+        GpuParticleStore(const GpuParticleStore& t_other) = delete;
+        GpuParticleStore(GpuParticleStore&& t_other) noexcept = delete;
+        GpuParticleStore& operator=(const GpuParticleStore& t_other) = delete;
+        GpuParticleStore& operator=(GpuParticleStore&& t_other) noexcept = delete;
+
+        ~GpuParticleStore() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] uint32_t GetCapacity() const noexcept;
+        [[nodiscard]] uint32_t GetCurrentIndex() const noexcept;
+        [[nodiscard]] uint32_t GetNextIndex() const noexcept;
+
+        /**
+         * @brief The number of work groups to cover the whole capacity.
+         */
+        [[nodiscard]] uint32_t GetNumberOfWorkGroups() const noexcept;
+
+        [[nodiscard]] float GetTimeStep() const noexcept;
+        [[nodiscard]] uint32_t GetEmitCount() const noexcept;
+        [[nodiscard]] const glm::vec3& GetEmitCenter() const noexcept;
+        [[nodiscard]] uint32_t GetSeed() const noexcept;
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * @brief Sets the values of the next simulation dispatch.
+         * @param t_dt The frame time.
+         */
+        void SetTimeStep(float t_dt);
+
+        /**
+         * @brief Sets the values of the next emission dispatch.
+         * @param t_emitCount The number of new particles.
+         * @param t_emitCenter The world space center of the new particles.
+         * @param t_seed The seed of the random values in the shader.
+         */
+        void SetEmission(uint32_t t_emitCount, const glm::vec3& t_emitCenter, uint32_t t_seed);
+
+        /**
+         * @brief Recreates the buffers with a new capacity. The living particles are copied
+         *        into the new buffers; if the capacity shrinks, the particles beyond it are lost.
+         * @param t_capacity The new max number of particles.
+         */
+        void Resize(uint32_t t_capacity);
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * @brief Resets the alive counter of the next buffer and binds the current
+         *        buffer as input and the next buffer as output.
+         */
+        void BeginSimulation() const;
+
+        /**
+         * @brief The next buffer becomes the current buffer.
+         */
+        void EndSimulation();
+
+        /**
+         * @brief Binds the current buffer as output, so that new particles are appended.
+         */
+        void BeginEmission() const;
+
+        /**
+         * @brief Binds the current buffer for reading in the vertex shader and issues
+         *        the indirect draw call. The Vao of the quad must be bound.
+         */
+        void Draw() const;
+
+    protected:
+
+    private:
+        uint32_t m_capacity{ 0 };
+
+        std::array<uint32_t, 2> m_particleBufferIds{ 0, 0 };
+        uint32_t m_commandBufferId{ 0 };
+
+        uint32_t m_current{ 0 };
+
+        float m_dt{ 0.0f };
+        uint32_t m_emitCount{ 0 };
+        glm::vec3 m_emitCenter{ glm::vec3(0.0f) };
+        uint32_t m_seed{ 0 };
+
+        //-------------------------------------------------
+        // Init
+        //-------------------------------------------------
+
+        void Init();
+
+        //-------------------------------------------------
+        // CleanUp
+        //-------------------------------------------------
+
+        void CleanUp() const;
+    };
+}
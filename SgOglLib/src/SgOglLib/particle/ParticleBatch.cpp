@@ -0,0 +1,196 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ParticleBatch.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <algorithm>
+#include "ParticleBatch.h"
+#include "ParticleSystem.h"
+#include "Core.h"
+#include "buffer/Vao.h"
+#include "buffer/Vbo.h"
+#include "resource/Mesh.h"
+#include "resource/ModelManager.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+sg::ogl::particle::ParticleBatch::ParticleBatch(const uint32_t t_textureId, const bool t_alphaBlending)
+    : m_textureId{ t_textureId }
+    , m_alphaBlending{ t_alphaBlending }
+{
+    SG_OGL_CORE_ASSERT(t_textureId, "[ParticleBatch::ParticleBatch()] Invalid value.");
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[ParticleBatch::ParticleBatch()] Create ParticleBatch for texture Id {}.", t_textureId);
+
+    Init();
+}
+
+sg::ogl::particle::ParticleBatch::~ParticleBatch() noexcept
+{
+    Log::SG_OGL_CORE_LOG_DEBUG("[ParticleBatch::~ParticleBatch()] Destruct ParticleBatch.");
+
+    buffer::Vbo::DeleteVbo(m_vboId);
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+uint32_t sg::ogl::particle::ParticleBatch::GetTextureId() const noexcept
+{
+    return m_textureId;
+}
+
+bool sg::ogl::particle::ParticleBatch::IsAlphaBlending() const noexcept
+{
+    return m_alphaBlending;
+}
+
+uint32_t sg::ogl::particle::ParticleBatch::GetInstanceCount() const noexcept
+{
+    return m_instanceCount;
+}
+
+const sg::ogl::resource::Mesh& sg::ogl::particle::ParticleBatch::GetMesh() const noexcept
+{
+    return *m_mesh;
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void sg::ogl::particle::ParticleBatch::Begin()
+{
+    m_instanceCount = 0;
+    m_instancedData.clear();
+    m_depths.clear();
+    m_ids.clear();
+}
+
+void sg::ogl::particle::ParticleBatch::Add(const ParticleSystem& t_particleSystem, const glm::mat4& t_viewMatrix)
+{
+    const auto& store{ t_particleSystem.GetStore() };
+    const auto textureRows{ static_cast<float>(t_particleSystem.GetTextureRows()) };
+
+    m_instancedData.reserve(m_instancedData.size() + static_cast<size_t>(store.aliveCount) * NUMBER_OF_FLOATS_PER_INSTANCE);
+
+    for (auto i{ 0u }; i < store.aliveCount; ++i)
+    {
+        // position + scale
+        m_instancedData.push_back(store.px[i]);
+        m_instancedData.push_back(store.py[i]);
+        m_instancedData.push_back(store.pz[i]);
+        m_instancedData.push_back(store.scale[i]);
+
+        // texture atlas index + blend factor + texture rows
+        m_instancedData.push_back(store.atlasIndex[i]);
+        m_instancedData.push_back(store.blend[i]);
+        m_instancedData.push_back(textureRows);
+    }
+
+    if (m_alphaBlending)
+    {
+        for (auto i{ 0u }; i < store.aliveCount; ++i)
+        {
+            m_depths.push_back(t_viewMatrix[0][2] * store.px[i] + t_viewMatrix[1][2] * store.py[i] + t_viewMatrix[2][2] * store.pz[i] + t_viewMatrix[3][2]);
+        }
+
+        m_ids.insert(m_ids.end(), store.id.begin(), store.id.begin() + store.aliveCount);
+    }
+
+    m_instanceCount += store.aliveCount;
+}
+
+void sg::ogl::particle::ParticleBatch::End()
+{
+    if (m_instanceCount == 0)
+    {
+        return;
+    }
+
+    const auto* data{ m_instancedData.data() };
+
+    // back-to-front over all systems of this batch
+    if (m_alphaBlending)
+    {
+        const auto& order{ m_depthSorter.Sort(m_depths.data(), m_ids.data(), m_instanceCount) };
+
+        m_sortedInstancedData.resize(m_instancedData.size());
+        for (auto n{ 0u }; n < m_instanceCount; ++n)
+        {
+            std::copy_n(
+                m_instancedData.begin() + static_cast<size_t>(order[n]) * NUMBER_OF_FLOATS_PER_INSTANCE,
+                NUMBER_OF_FLOATS_PER_INSTANCE,
+                m_sortedInstancedData.begin() + static_cast<size_t>(n) * NUMBER_OF_FLOATS_PER_INSTANCE
+            );
+        }
+
+        data = m_sortedInstancedData.data();
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vboId);
+
+    // grow the Vbo if necessary; otherwise orphan the old storage
+    if (m_vboSize < m_instanceCount)
+    {
+        m_vboSize = std::max(m_instanceCount, m_vboSize * 2);
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, NUMBER_OF_FLOATS_PER_INSTANCE * static_cast<size_t>(m_vboSize) * sizeof(float), nullptr, GL_STREAM_DRAW);
+
+    glBufferSubData(
+        GL_ARRAY_BUFFER,
+        0,
+        NUMBER_OF_FLOATS_PER_INSTANCE * static_cast<size_t>(m_instanceCount) * sizeof(float),
+        data
+    );
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+//-------------------------------------------------
+// Init
+//-------------------------------------------------
+
+void sg::ogl::particle::ParticleBatch::Init()
+{
+    // create Mesh
+    m_mesh = std::make_unique<resource::Mesh>();
+    SG_OGL_CORE_ASSERT(m_mesh, "[ParticleBatch::Init()] Null pointer.");
+
+    // create BufferLayout
+    const buffer::BufferLayout bufferLayout{
+        { buffer::VertexAttributeType::POSITION_2D, "aPosition" },
+    };
+
+    // add Vbo
+    m_mesh->GetVao().AddVertexDataVbo(
+        resource::ModelManager::GetParticleVertices().data(),
+        static_cast<int32_t>(resource::ModelManager::GetParticleVertices().size()) / 2,
+        bufferLayout
+    );
+
+    // create an additional empty Vbo for instanced data
+    m_vboId = buffer::Vbo::GenerateVbo();
+
+    // init empty
+    m_vboSize = ParticleSystem::INITIAL_SIZE;
+    buffer::Vbo::InitEmpty(m_vboId, NUMBER_OF_FLOATS_PER_INSTANCE * m_vboSize, GL_STREAM_DRAW);
+
+    // add the empty Vbo to the Mesh
+    auto& vao{ m_mesh->GetVao() };
+    vao.BindVao();
+
+    // and set the layout
+    buffer::Vbo::AddInstancedAttribute(m_vboId, 1, 4, NUMBER_OF_FLOATS_PER_INSTANCE, 0);
+    buffer::Vbo::AddInstancedAttribute(m_vboId, 2, 3, NUMBER_OF_FLOATS_PER_INSTANCE, 4);
+
+    buffer::Vao::UnbindVao();
+}
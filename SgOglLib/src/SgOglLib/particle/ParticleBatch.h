@@ -0,0 +1,139 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ParticleBatch.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <glm/mat4x4.hpp>
+#include "DepthSorter.h"
+
+namespace sg::ogl::resource
+{
+    class Mesh;
+}
+
+namespace sg::ogl::particle
+{
+    class ParticleSystem;
+
+    /**
+     * @brief Collects the particles of all ParticleSystems with the same texture atlas
+     *        and blend mode into one instance stream, which is uploaded and drawn at once.
+     *        With alpha blending, the particles of all systems are sorted back-to-front together.
+     */
+    class ParticleBatch
+    {
+    public:
+        using InstancedDataContainer = std::vector<float>;
+        using MeshUniquePtr = std::unique_ptr<resource::Mesh>;
+
+        /**
+         * @brief Instanced data: position + scale, texture atlas index + blend factor + texture rows.
+         */
+        static constexpr uint32_t NUMBER_OF_FLOATS_PER_INSTANCE{ 7 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        ParticleBatch() = delete;
+
+        ParticleBatch(uint32_t t_textureId, bool t_alphaBlending);
+
+        ParticleBatch(const ParticleBatch& t_other) = delete;
+        ParticleBatch(ParticleBatch&& t_other) noexcept = delete;
+        ParticleBatch& operator=(const ParticleBatch& t_other) = delete;
+        ParticleBatch& operator=(ParticleBatch&& t_other) noexcept = delete;
+
+        ~ParticleBatch() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] uint32_t GetTextureId() const noexcept;
+        [[nodiscard]] bool IsAlphaBlending() const noexcept;
+        [[nodiscard]] uint32_t GetInstanceCount() const noexcept;
+
+        [[nodiscard]] const resource::Mesh& GetMesh() const noexcept;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * @brief Removes the particles of the last frame.
+         */
+        void Begin();
+
+        /**
+         * @brief Appends the living particles of a ParticleSystem.
+         * @param t_particleSystem A ParticleSystem with the same texture and blend mode.
+         * @param t_viewMatrix The view matrix of the current camera; used for sorting.
+         */
+        void Add(const ParticleSystem& t_particleSystem, const glm::mat4& t_viewMatrix);
+
+        /**
+         * @brief Sorts the particles if necessary and uploads the instance stream.
+         */
+        void End();
+
+    protected:
+
+    private:
+        uint32_t m_textureId{ 0 };
+        bool m_alphaBlending{ false };
+
+        uint32_t m_instanceCount{ 0 };
+
+        /**
+         * @brief Vbo Id of instanced data.
+         */
+        uint32_t m_vboId{ 0 };
+
+        /**
+         * @brief Number of instances the Vbo can hold.
+         */
+        uint32_t m_vboSize{ 0 };
+
+        /**
+         * @brief A Mesh for instanced rendering.
+         */
+        MeshUniquePtr m_mesh;
+
+        /**
+         * @brief The instanced data in the order of the systems.
+         */
+        InstancedDataContainer m_instancedData;
+
+        /**
+         * @brief The instanced data back-to-front (alpha blending only).
+         */
+        InstancedDataContainer m_sortedInstancedData;
+
+        /**
+         * @brief The view space z coordinate of each instance (alpha blending only).
+         */
+        std::vector<float> m_depths;
+
+        /**
+         * @brief The stable particle id of each instance (alpha blending only).
+         */
+        std::vector<uint64_t> m_ids;
+
+        DepthSorter m_depthSorter;
+
+        //-------------------------------------------------
+        // Init
+        //-------------------------------------------------
+
+        void Init();
+    };
+}
@@ -0,0 +1,155 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ParticleKernel.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <algorithm>
+#include <cmath>
+#include "ParticleKernel.h"
+#include "ParticleStore.h"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define SG_OGL_PARTICLE_KERNEL_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define SG_OGL_PARTICLE_KERNEL_SSE
+#endif
+
+//-------------------------------------------------
+// Update
+//-------------------------------------------------
+
+void sg::ogl::particle::ParticleKernel::Update(ParticleStore& t_store, const Params& t_params)
+{
+    // only the living particles; the store is padded to full registers
+    const auto size{ (t_store.aliveCount + ParticleStore::LANES - 1) / ParticleStore::LANES * ParticleStore::LANES };
+    uint32_t i{ 0 };
+
+#if defined(SG_OGL_PARTICLE_KERNEL_AVX)
+
+    const auto dt{ _mm256_set1_ps(t_params.dt) };
+    const auto gravity{ _mm256_set1_ps(t_params.gravity) };
+    const auto maxScale{ _mm256_set1_ps(t_params.maxScale) };
+    const auto nrTextures{ _mm256_set1_ps(t_params.nrTextures) };
+    const auto lastTexture{ _mm256_set1_ps(t_params.nrTextures - 1.0f) };
+
+    for (; i + 8 <= size; i += 8)
+    {
+        // the particle dies if there is no lifetime left
+        auto life{ _mm256_loadu_ps(&t_store.life[i]) };
+        const auto alive{ _mm256_cmp_ps(life, dt, _CMP_GT_OQ) };
+        const auto step{ _mm256_and_ps(alive, dt) };
+        life = _mm256_and_ps(alive, _mm256_sub_ps(life, dt));
+        _mm256_storeu_ps(&t_store.life[i], life);
+
+        // gravity
+        const auto vy{ _mm256_add_ps(_mm256_loadu_ps(&t_store.vy[i]), _mm256_mul_ps(gravity, step)) };
+        _mm256_storeu_ps(&t_store.vy[i], vy);
+
+        // integration
+        _mm256_storeu_ps(&t_store.px[i], _mm256_add_ps(_mm256_loadu_ps(&t_store.px[i]), _mm256_mul_ps(_mm256_loadu_ps(&t_store.vx[i]), step)));
+        _mm256_storeu_ps(&t_store.py[i], _mm256_add_ps(_mm256_loadu_ps(&t_store.py[i]), _mm256_mul_ps(vy, step)));
+        _mm256_storeu_ps(&t_store.pz[i], _mm256_add_ps(_mm256_loadu_ps(&t_store.pz[i]), _mm256_mul_ps(_mm256_loadu_ps(&t_store.vz[i]), step)));
+
+        // lerp scale
+        const auto factor{ _mm256_div_ps(life, _mm256_loadu_ps(&t_store.lifeTime[i])) };
+        _mm256_storeu_ps(&t_store.scale[i], _mm256_mul_ps(maxScale, factor));
+
+        // atlas progression
+        const auto progression{ _mm256_mul_ps(factor, nrTextures) };
+        const auto index{ _mm256_floor_ps(progression) };
+        _mm256_storeu_ps(&t_store.atlasIndex[i], _mm256_min_ps(index, lastTexture));
+        _mm256_storeu_ps(&t_store.blend[i], _mm256_sub_ps(progression, index));
+    }
+
+#elif defined(SG_OGL_PARTICLE_KERNEL_SSE)
+
+    const auto dt{ _mm_set1_ps(t_params.dt) };
+    const auto gravity{ _mm_set1_ps(t_params.gravity) };
+    const auto maxScale{ _mm_set1_ps(t_params.maxScale) };
+    const auto nrTextures{ _mm_set1_ps(t_params.nrTextures) };
+    const auto lastTexture{ _mm_set1_ps(t_params.nrTextures - 1.0f) };
+
+    for (; i + 4 <= size; i += 4)
+    {
+        // the particle dies if there is no lifetime left
+        auto life{ _mm_loadu_ps(&t_store.life[i]) };
+        const auto alive{ _mm_cmpgt_ps(life, dt) };
+        const auto step{ _mm_and_ps(alive, dt) };
+        life = _mm_and_ps(alive, _mm_sub_ps(life, dt));
+        _mm_storeu_ps(&t_store.life[i], life);
+
+        // gravity
+        const auto vy{ _mm_add_ps(_mm_loadu_ps(&t_store.vy[i]), _mm_mul_ps(gravity, step)) };
+        _mm_storeu_ps(&t_store.vy[i], vy);
+
+        // integration
+        _mm_storeu_ps(&t_store.px[i], _mm_add_ps(_mm_loadu_ps(&t_store.px[i]), _mm_mul_ps(_mm_loadu_ps(&t_store.vx[i]), step)));
+        _mm_storeu_ps(&t_store.py[i], _mm_add_ps(_mm_loadu_ps(&t_store.py[i]), _mm_mul_ps(vy, step)));
+        _mm_storeu_ps(&t_store.pz[i], _mm_add_ps(_mm_loadu_ps(&t_store.pz[i]), _mm_mul_ps(_mm_loadu_ps(&t_store.vz[i]), step)));
+
+        // lerp scale
+        const auto factor{ _mm_div_ps(life, _mm_loadu_ps(&t_store.lifeTime[i])) };
+        _mm_storeu_ps(&t_store.scale[i], _mm_mul_ps(maxScale, factor));
+
+        // atlas progression - the progression is never negative, so truncation is floor
+        const auto progression{ _mm_mul_ps(factor, nrTextures) };
+        const auto index{ _mm_cvtepi32_ps(_mm_cvttps_epi32(progression)) };
+        _mm_storeu_ps(&t_store.atlasIndex[i], _mm_min_ps(index, lastTexture));
+        _mm_storeu_ps(&t_store.blend[i], _mm_sub_ps(progression, index));
+    }
+
+#endif
+
+    UpdateScalar(t_store, t_params, i, size);
+}
+
+void sg::ogl::particle::ParticleKernel::UpdateScalar(ParticleStore& t_store, const Params& t_params, const uint32_t t_begin, const uint32_t t_end)
+{
+    const auto dt{ t_params.dt };
+
+    for (auto i{ t_begin }; i < t_end; ++i)
+    {
+        // the particle dies if there is no lifetime left
+        const auto alive{ t_store.life[i] > dt };
+        const auto step{ alive ? dt : 0.0f };
+        t_store.life[i] = alive ? t_store.life[i] - dt : 0.0f;
+
+        // gravity
+        t_store.vy[i] += t_params.gravity * step;
+
+        // integration
+        t_store.px[i] += t_store.vx[i] * step;
+        t_store.py[i] += t_store.vy[i] * step;
+        t_store.pz[i] += t_store.vz[i] * step;
+
+        // lerp scale
+        const auto factor{ t_store.life[i] / t_store.lifeTime[i] };
+        t_store.scale[i] = t_params.maxScale * factor;
+
+        // atlas progression
+        const auto progression{ factor * t_params.nrTextures };
+        const auto index{ std::floor(progression) };
+        t_store.atlasIndex[i] = std::min(index, t_params.nrTextures - 1.0f);
+        t_store.blend[i] = progression - index;
+    }
+}
+
+//-------------------------------------------------
+// Age
+//-------------------------------------------------
+
+void sg::ogl::particle::ParticleKernel::Age(ParticleStore& t_store, const float t_dt)
+{
+    // a single stream; the compiler vectorizes this loop
+    for (auto i{ 0u }; i < t_store.aliveCount; ++i)
+    {
+        const auto life{ t_store.life[i] - t_dt };
+        t_store.life[i] = life > 0.0f ? life : 0.0f;
+    }
+}
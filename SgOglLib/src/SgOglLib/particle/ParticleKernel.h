@@ -0,0 +1,78 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ParticleKernel.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <cstdint>
+
+namespace sg::ogl::particle
+{
+    struct ParticleStore;
+
+    /**
+     * @brief Updates the particles of a ParticleStore: gravity, integration, scale and atlas progression.
+     *        Uses AVX (8 particles) or SSE2 (4 particles) if available, otherwise a scalar loop.
+     *        The update is branch free: dead particles are masked out and keep a life value of 0.
+     */
+    class ParticleKernel
+    {
+    public:
+        struct Params
+        {
+            /**
+             * @brief The frame time.
+             */
+            float dt{ 0.0f };
+
+            /**
+             * @brief The gravity acceleration (GRAVITY * gravityEffect).
+             */
+            float gravity{ 0.0f };
+
+            /**
+             * @brief The scale of a particle at birth.
+             */
+            float maxScale{ 1.0f };
+
+            /**
+             * @brief The number of textures in the texture atlas.
+             */
+            float nrTextures{ 1.0f };
+        };
+
+        /**
+         * @brief Update the living particles of the given store.
+         * @param t_store The particles.
+         * @param t_params The per frame values.
+         */
+        static void Update(ParticleStore& t_store, const Params& t_params);
+
+        /**
+         * @brief The scalar version. Also handles the remaining slots.
+         * @param t_store The particles.
+         * @param t_params The per frame values.
+         * @param t_begin The first slot.
+         * @param t_end One past the last slot.
+         */
+        static void UpdateScalar(ParticleStore& t_store, const Params& t_params, uint32_t t_begin, uint32_t t_end);
+
+        /**
+         * @brief Only advances the lifetimes of the living particles. Used for ParticleSystems
+         *        outside of the view frustum, where position, scale and atlas values are not needed.
+         * @param t_store The particles.
+         * @param t_dt The frame time.
+         */
+        static void Age(ParticleStore& t_store, float t_dt);
+
+    protected:
+
+    private:
+
+    };
+}
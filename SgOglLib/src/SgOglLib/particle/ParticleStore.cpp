@@ -0,0 +1,110 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ParticleStore.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include "ParticleStore.h"
+#include "Core.h"
+
+//-------------------------------------------------
+// Id
+//-------------------------------------------------
+
+std::atomic<uint64_t> sg::ogl::particle::ParticleStore::s_nextId{ 0 };
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void sg::ogl::particle::ParticleStore::Resize(const uint32_t t_size)
+{
+    const auto size{ (t_size + LANES - 1) / LANES * LANES };
+
+    if (aliveCount > size)
+    {
+        aliveCount = size;
+    }
+
+    px.resize(size, 0.0f);
+    py.resize(size, 0.0f);
+    pz.resize(size, 0.0f);
+
+    vx.resize(size, 0.0f);
+    vy.resize(size, 0.0f);
+    vz.resize(size, 0.0f);
+
+    life.resize(size, 0.0f);
+    id.resize(size, 0);
+
+    // never 0, the kernel divides by this value
+    lifeTime.resize(size, 1.0f);
+
+    scale.resize(size, 0.0f);
+    atlasIndex.resize(size, 0.0f);
+    blend.resize(size, 0.0f);
+}
+
+uint32_t sg::ogl::particle::ParticleStore::Add()
+{
+    SG_OGL_CORE_ASSERT(!IsFull(), "[ParticleStore::Add()] No free slot.");
+
+    id[aliveCount] = s_nextId.fetch_add(1, std::memory_order_relaxed);
+
+    return aliveCount++;
+}
+
+void sg::ogl::particle::ParticleStore::RemoveDead()
+{
+    auto i{ 0u };
+    while (i < aliveCount)
+    {
+        if (life[i] > 0.0f)
+        {
+            ++i;
+            continue;
+        }
+
+        // fill the gap with the last living particle and check the same slot again
+        --aliveCount;
+        Move(aliveCount, i);
+        life[aliveCount] = 0.0f;
+    }
+}
+
+uint32_t sg::ogl::particle::ParticleStore::Size() const noexcept
+{
+    return static_cast<uint32_t>(life.size());
+}
+
+bool sg::ogl::particle::ParticleStore::IsAlive(const uint32_t t_index) const
+{
+    return life[t_index] > 0.0f;
+}
+
+bool sg::ogl::particle::ParticleStore::IsFull() const noexcept
+{
+    return aliveCount >= Size();
+}
+
+void sg::ogl::particle::ParticleStore::Move(const uint32_t t_from, const uint32_t t_to)
+{
+    px[t_to] = px[t_from];
+    py[t_to] = py[t_from];
+    pz[t_to] = pz[t_from];
+
+    vx[t_to] = vx[t_from];
+    vy[t_to] = vy[t_from];
+    vz[t_to] = vz[t_from];
+
+    life[t_to] = life[t_from];
+    lifeTime[t_to] = lifeTime[t_from];
+    id[t_to] = id[t_from];
+
+    scale[t_to] = scale[t_from];
+    atlasIndex[t_to] = atlasIndex[t_from];
+    blend[t_to] = blend[t_from];
+}
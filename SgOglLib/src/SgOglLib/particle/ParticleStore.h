@@ -0,0 +1,130 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ParticleStore.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+namespace sg::ogl::particle
+{
+    /**
+     * @brief Structure-of-arrays storage for the particles of a ParticleSystem.
+     *        The hot fields (position, velocity, life) are kept in separate float arrays,
+     *        so that the ParticleKernel can process several particles at once.
+     *        The living particles are always in the range [0, aliveCount).
+     *        A particle dies when its life value drops to zero; dead particles are
+     *        swap-removed by RemoveDead().
+     */
+    struct ParticleStore
+    {
+        using FloatContainer = std::vector<float>;
+
+        /**
+         * @brief The size of the arrays is always a multiple of this value (one AVX register).
+         */
+        static constexpr uint32_t LANES{ 8 };
+
+        /**
+         * @brief The number of living particles.
+         */
+        uint32_t aliveCount{ 0 };
+
+        //-------------------------------------------------
+        // Position / Velocity
+        //-------------------------------------------------
+
+        FloatContainer px;
+        FloatContainer py;
+        FloatContainer pz;
+
+        FloatContainer vx;
+        FloatContainer vy;
+        FloatContainer vz;
+
+        //-------------------------------------------------
+        // Life
+        //-------------------------------------------------
+
+        /**
+         * @brief The rest of the life. A value <= 0 means the slot is free.
+         */
+        FloatContainer life;
+
+        /**
+         * @brief Specifies how long the particle should stay alive.
+         */
+        FloatContainer lifeTime;
+
+        /**
+         * @brief A stable id of each particle. It moves with the particle when the slots are
+         *        compacted and is unique over all ParticleStores, so that the DepthSorter can
+         *        find the particles of the last frame again.
+         */
+        std::vector<uint64_t> id;
+
+        //-------------------------------------------------
+        // Written by the kernel
+        //-------------------------------------------------
+
+        /**
+         * @brief The size of the particle.
+         */
+        FloatContainer scale;
+
+        /**
+         * @brief The current texture stage in the texture atlas (stored as float).
+         */
+        FloatContainer atlasIndex;
+
+        /**
+         * @brief The blend factor between the current and the next texture stage.
+         */
+        FloatContainer blend;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * @brief Resize all arrays. The new size is rounded up to a multiple of LANES.
+         *        New slots are free.
+         * @param t_size The min number of slots.
+         */
+        void Resize(uint32_t t_size);
+
+        /**
+         * @brief Appends a new particle slot behind the living particles.
+         *        The caller has to make sure that there is a free slot.
+         * @return The index of the new slot.
+         */
+        uint32_t Add();
+
+        /**
+         * @brief Moves the last living particle into each dead slot, so that the
+         *        living particles stay contiguous. The order is not preserved.
+         */
+        void RemoveDead();
+
+        [[nodiscard]] uint32_t Size() const noexcept;
+        [[nodiscard]] bool IsAlive(uint32_t t_index) const;
+        [[nodiscard]] bool IsFull() const noexcept;
+
+    protected:
+
+    private:
+        /**
+         * @brief The id of the next new particle.
+         */
+        static std::atomic<uint64_t> s_nextId;
+
+        void Move(uint32_t t_from, uint32_t t_to);
+    };
+}
@@ -7,17 +7,20 @@
 // 
 // 2020 (c) stwe <https://github.com/stwe/SgOgl>
 
+#include <algorithm>
 #include <glm/glm.hpp>
-#include <glm/gtx/compatibility.hpp>
 #include "ParticleSystem.h"
+#include "ParticleKernel.h"
+#include "OpenGl.h"
 #include "Random.h"
 #include "Core.h"
+#include "Application.h"
 #include "scene/Scene.h"
 #include "camera/Camera.h"
-#include "buffer/Vao.h"
-#include "buffer/Vbo.h"
-#include "resource/Mesh.h"
-#include "resource/ModelManager.h"
+#include "terrain/TerrainConfig.h"
+#include "resource/ShaderManager.h"
+#include "resource/shaderprogram/ComputeParticleEmit.h"
+#include "resource/shaderprogram/ComputeParticleSimulate.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -75,14 +78,101 @@ int sg::ogl::particle::ParticleSystem::GetTextureRows() const
     return m_textureRows;
 }
 
-const sg::ogl::resource::Mesh& sg::ogl::particle::ParticleSystem::GetMesh() const noexcept
+const sg::ogl::particle::ParticleStore& sg::ogl::particle::ParticleSystem::GetStore() const noexcept
 {
-    return *m_mesh;
+    return m_store;
 }
 
-sg::ogl::resource::Mesh& sg::ogl::particle::ParticleSystem::GetMesh() noexcept
+uint32_t sg::ogl::particle::ParticleSystem::GetCapacity() const noexcept
 {
-    return *m_mesh;
+    return m_capacity;
+}
+
+uint32_t sg::ogl::particle::ParticleSystem::GetAliveCount() const noexcept
+{
+    return m_store.aliveCount;
+}
+
+float sg::ogl::particle::ParticleSystem::GetSpeed() const noexcept
+{
+    return m_speed;
+}
+
+float sg::ogl::particle::ParticleSystem::GetGravityEffect() const noexcept
+{
+    return m_gravityEffect;
+}
+
+float sg::ogl::particle::ParticleSystem::GetLifeTime() const noexcept
+{
+    return m_lifeTime;
+}
+
+float sg::ogl::particle::ParticleSystem::GetMaxScale() const noexcept
+{
+    return m_maxScale;
+}
+
+const sg::ogl::particle::GpuParticleStore& sg::ogl::particle::ParticleSystem::GetGpuStore() const noexcept
+{
+    SG_OGL_CORE_ASSERT(m_gpuStore, "[ParticleSystem::GetGpuStore()] Null pointer.");
+
+    return *m_gpuStore;
+}
+
+bool sg::ogl::particle::ParticleSystem::IsVisible() const noexcept
+{
+    return m_visible;
+}
+
+float sg::ogl::particle::ParticleSystem::GetLodFactor() const noexcept
+{
+    return m_lodFactor;
+}
+
+uint32_t sg::ogl::particle::ParticleSystem::GetLodCapacity() const noexcept
+{
+    return m_lodCapacity;
+}
+
+uint32_t sg::ogl::particle::ParticleSystem::GetEstimatedAliveCount() const noexcept
+{
+    if (gpu)
+    {
+        // emission rate * lifetime is the number of particles in the steady state
+        const auto steadyState{ static_cast<uint32_t>(m_particlesPerSecond * m_lodFactor * m_lifeTime) };
+        return std::min(steadyState, m_lodCapacity);
+    }
+
+    return m_store.aliveCount;
+}
+
+float sg::ogl::particle::ParticleSystem::GetBoundingRadius() const noexcept
+{
+    // the max distance a particle can travel in its lifetime + the size of the quad
+    const auto gravity{ std::abs(GRAVITY * m_gravityEffect) };
+
+    return m_speed * m_lifeTime + 0.5f * gravity * m_lifeTime * m_lifeTime + m_maxScale;
+}
+
+sg::ogl::particle::Particle sg::ogl::particle::ParticleSystem::GetParticle(const uint32_t t_index) const
+{
+    SG_OGL_CORE_ASSERT(t_index < m_store.aliveCount, "[ParticleSystem::GetParticle()] Invalid index.");
+
+    Particle particle;
+
+    particle.position = glm::vec3(m_store.px[t_index], m_store.py[t_index], m_store.pz[t_index]);
+    particle.velocity = glm::vec3(m_store.vx[t_index], m_store.vy[t_index], m_store.vz[t_index]);
+    particle.gravityEffect = m_gravityEffect;
+    particle.lifeTime = m_store.lifeTime[t_index];
+    particle.scale = m_store.scale[t_index];
+    particle.lifeRemaining = m_store.life[t_index];
+    particle.active = m_store.IsAlive(t_index);
+    particle.currentTextureIndex = static_cast<int>(m_store.atlasIndex[t_index]);
+    particle.nextTextureIndex = particle.currentTextureIndex < m_nrTextures - 1 ? particle.currentTextureIndex + 1 : particle.currentTextureIndex;
+    particle.blendFactor = m_store.blend[t_index];
+
+    return particle;
 }
 
 //-------------------------------------------------
@@ -114,147 +204,141 @@ void sg::ogl::particle::ParticleSystem::SetMaxScale(const float t_maxScale)
     m_maxScale = t_maxScale;
 }
 
+void sg::ogl::particle::ParticleSystem::SetCapacity(const uint32_t t_capacity)
+{
+    SG_OGL_CORE_ASSERT(t_capacity, "[ParticleSystem::SetCapacity()] Invalid value.");
+
+    m_capacity = t_capacity;
+    m_lodCapacity = std::min(m_lodCapacity, m_capacity);
+
+    // kill the particles beyond the new capacity
+    while (m_store.aliveCount > m_capacity)
+    {
+        m_store.life[--m_store.aliveCount] = 0.0f;
+    }
+
+    // the living GPU particles are copied into the new buffers
+    if (m_gpuStore)
+    {
+        m_gpuStore->Resize(m_capacity);
+    }
+}
+
+void sg::ogl::particle::ParticleSystem::SetLodDistances(const float t_near, const float t_far)
+{
+    SG_OGL_CORE_ASSERT(t_near >= 0.0f && t_far > t_near, "[ParticleSystem::SetLodDistances()] Invalid value.");
+
+    m_lodNear = t_near;
+    m_lodFar = t_far;
+}
+
+void sg::ogl::particle::ParticleSystem::SetMinScreenSize(const float t_minScreenSize)
+{
+    SG_OGL_CORE_ASSERT(t_minScreenSize > 0.0f, "[ParticleSystem::SetMinScreenSize()] Invalid value.");
+
+    m_minScreenSize = t_minScreenSize;
+}
+
 //-------------------------------------------------
 // Logic
 //-------------------------------------------------
 
 void sg::ogl::particle::ParticleSystem::GenerateParticles(const double t_dt, const glm::vec3& t_systemCenter)
 {
+    UpdateLod(t_systemCenter);
+
+    // outside of the view frustum or too small: the living particles only age
+    if (!m_visible || m_lodFactor <= 0.0f)
+    {
+        return;
+    }
+
     const auto dt{ static_cast<float>(t_dt) };
-    const auto particlesToCreate{ m_particlesPerSecond * dt };
+    const auto particlesToCreate{ m_particlesPerSecond * m_lodFactor * dt };
     const auto count{ static_cast<int>(floorf(particlesToCreate)) };
     const auto partialParticle{ fmod(particlesToCreate, 1.0f) };
+    const auto partialCount{ Random::Float() < partialParticle ? 1 : 0 };
+
+    // the engine-wide cap
+    const auto total{ m_scene->RequestParticles(static_cast<uint32_t>(count + partialCount)) };
 
-    for (auto i{ 0 }; i < count; ++i)
+    if (gpu)
     {
-        Emit(t_systemCenter);
+        // the compute shader drops the particles beyond the capacity; that number is unknown here
+        EmitGpu(total, t_systemCenter);
+        m_scene->ConsumeParticles(total);
+        return;
     }
 
-    if (Random::Float() < partialParticle)
+    auto emitted{ 0u };
+    while (emitted < total && Emit(t_systemCenter))
     {
-        Emit(t_systemCenter);
+        ++emitted;
     }
+
+    // the dropped particles stay in the budget for the other systems
+    m_scene->ConsumeParticles(emitted);
 }
 
 void sg::ogl::particle::ParticleSystem::Update(const double t_dt)
 {
-    const auto dt{ static_cast<float>(t_dt) };
-
-    for (auto& particle : particles)
+    if (gpu)
     {
-        // skip inactive particles
-        if (!particle.active)
-        {
-            continue;
-        }
-
-        // if there is no lifetime left, set the particle to inactive
-        if (particle.lifeRemaining <= t_dt)
-        {
-            particle.active = false;
-            continue;
-        }
-
-        // update particle
-        particle.lifeRemaining -= dt;
-        particle.velocity.y += GRAVITY * particle.gravityEffect * dt;
-        particle.position += particle.velocity * dt;
+        UpdateGpu(static_cast<float>(t_dt));
+        return;
+    }
 
-        const auto life{ particle.lifeRemaining / particle.lifeTime };
+    // nobody sees the particles; positions, scales and atlas values are not needed
+    if (!m_visible)
+    {
+        ParticleKernel::Age(m_store, static_cast<float>(t_dt));
+        m_store.RemoveDead();
 
-        SG_OGL_CORE_ASSERT(life >= 0.0f && life <= 1.0f, "[ParticleEmitter::ParticleSystem::Update()] Invalid value:." + std::to_string(life));
+        return;
+    }
 
-        particle.scale = glm::lerp(0.0f, m_maxScale, life);
+    ParticleKernel::Params params;
+    params.dt = static_cast<float>(t_dt);
+    params.gravity = GRAVITY * m_gravityEffect;
+    params.maxScale = m_maxScale;
+    params.nrTextures = static_cast<float>(m_nrTextures);
 
-        const auto atlasProgression{ life * static_cast<float>(m_nrTextures) };
+    ParticleKernel::Update(m_store, params);
 
-        particle.currentTextureIndex = static_cast<int>(floor(atlasProgression));
-        particle.nextTextureIndex = particle.currentTextureIndex < m_nrTextures - 1 ? particle.currentTextureIndex + 1 : particle.currentTextureIndex;
-        particle.blendFactor = fmod(atlasProgression, 1.0f);
+    if (terrainCollision != TerrainCollision::NONE)
+    {
+        CollideWithTerrain();
     }
+
+    // keep the living particles contiguous
+    m_store.RemoveDead();
 }
 
-void sg::ogl::particle::ParticleSystem::Render()
+void sg::ogl::particle::ParticleSystem::RenderGpu() const
 {
-    // if no instancing is used, there is nothing to do here
-    if (!instancing)
+    if (!m_gpuStore)
     {
         return;
     }
 
-    // get view matrix
-    const auto viewMatrix{ m_scene->GetCurrentCamera().GetViewMatrix() };
+    // make the results of the compute shaders visible to the indirect draw and the vertex shader
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
 
-    // init counter
-    auto counter{ 0 };
+    m_gpuStore->Draw();
+}
 
-    // set instanced data
-    for (const auto& particle : particles)
-    {
-        // skip inactive particles
-        if (!particle.active)
-        {
-            continue;
-        }
+const sg::ogl::particle::DepthSorter::IndexContainer& sg::ogl::particle::ParticleSystem::SortByDepth()
+{
+    const auto viewMatrix{ m_scene->GetCurrentCamera().GetViewMatrix() };
 
-        // create model matrix
-        auto modelMatrix = translate(glm::mat4(1.0f), particle.position);
-        modelMatrix[0][0] = viewMatrix[0][0];
-        modelMatrix[0][1] = viewMatrix[1][0];
-        modelMatrix[0][2] = viewMatrix[2][0];
-        modelMatrix[1][0] = viewMatrix[0][1];
-        modelMatrix[1][1] = viewMatrix[1][1];
-        modelMatrix[1][2] = viewMatrix[2][1];
-        modelMatrix[2][0] = viewMatrix[0][2];
-        modelMatrix[2][1] = viewMatrix[1][2];
-        modelMatrix[2][2] = viewMatrix[2][2];
-
-        //rotate(modelMatrix, glm::radians(particle.rotation), glm::vec3(0.0f, 0.0f, 1.0f));
-        modelMatrix = scale(modelMatrix, glm::vec3(particle.scale));
-
-        // create modelView matrix
-        const auto matrix{ viewMatrix * modelMatrix };
-
-        // fill buffer - modelView matrix
-        m_instancedData[counter++] = matrix[0][0];
-        m_instancedData[counter++] = matrix[0][1];
-        m_instancedData[counter++] = matrix[0][2];
-        m_instancedData[counter++] = matrix[0][3];
-
-        m_instancedData[counter++] = matrix[1][0];
-        m_instancedData[counter++] = matrix[1][1];
-        m_instancedData[counter++] = matrix[1][2];
-        m_instancedData[counter++] = matrix[1][3];
-
-        m_instancedData[counter++] = matrix[2][0];
-        m_instancedData[counter++] = matrix[2][1];
-        m_instancedData[counter++] = matrix[2][2];
-        m_instancedData[counter++] = matrix[2][3];
-
-        m_instancedData[counter++] = matrix[3][0];
-        m_instancedData[counter++] = matrix[3][1];
-        m_instancedData[counter++] = matrix[3][2];
-        m_instancedData[counter++] = matrix[3][3];
-
-        // fill buffer - texture offsets
-        m_instancedData[counter++] = GetTextureOffset(particle.currentTextureIndex).x;
-        m_instancedData[counter++] = GetTextureOffset(particle.currentTextureIndex).y;
-        m_instancedData[counter++] = GetTextureOffset(particle.nextTextureIndex).x;
-        m_instancedData[counter++] = GetTextureOffset(particle.nextTextureIndex).y;
-
-        // fill buffer - blend factor
-        m_instancedData[counter++] = particle.blendFactor;
+    // view space z; the smallest value is the farthest particle
+    m_depths.resize(m_store.aliveCount);
+    for (auto i{ 0u }; i < m_store.aliveCount; ++i)
+    {
+        m_depths[i] = viewMatrix[0][2] * m_store.px[i] + viewMatrix[1][2] * m_store.py[i] + viewMatrix[2][2] * m_store.pz[i] + viewMatrix[3][2];
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vboId);
-    glBufferData(GL_ARRAY_BUFFER, NUMBER_OF_FLOATS_PER_INSTANCE * particles.size() * sizeof(float), nullptr, GL_STREAM_DRAW);
-
-    glBufferSubData(
-        GL_ARRAY_BUFFER,
-        0,
-        NUMBER_OF_FLOATS_PER_INSTANCE * particles.size() * sizeof(float),
-        &m_instancedData[0]
-    );
+    return m_depthSorter.Sort(m_depths.data(), m_store.id.data(), m_store.aliveCount);
 }
 
 //-------------------------------------------------
@@ -276,76 +360,199 @@ glm::vec2 sg::ogl::particle::ParticleSystem::GetTextureOffset(const int t_textur
 
 void sg::ogl::particle::ParticleSystem::Init()
 {
-    particles.resize(NR_OF_ELEMENTS);
+    m_store.Resize(std::min(INITIAL_SIZE, m_capacity));
     m_nrTextures = m_textureRows * m_textureRows;
+    m_lodCapacity = m_capacity;
+}
 
-    // the following is only required for instancing ...
+//-------------------------------------------------
+// Lod
+//-------------------------------------------------
 
-    // set the size of container for the instanced data
-    m_instancedData.resize(particles.size() * NUMBER_OF_FLOATS_PER_INSTANCE);
+void sg::ogl::particle::ParticleSystem::UpdateLod(const glm::vec3& t_systemCenter)
+{
+    const auto& camera{ m_scene->GetCurrentCamera() };
+    const auto radius{ GetBoundingRadius() };
 
-    // create Mesh
-    m_mesh = std::make_unique<resource::Mesh>();
-    SG_OGL_CORE_ASSERT(m_mesh, "[ParticleSystem::Init()] Null pointer.");
+    m_visible = camera.IsSphereInFrustum(t_systemCenter, radius);
+    if (!m_visible)
+    {
+        m_lodFactor = 0.0f;
+        return;
+    }
+
+    const auto distance{ std::max(length(t_systemCenter - camera.GetPosition()), 0.001f) };
+
+    // fade out between the near and the far distance
+    const auto distanceFactor{ 1.0f - std::clamp((distance - m_lodNear) / (m_lodFar - m_lodNear), 0.0f, 1.0f) };
+
+    // the projected diameter as fraction of the screen height; fade out between twice and once the min size
+    const auto& projectionOptions{ m_scene->GetApplicationContext()->GetProjectionOptions() };
+    const auto screenSize{ radius / (distance * glm::tan(glm::radians(projectionOptions.fovDeg * 0.5f))) };
+    const auto screenFactor{ std::clamp(screenSize / m_minScreenSize - 1.0f, 0.0f, 1.0f) };
+
+    m_lodFactor = distanceFactor * screenFactor;
+    m_lodCapacity = static_cast<uint32_t>(std::ceil(static_cast<float>(m_capacity) * m_lodFactor));
+}
 
-    // create BufferLayout
-    const buffer::BufferLayout bufferLayout{
-        { buffer::VertexAttributeType::POSITION_2D, "aPosition" },
-    };
+//-------------------------------------------------
+// Collision
+//-------------------------------------------------
 
-    // add Vbo
-    m_mesh->GetVao().AddVertexDataVbo(
-        resource::ModelManager::GetParticleVertices().data(),
-        static_cast<int32_t>(resource::ModelManager::GetParticleVertices().size()) / 2,
-        bufferLayout
-    );
+void sg::ogl::particle::ParticleSystem::CollideWithTerrain()
+{
+    const auto& terrainConfig{ m_scene->terrainConfig };
+    if (!terrainConfig || !terrainConfig->HasHeights() || m_store.aliveCount == 0)
+    {
+        return;
+    }
 
-    // create an additional empty Vbo for instanced data
-    m_vboId = buffer::Vbo::GenerateVbo();
+    // one batched query for all living particles
+    m_terrainHeights.resize(m_store.aliveCount);
+    terrainConfig->GetHeightsAt(m_store.px.data(), m_store.pz.data(), m_terrainHeights.data(), m_store.aliveCount);
 
-    // init empty
-    const auto floatCount{ NUMBER_OF_FLOATS_PER_INSTANCE * NR_OF_ELEMENTS };
-    buffer::Vbo::InitEmpty(m_vboId, floatCount, GL_STREAM_DRAW);
+    const auto kill{ terrainCollision == TerrainCollision::KILL };
 
-    // add the empty Vbo to the Mesh
-    auto& vao{ m_mesh->GetVao() };
-    vao.BindVao();
+    for (auto i{ 0u }; i < m_store.aliveCount; ++i)
+    {
+        if (m_store.py[i] >= m_terrainHeights[i])
+        {
+            continue;
+        }
 
-    // and set the layout
-    buffer::Vbo::AddInstancedAttribute(m_vboId, 1, 4, NUMBER_OF_FLOATS_PER_INSTANCE, 0);
-    buffer::Vbo::AddInstancedAttribute(m_vboId, 2, 4, NUMBER_OF_FLOATS_PER_INSTANCE, 4);
-    buffer::Vbo::AddInstancedAttribute(m_vboId, 3, 4, NUMBER_OF_FLOATS_PER_INSTANCE, 8);
-    buffer::Vbo::AddInstancedAttribute(m_vboId, 4, 4, NUMBER_OF_FLOATS_PER_INSTANCE, 12);
-    buffer::Vbo::AddInstancedAttribute(m_vboId, 5, 4, NUMBER_OF_FLOATS_PER_INSTANCE, 16);
-    buffer::Vbo::AddInstancedAttribute(m_vboId, 6, 4, NUMBER_OF_FLOATS_PER_INSTANCE, 20);
+        if (kill)
+        {
+            m_store.life[i] = 0.0f;
+            continue;
+        }
 
-    buffer::Vao::UnbindVao();
+        // back to the surface; only a falling particle is reflected
+        m_store.py[i] = m_terrainHeights[i];
+        if (m_store.vy[i] < 0.0f)
+        {
+            m_store.vy[i] = -m_store.vy[i] * restitution;
+        }
+    }
+}
+
+//-------------------------------------------------
+// Pool
+//-------------------------------------------------
+
+void sg::ogl::particle::ParticleSystem::Grow()
+{
+    const auto size{ std::min(std::max(m_store.Size() * 2, INITIAL_SIZE), m_capacity) };
+    if (size <= m_store.Size())
+    {
+        return;
+    }
+
+    m_store.Resize(size);
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[ParticleSystem::Grow()] Resize the ParticleStore to {} slots.", m_store.Size());
 }
 
 //-------------------------------------------------
 // Emit
 //-------------------------------------------------
 
-void sg::ogl::particle::ParticleSystem::Emit(const glm::vec3& t_systemCenter)
+bool sg::ogl::particle::ParticleSystem::Emit(const glm::vec3& t_systemCenter)
 {
-    auto& particle{ particles[m_containerIndex] };
+    // drop the particle if the capacity of the current level of detail is reached
+    if (m_store.aliveCount >= m_lodCapacity)
+    {
+        return false;
+    }
+
+    if (m_store.IsFull())
+    {
+        Grow();
+    }
+
+    const auto i{ m_store.Add() };
 
-    particle.position = t_systemCenter;
+    m_store.px[i] = t_systemCenter.x;
+    m_store.py[i] = t_systemCenter.y;
+    m_store.pz[i] = t_systemCenter.z;
 
     const auto dirX{ Random::Float() * 2.0f - 1.0f };
     const auto dirZ{ Random::Float() * 2.0f - 1.0f };
 
-    particle.velocity = glm::vec3(dirX, 1.0f, dirZ);
-    particle.velocity = normalize(particle.velocity);
-    particle.velocity *= m_speed;
+    const auto velocity{ normalize(glm::vec3(dirX, 1.0f, dirZ)) * m_speed };
 
-    particle.gravityEffect = m_gravityEffect;
-    particle.lifeTime = m_lifeTime;
-    particle.rotation = 0.0f;
-    particle.scale = m_maxScale;
+    m_store.vx[i] = velocity.x;
+    m_store.vy[i] = velocity.y;
+    m_store.vz[i] = velocity.z;
+
+    m_store.lifeTime[i] = m_lifeTime;
+    m_store.life[i] = m_lifeTime;
+    m_store.scale[i] = m_maxScale;
+    m_store.atlasIndex[i] = 0.0f;
+    m_store.blend[i] = 0.0f;
+
+    return true;
+}
+
+//-------------------------------------------------
+// Gpu
+//-------------------------------------------------
+
+void sg::ogl::particle::ParticleSystem::InitGpu()
+{
+    Log::SG_OGL_CORE_LOG_DEBUG("[ParticleSystem::InitGpu()] Create GPU buffers for {} particles.", m_capacity);
+
+    m_gpuStore = std::make_unique<GpuParticleStore>(m_capacity);
+
+    auto& shaderManager{ m_scene->GetApplicationContext()->GetShaderManager() };
+    shaderManager.AddComputeShaderProgram<resource::shaderprogram::ComputeParticleEmit>();
+    shaderManager.AddComputeShaderProgram<resource::shaderprogram::ComputeParticleSimulate>();
+}
+
+void sg::ogl::particle::ParticleSystem::EmitGpu(const uint32_t t_count, const glm::vec3& t_systemCenter)
+{
+    if (t_count == 0)
+    {
+        return;
+    }
+
+    if (!m_gpuStore)
+    {
+        InitGpu();
+    }
+
+    m_gpuStore->SetEmission(t_count, t_systemCenter, static_cast<uint32_t>(Random::Int()));
+
+    auto& shaderProgram{ m_scene->GetApplicationContext()->GetShaderManager().GetComputeShaderProgram<resource::shaderprogram::ComputeParticleEmit>() };
+    shaderProgram.Bind();
+    shaderProgram.UpdateUniforms(*this);
+
+    m_gpuStore->BeginEmission();
+    glDispatchCompute((t_count + GpuParticleStore::WORK_GROUP_SIZE - 1) / GpuParticleStore::WORK_GROUP_SIZE, 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    resource::ShaderProgram::Unbind();
+}
+
+void sg::ogl::particle::ParticleSystem::UpdateGpu(const float t_dt)
+{
+    if (!m_gpuStore)
+    {
+        InitGpu();
+    }
+
+    m_gpuStore->SetTimeStep(t_dt);
+
+    // writes of the last emission must be finished before the counter is reset
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    auto& shaderProgram{ m_scene->GetApplicationContext()->GetShaderManager().GetComputeShaderProgram<resource::shaderprogram::ComputeParticleSimulate>() };
+    shaderProgram.Bind();
+    shaderProgram.UpdateUniforms(*this);
 
-    particle.lifeRemaining = particle.lifeTime;
-    particle.active = true;
+    m_gpuStore->BeginSimulation();
+    glDispatchCompute(m_gpuStore->GetNumberOfWorkGroups(), 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    m_gpuStore->EndSimulation();
 
-    m_containerIndex = --m_containerIndex % particles.size();
+    resource::ShaderProgram::Unbind();
 }
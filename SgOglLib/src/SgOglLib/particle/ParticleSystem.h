@@ -12,11 +12,9 @@
 #include <vector>
 #include <memory>
 #include "Particle.h"
-
-namespace sg::ogl::resource
-{
-    class Mesh;
-}
+#include "ParticleStore.h"
+#include "GpuParticleStore.h"
+#include "DepthSorter.h"
 
 namespace sg::ogl::scene
 {
@@ -25,28 +23,76 @@ namespace sg::ogl::scene
 
 namespace sg::ogl::particle
 {
+    /**
+     * @brief What happens to a particle that falls below the terrain.
+     */
+    enum class TerrainCollision
+    {
+        NONE,
+        BOUNCE,
+        KILL
+    };
+
     class ParticleSystem
     {
     public:
-        using ParticleContainer = std::vector<Particle>;
-        using InstancedDataContainer = std::vector<float>;
-        using MeshUniquePtr = std::unique_ptr<resource::Mesh>;
+        using GpuParticleStoreUniquePtr = std::unique_ptr<GpuParticleStore>;
 
         /**
-         * @brief Number of elements in the particles vector.
+         * @brief The default max number of living particles.
          */
-        static constexpr uint32_t NR_OF_ELEMENTS{ 1000 };
+        static constexpr uint32_t DEFAULT_CAPACITY{ 1000 };
+
+        /**
+         * @brief The ParticleStore starts with this number of slots and grows on demand.
+         */
+        static constexpr uint32_t INITIAL_SIZE{ 64 };
 
         static constexpr auto GRAVITY{ -9.81f };
-        static constexpr auto NUMBER_OF_FLOATS_PER_INSTANCE{ 21 };
+
+        /**
+         * @brief Up to this camera distance, the ParticleSystem is emitted with full rate and capacity.
+         */
+        static constexpr auto DEFAULT_LOD_NEAR{ 50.0f };
+
+        /**
+         * @brief From this camera distance on, no more particles are emitted.
+         */
+        static constexpr auto DEFAULT_LOD_FAR{ 500.0f };
+
+        /**
+         * @brief Below this screen size (fraction of the screen height), no more particles are emitted.
+         */
+        static constexpr auto DEFAULT_MIN_SCREEN_SIZE{ 0.01f };
 
         //-------------------------------------------------
         // Public member
         //-------------------------------------------------
 
-        ParticleContainer particles;
         bool instancing{ true };
 
+        /**
+         * @brief Emit, simulate and draw the particles on the GPU with compute shaders.
+         *        The particles never leave the GPU.
+         */
+        bool gpu{ false };
+
+        /**
+         * @brief Render with alpha blending instead of additive blending.
+         *        The particles are then sorted back-to-front (not in the GPU path).
+         */
+        bool alphaBlending{ false };
+
+        /**
+         * @brief Collide the particles with the terrain of the Scene (not in the GPU path).
+         */
+        TerrainCollision terrainCollision{ TerrainCollision::NONE };
+
+        /**
+         * @brief The part of the vertical velocity which is kept on a bounce.
+         */
+        float restitution{ 0.5f };
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -71,8 +117,50 @@ namespace sg::ogl::particle
         [[nodiscard]] uint32_t GetTextureId() const;
         [[nodiscard]] int GetTextureRows() const;
 
-        [[nodiscard]] const resource::Mesh& GetMesh() const noexcept;
-        [[nodiscard]] resource::Mesh& GetMesh() noexcept;
+        [[nodiscard]] const ParticleStore& GetStore() const noexcept;
+        [[nodiscard]] uint32_t GetCapacity() const noexcept;
+        [[nodiscard]] uint32_t GetAliveCount() const noexcept;
+
+        [[nodiscard]] float GetSpeed() const noexcept;
+        [[nodiscard]] float GetGravityEffect() const noexcept;
+        [[nodiscard]] float GetLifeTime() const noexcept;
+        [[nodiscard]] float GetMaxScale() const noexcept;
+
+        [[nodiscard]] const GpuParticleStore& GetGpuStore() const noexcept;
+
+        /**
+         * @brief Indicates whether the bounding sphere of the ParticleSystem was inside
+         *        the view frustum at the last call of GenerateParticles().
+         */
+        [[nodiscard]] bool IsVisible() const noexcept;
+
+        /**
+         * @brief The emission rate and the capacity are scaled by this value [0, 1].
+         */
+        [[nodiscard]] float GetLodFactor() const noexcept;
+
+        /**
+         * @brief The max number of living particles at the current level of detail.
+         */
+        [[nodiscard]] uint32_t GetLodCapacity() const noexcept;
+
+        /**
+         * @brief The number of living particles. In the GPU path, this value is unknown on the CPU
+         *        and is estimated from emission rate and lifetime.
+         */
+        [[nodiscard]] uint32_t GetEstimatedAliveCount() const noexcept;
+
+        /**
+         * @brief The radius of a sphere around the emitter center, which contains all particles.
+         */
+        [[nodiscard]] float GetBoundingRadius() const noexcept;
+
+        /**
+         * @brief Gathers a single particle from the ParticleStore.
+         * @param t_index The slot in the ParticleStore.
+         * @return A copy of the particle.
+         */
+        [[nodiscard]] Particle GetParticle(uint32_t t_index) const;
 
         //-------------------------------------------------
         // Setter
@@ -84,6 +172,27 @@ namespace sg::ogl::particle
         void SetLifeTime(float t_lifeTime);
         void SetMaxScale(float t_maxScale);
 
+        /**
+         * @brief Set the max number of living particles. New particles are dropped
+         *        when the capacity is reached. If the capacity shrinks, the living
+         *        particles beyond it are dropped on both the CPU and the GPU path.
+         * @param t_capacity The max number of living particles.
+         */
+        void SetCapacity(uint32_t t_capacity);
+
+        /**
+         * @brief Set the camera distances in which the emission rate and capacity are faded out.
+         * @param t_near Up to this distance the full rate and capacity is used.
+         * @param t_far From this distance on, no more particles are emitted.
+         */
+        void SetLodDistances(float t_near, float t_far);
+
+        /**
+         * @brief Set the screen size below which no more particles are emitted.
+         * @param t_minScreenSize A fraction of the screen height.
+         */
+        void SetMinScreenSize(float t_minScreenSize);
+
         //-------------------------------------------------
         // Logic
         //-------------------------------------------------
@@ -91,7 +200,18 @@ namespace sg::ogl::particle
         void GenerateParticles(double t_dt, const glm::vec3& t_systemCenter);
 
         void Update(double t_dt);
-        void Render();
+
+        /**
+         * @brief Draws the particles of the GPU path with an indirect draw call.
+         *        The Vao of the quad and the shader program must be bound.
+         */
+        void RenderGpu() const;
+
+        /**
+         * @brief Sorts the living particles back-to-front for the current camera.
+         * @return The indices of the living particles in drawing order.
+         */
+        const DepthSorter::IndexContainer& SortByDepth();
 
         //-------------------------------------------------
         // Helper
@@ -102,7 +222,12 @@ namespace sg::ogl::particle
     protected:
 
     private:
-        uint32_t m_containerIndex{ NR_OF_ELEMENTS - 1 };
+        uint32_t m_capacity{ DEFAULT_CAPACITY };
+
+        /**
+         * @brief The particles as structure of arrays.
+         */
+        ParticleStore m_store;
 
         scene::Scene* m_scene{ nullptr };
 
@@ -116,20 +241,33 @@ namespace sg::ogl::particle
         float m_lifeTime{ 4.0f };
         float m_maxScale{ 1.0f };
 
+        float m_lodNear{ DEFAULT_LOD_NEAR };
+        float m_lodFar{ DEFAULT_LOD_FAR };
+        float m_minScreenSize{ DEFAULT_MIN_SCREEN_SIZE };
+
+        float m_lodFactor{ 1.0f };
+        uint32_t m_lodCapacity{ DEFAULT_CAPACITY };
+        bool m_visible{ true };
+
         /**
-         * @brief Vbo Id of instanced data.
+         * @brief The particles of the GPU path. Created on first use.
          */
-        uint32_t m_vboId{ 0 };
+        GpuParticleStoreUniquePtr m_gpuStore;
 
         /**
-         * @brief A Mesh for instanced rendering.
+         * @brief Sorts the particles when alpha blending is used.
          */
-        MeshUniquePtr m_mesh;
+        DepthSorter m_depthSorter;
 
         /**
-         * @brief A float buffer for instanced data.
+         * @brief The view space z coordinate of each living particle.
          */
-        InstancedDataContainer m_instancedData;
+        std::vector<float> m_depths;
+
+        /**
+         * @brief The terrain height below each living particle.
+         */
+        std::vector<float> m_terrainHeights;
 
         //-------------------------------------------------
         // Init
@@ -137,10 +275,48 @@ namespace sg::ogl::particle
 
         void Init();
 
+        //-------------------------------------------------
+        // Lod
+        //-------------------------------------------------
+
+        /**
+         * @brief Computes visibility and level of detail for the current camera.
+         * @param t_systemCenter The emitter center.
+         */
+        void UpdateLod(const glm::vec3& t_systemCenter);
+
+        //-------------------------------------------------
+        // Collision
+        //-------------------------------------------------
+
+        void CollideWithTerrain();
+
+        //-------------------------------------------------
+        // Pool
+        //-------------------------------------------------
+
+        /**
+         * @brief Doubles the size of the ParticleStore, but not beyond the capacity.
+         */
+        void Grow();
+
         //-------------------------------------------------
         // Emit
         //-------------------------------------------------
 
-        void Emit(const glm::vec3& t_systemCenter);
+        /**
+         * @brief Adds a new particle.
+         * @param t_systemCenter The world space center of the ParticleSystem.
+         * @return False if the particle was dropped because the capacity is reached.
+         */
+        bool Emit(const glm::vec3& t_systemCenter);
+
+        //-------------------------------------------------
+        // Gpu
+        //-------------------------------------------------
+
+        void InitGpu();
+        void EmitGpu(uint32_t t_count, const glm::vec3& t_systemCenter);
+        void UpdateGpu(float t_dt);
     };
 }
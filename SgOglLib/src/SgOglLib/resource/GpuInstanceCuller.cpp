@@ -0,0 +1,162 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: GpuInstanceCuller.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <cstddef>
+#include <cstring>
+#include "GpuInstanceCuller.h"
+#include "Mesh.h"
+#include "OpenGl.h"
+#include "Core.h"
+#include "buffer/Vbo.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+sg::ogl::resource::GpuInstanceCuller::GpuInstanceCuller(
+    const std::vector<math::PackedTransform>& t_transforms,
+    const std::vector<glm::vec4>& t_spheres,
+    const std::vector<int32_t>& t_drawCounts
+)
+    : m_nrInstances{ static_cast<uint32_t>(t_transforms.size()) }
+{
+    SG_OGL_CORE_ASSERT(t_spheres.size() == t_transforms.size(), "[GpuInstanceCuller::GpuInstanceCuller()] Invalid number of spheres.");
+    SG_OGL_CORE_ASSERT(!t_drawCounts.empty(), "[GpuInstanceCuller::GpuInstanceCuller()] Invalid number of meshes.");
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[GpuInstanceCuller::GpuInstanceCuller()] Create GpuInstanceCuller.");
+
+    for (const auto drawCount : t_drawCounts)
+    {
+        DrawElementsIndirectCommand command;
+        command.count = static_cast<uint32_t>(drawCount);
+        m_commands.push_back(command);
+    }
+
+    Init(t_transforms, t_spheres);
+}
+
+sg::ogl::resource::GpuInstanceCuller::~GpuInstanceCuller() noexcept
+{
+    Log::SG_OGL_CORE_LOG_DEBUG("[GpuInstanceCuller::~GpuInstanceCuller()] Destruct GpuInstanceCuller.");
+
+    CleanUp();
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+uint32_t sg::ogl::resource::GpuInstanceCuller::GetNumberOfInstances() const noexcept
+{
+    return m_nrInstances;
+}
+
+uint32_t sg::ogl::resource::GpuInstanceCuller::GetNumberOfWorkGroups() const noexcept
+{
+    return (m_nrInstances + WORK_GROUP_SIZE - 1) / WORK_GROUP_SIZE;
+}
+
+uint32_t sg::ogl::resource::GpuInstanceCuller::ReadNumberOfVisibleInstances() const
+{
+    uint32_t instanceCount{ 0 };
+
+    glBindBuffer(GL_COPY_READ_BUFFER, m_commandBufferId);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, offsetof(DrawElementsIndirectCommand, instanceCount), sizeof(uint32_t), &instanceCount);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    return instanceCount;
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void sg::ogl::resource::GpuInstanceCuller::BeginCulling(const uint32_t t_outputBufferId) const
+{
+    // reset the instance counters
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_commandBufferId);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, m_commands.size() * sizeof(DrawElementsIndirectCommand), m_commands.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, IN_BINDING, m_instanceBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OUT_BINDING, t_outputBufferId);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMAND_BINDING, m_commandBufferId);
+}
+
+void sg::ogl::resource::GpuInstanceCuller::EndCulling() const
+{
+    if (m_commands.size() < 2)
+    {
+        return;
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, m_commandBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_commandBufferId);
+
+    for (auto i{ 1u }; i < m_commands.size(); ++i)
+    {
+        glCopyBufferSubData(
+            GL_COPY_READ_BUFFER,
+            GL_COPY_WRITE_BUFFER,
+            offsetof(DrawElementsIndirectCommand, instanceCount),
+            i * sizeof(DrawElementsIndirectCommand) + offsetof(DrawElementsIndirectCommand, instanceCount),
+            sizeof(uint32_t)
+        );
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void sg::ogl::resource::GpuInstanceCuller::Draw(const uint32_t t_meshIndex, const Mesh& t_mesh) const
+{
+    SG_OGL_CORE_ASSERT(t_meshIndex < m_commands.size(), "[GpuInstanceCuller::Draw()] Invalid mesh index.");
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBufferId);
+
+    t_mesh.DrawInstancedIndirect(t_meshIndex * sizeof(DrawElementsIndirectCommand));
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+//-------------------------------------------------
+// Init
+//-------------------------------------------------
+
+void sg::ogl::resource::GpuInstanceCuller::Init(const std::vector<math::PackedTransform>& t_transforms, const std::vector<glm::vec4>& t_spheres)
+{
+    // interleave sphere and transform; matches the std430 layout of the Instance struct
+    std::vector<float> instances(static_cast<size_t>(m_nrInstances) * NUMBER_OF_FLOATS_PER_INSTANCE);
+    for (auto i{ 0u }; i < m_nrInstances; ++i)
+    {
+        auto* instance{ &instances[static_cast<size_t>(i) * NUMBER_OF_FLOATS_PER_INSTANCE] };
+        std::memcpy(instance, &t_spheres[i], sizeof(glm::vec4));
+        std::memcpy(instance + 4, &t_transforms[i], sizeof(math::PackedTransform));
+    }
+
+    m_instanceBufferId = buffer::Vbo::GenerateVbo();
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_instanceBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, instances.size() * sizeof(float), instances.data(), GL_STATIC_DRAW);
+
+    m_commandBufferId = buffer::Vbo::GenerateVbo();
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_commandBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, m_commands.size() * sizeof(DrawElementsIndirectCommand), m_commands.data(), GL_DYNAMIC_DRAW);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+//-------------------------------------------------
+// CleanUp
+//-------------------------------------------------
+
+void sg::ogl::resource::GpuInstanceCuller::CleanUp() const
+{
+    buffer::Vbo::DeleteVbo(m_instanceBufferId);
+    buffer::Vbo::DeleteVbo(m_commandBufferId);
+}
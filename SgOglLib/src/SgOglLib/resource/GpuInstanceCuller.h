@@ -0,0 +1,152 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: GpuInstanceCuller.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include "math/PackedTransform.h"
+
+namespace sg::ogl::resource
+{
+    class Mesh;
+
+    /**
+     * @brief GPU resident instance data for the compute shader culling path of a Model.
+     *        The transforms and bounding spheres of all instances are uploaded once to a shader
+     *        storage buffer. Each frame the compute shader appends the visible transforms to the
+     *        instance Vbo of the model and counts them in the instanceCount of a
+     *        DrawElementsIndirectCommand, which is consumed directly by glDrawElementsIndirect.
+     */
+    class GpuInstanceCuller
+    {
+    public:
+        /**
+         * @brief A mesh without index buffer reads the first four members as DrawArraysIndirectCommand.
+         */
+        struct DrawElementsIndirectCommand
+        {
+            uint32_t count{ 0 };
+            uint32_t instanceCount{ 0 };
+            uint32_t firstIndex{ 0 };
+            int32_t baseVertex{ 0 };
+            uint32_t baseInstance{ 0 };
+        };
+
+        /**
+         * @brief An instance has a bounding sphere (center, radius) and a PackedTransform,
+         *        padded to the std430 size of the Instance struct.
+         */
+        static constexpr uint32_t NUMBER_OF_FLOATS_PER_INSTANCE{ 12 };
+
+        /**
+         * @brief The local size of the compute shader.
+         */
+        static constexpr uint32_t WORK_GROUP_SIZE{ 256 };
+
+        /**
+         * @brief The binding points of the buffers in the shader.
+         */
+        static constexpr uint32_t IN_BINDING{ 0 };
+        static constexpr uint32_t OUT_BINDING{ 1 };
+        static constexpr uint32_t COMMAND_BINDING{ 2 };
+
+        //-------------------------------------------------
+        // Per dispatch values
+        //-------------------------------------------------
+
+        std::vector<glm::vec4> frustumPlanes;
+        glm::vec3 cameraPosition{ glm::vec3(0.0f) };
+        float maxDistance{ 0.0f };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        GpuInstanceCuller() = delete;
+
+        /**
+         * @param t_transforms The packed transforms of the instances.
+         * @param t_spheres The world space bounding spheres of the instances.
+         * @param t_drawCounts The number of indices (or vertices) of each mesh.
+         */
+        GpuInstanceCuller(const std::vector<math::PackedTransform>& t_transforms, const std::vector<glm::vec4>& t_spheres, const std::vector<int32_t>& t_drawCounts);
+
+        GpuInstanceCuller(const GpuInstanceCuller& t_other) = delete;
+        GpuInstanceCuller(GpuInstanceCuller&& t_other) noexcept = delete;
+        GpuInstanceCuller& operator=(const GpuInstanceCuller& t_other) = delete;
+        GpuInstanceCuller& operator=(GpuInstanceCuller&& t_other) noexcept = delete;
+
+        ~GpuInstanceCuller() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] uint32_t GetNumberOfInstances() const noexcept;
+
+        /**
+         * @brief The number of work groups to cover all instances.
+         */
+        [[nodiscard]] uint32_t GetNumberOfWorkGroups() const noexcept;
+
+        /**
+         * @brief Reads the instanceCount of the first command back from the GPU.
+         *        Waits for the last culling; meant for tests.
+         */
+        [[nodiscard]] uint32_t ReadNumberOfVisibleInstances() const;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * @brief Resets the commands and binds the buffers for the compute shader.
+         * @param t_outputBufferId The instance Vbo which receives the visible transforms.
+         */
+        void BeginCulling(uint32_t t_outputBufferId) const;
+
+        /**
+         * @brief Copies the instance count of the first command to the commands of the other meshes.
+         *        The shader writes must be made visible with a barrier before.
+         */
+        void EndCulling() const;
+
+        /**
+         * @brief Issues the indirect draw call of a mesh. The Vao of the mesh must be bound.
+         * @param t_meshIndex The index of the mesh in the model.
+         * @param t_mesh The mesh.
+         */
+        void Draw(uint32_t t_meshIndex, const Mesh& t_mesh) const;
+
+    protected:
+
+    private:
+        uint32_t m_nrInstances{ 0 };
+
+        std::vector<DrawElementsIndirectCommand> m_commands;
+
+        uint32_t m_instanceBufferId{ 0 };
+        uint32_t m_commandBufferId{ 0 };
+
+        //-------------------------------------------------
+        // Init
+        //-------------------------------------------------
+
+        void Init(const std::vector<math::PackedTransform>& t_transforms, const std::vector<glm::vec4>& t_spheres);
+
+        //-------------------------------------------------
+        // CleanUp
+        //-------------------------------------------------
+
+        void CleanUp() const;
+    };
+}
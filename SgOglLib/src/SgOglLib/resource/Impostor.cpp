@@ -0,0 +1,220 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: Impostor.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include "Impostor.h"
+#include "Model.h"
+#include "Mesh.h"
+#include "Material.h"
+#include "TextureManager.h"
+#include "ShaderManager.h"
+#include "Application.h"
+#include "SgOglException.h"
+#include "Core.h"
+#include "buffer/VertexAttribute.h"
+#include "buffer/BufferLayout.h"
+#include "resource/shaderprogram/ImpostorBakeShaderProgram.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+sg::ogl::resource::Impostor::Impostor(
+    const Model& t_model,
+    Application* t_application,
+    const std::string& t_name,
+    const uint32_t t_views,
+    const int32_t t_viewSize
+)
+    : m_application{ t_application }
+    , m_views{ t_views }
+    , m_viewSize{ t_viewSize }
+{
+    SG_OGL_CORE_ASSERT(m_application, "[Impostor::Impostor()] Null pointer.");
+    SG_OGL_CORE_ASSERT(m_views > 0, "[Impostor::Impostor()] Invalid number of views.");
+    SG_OGL_CORE_ASSERT(m_viewSize > 0, "[Impostor::Impostor()] Invalid view size.");
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[Impostor::Impostor()] Create Impostor.");
+
+    CreateMesh();
+    Bake(t_model, t_name);
+}
+
+sg::ogl::resource::Impostor::~Impostor() noexcept
+{
+    Log::SG_OGL_CORE_LOG_DEBUG("[Impostor::~Impostor()] Destruct Impostor.");
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+uint32_t sg::ogl::resource::Impostor::GetTextureId() const noexcept
+{
+    return m_textureId;
+}
+
+uint32_t sg::ogl::resource::Impostor::GetNumberOfViews() const noexcept
+{
+    return m_views;
+}
+
+const sg::ogl::resource::Mesh& sg::ogl::resource::Impostor::GetMesh() const noexcept
+{
+    return *m_mesh;
+}
+
+const glm::vec3& sg::ogl::resource::Impostor::GetOrigin() const noexcept
+{
+    return m_origin;
+}
+
+const glm::vec2& sg::ogl::resource::Impostor::GetSize() const noexcept
+{
+    return m_size;
+}
+
+//-------------------------------------------------
+// Init
+//-------------------------------------------------
+
+void sg::ogl::resource::Impostor::CreateMesh()
+{
+    // create Mesh
+    m_mesh = std::make_unique<Mesh>();
+
+    // create BufferLayout
+    const buffer::BufferLayout bufferLayout{
+        { buffer::VertexAttributeType::POSITION_2D, "aPosition" },
+    };
+
+    // to render with GL_TRIANGLE_STRIP; x is scaled by the half width, y by the height
+    std::vector<float> vertices{
+        -1.0f, 1.0f,
+        -1.0f, 0.0f,
+         1.0f, 1.0f,
+         1.0f, 0.0f
+    };
+
+    // add Vbo
+    m_mesh->GetVao().AddVertexDataVbo(vertices.data(), static_cast<int32_t>(vertices.size()) / 2, bufferLayout);
+}
+
+void sg::ogl::resource::Impostor::Bake(const Model& t_model, const std::string& t_name)
+{
+    const auto& aabbMin{ t_model.GetAabbMin() };
+    const auto& aabbMax{ t_model.GetAabbMax() };
+
+    // the quad covers the model from each direction around the y axis
+    const auto radius{ std::max(length(glm::vec2(aabbMax.x - aabbMin.x, aabbMax.z - aabbMin.z)) * 0.5f, 0.001f) };
+    const auto height{ std::max(aabbMax.y - aabbMin.y, 0.001f) };
+
+    m_origin = glm::vec3((aabbMin.x + aabbMax.x) * 0.5f, aabbMin.y, (aabbMin.z + aabbMax.z) * 0.5f);
+    m_size = glm::vec2(radius, height);
+
+    const auto width{ m_viewSize * static_cast<int32_t>(m_views) };
+
+    // the atlas with one view per column
+    m_textureId = m_application->GetTextureManager().GetTextureId(t_name);
+    TextureManager::Bind(m_textureId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, m_viewSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    uint32_t fboId{ 0 };
+    glGenFramebuffers(1, &fboId);
+    glBindFramebuffer(GL_FRAMEBUFFER, fboId);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_textureId, 0);
+
+    uint32_t depthRenderBufferId{ 0 };
+    glGenRenderbuffers(1, &depthRenderBufferId);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRenderBufferId);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, m_viewSize);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRenderBufferId);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteRenderbuffers(1, &depthRenderBufferId);
+        glDeleteFramebuffers(1, &fboId);
+
+        throw SG_OGL_EXCEPTION("[Impostor::Bake()] Error while creating the Fbo.");
+    }
+
+    // the background stays transparent
+    float clearColor[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+    const auto faceCulling{ glIsEnabled(GL_CULL_FACE) };
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glEnable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+
+    auto& shaderManager{ m_application->GetShaderManager() };
+    shaderManager.AddShaderProgram<shaderprogram::ImpostorBakeShaderProgram>();
+
+    auto& shaderProgram{ shaderManager.GetShaderProgram<shaderprogram::ImpostorBakeShaderProgram>() };
+    shaderProgram.Bind();
+
+    const auto center{ m_origin + glm::vec3(0.0f, height * 0.5f, 0.0f) };
+    shaderProgram.SetUniform("projectionMatrix", glm::ortho(-radius, radius, -height * 0.5f, height * 0.5f, 0.0f, 2.0f * radius));
+
+    for (auto view{ 0u }; view < m_views; ++view)
+    {
+        // the view looks from the direction (sin, 0, cos) of its angle to the y axis
+        const auto angle{ glm::two_pi<float>() * static_cast<float>(view) / static_cast<float>(m_views) };
+        const glm::vec3 direction{ std::sin(angle), 0.0f, std::cos(angle) };
+
+        glViewport(static_cast<int32_t>(view) * m_viewSize, 0, m_viewSize, m_viewSize);
+        shaderProgram.SetUniform("viewMatrix", lookAt(center + direction * radius, center, glm::vec3(0.0f, 1.0f, 0.0f)));
+
+        for (const auto& mesh : t_model.GetMeshes())
+        {
+            const auto& material{ *mesh->GetDefaultMaterial() };
+
+            shaderProgram.SetUniform("diffuseColor", material.kd);
+            shaderProgram.SetUniform("hasDiffuseMap", material.HasDiffuseMap());
+            if (material.HasDiffuseMap())
+            {
+                shaderProgram.SetUniform("diffuseMap", 0);
+                TextureManager::BindForReading(material.mapKd, GL_TEXTURE0);
+            }
+
+            mesh->InitDraw();
+            mesh->DrawPrimitives();
+            mesh->EndDraw();
+        }
+    }
+
+    ShaderProgram::Unbind();
+
+    // restore the states
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, m_application->GetProjectionOptions().width, m_application->GetProjectionOptions().height);
+    glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+    if (faceCulling)
+    {
+        glEnable(GL_CULL_FACE);
+    }
+
+    glDeleteRenderbuffers(1, &depthRenderBufferId);
+    glDeleteFramebuffers(1, &fboId);
+
+    // the smallest mipmap keeps four texels per view
+    TextureManager::Bind(m_textureId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, std::max(static_cast<int32_t>(std::log2(m_viewSize)) - 2, 0));
+    glGenerateMipmap(GL_TEXTURE_2D);
+    TextureManager::UseBilinearMipmapFilter();
+    TextureManager::UseClampToEdgeWrapping();
+    TextureManager::Unbind();
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[Impostor::Bake()] {} views of {} x {} pixels were baked into the texture {}.", m_views, m_viewSize, m_viewSize, t_name);
+}
@@ -0,0 +1,111 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: Impostor.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+namespace sg::ogl
+{
+    class Application;
+}
+
+namespace sg::ogl::resource
+{
+    class Mesh;
+    class Model;
+
+    /**
+     * @brief The far Lod of an instanced model. The model is rendered once from a number of views around
+     *        the y axis into the columns of an atlas texture. Each instance is drawn as a quad which turns
+     *        around the y axis to the camera and shows the view closest to the camera direction.
+     */
+    class Impostor
+    {
+    public:
+        static constexpr uint32_t DEFAULT_VIEWS{ 8 };
+        static constexpr int32_t DEFAULT_VIEW_SIZE{ 128 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Impostor() = delete;
+
+        /**
+         * @brief Bakes the views of the model. Must be called on the render thread.
+         * @param t_model The model to bake.
+         * @param t_application The Application.
+         * @param t_name The name of the atlas texture in the TextureManager.
+         * @param t_views The number of views around the y axis.
+         * @param t_viewSize The width and height of a view in pixels.
+         */
+        Impostor(
+            const Model& t_model,
+            Application* t_application,
+            const std::string& t_name,
+            uint32_t t_views = DEFAULT_VIEWS,
+            int32_t t_viewSize = DEFAULT_VIEW_SIZE
+        );
+
+        Impostor(const Impostor& t_other) = delete;
+        Impostor(Impostor&& t_other) noexcept = delete;
+        Impostor& operator=(const Impostor& t_other) = delete;
+        Impostor& operator=(Impostor&& t_other) noexcept = delete;
+
+        ~Impostor() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] uint32_t GetTextureId() const noexcept;
+        [[nodiscard]] uint32_t GetNumberOfViews() const noexcept;
+
+        /**
+         * @brief The quad from (-1, 0) to (1, 1) to render with GL_TRIANGLE_STRIP.
+         */
+        [[nodiscard]] const Mesh& GetMesh() const noexcept;
+
+        /**
+         * @brief The bottom center of the quad in model space.
+         */
+        [[nodiscard]] const glm::vec3& GetOrigin() const noexcept;
+
+        /**
+         * @brief The half width and the height of the quad in model space.
+         */
+        [[nodiscard]] const glm::vec2& GetSize() const noexcept;
+
+    protected:
+
+    private:
+        Application* m_application{ nullptr };
+
+        std::unique_ptr<Mesh> m_mesh;
+
+        uint32_t m_textureId{ 0 };
+        uint32_t m_views{ DEFAULT_VIEWS };
+        int32_t m_viewSize{ DEFAULT_VIEW_SIZE };
+
+        glm::vec3 m_origin{ glm::vec3(0.0f) };
+        glm::vec2 m_size{ glm::vec2(0.0f) };
+
+        //-------------------------------------------------
+        // Init
+        //-------------------------------------------------
+
+        void CreateMesh();
+        void Bake(const Model& t_model, const std::string& t_name);
+    };
+}
@@ -88,6 +88,11 @@ void sg::ogl::resource::Mesh::DrawInstanced(const int32_t t_instanceCount, const
     m_vao->DrawInstanced(t_instanceCount, t_drawMode);
 }
 
+void sg::ogl::resource::Mesh::DrawInstancedIndirect(const uint64_t t_offset, const uint32_t t_drawMode) const
+{
+    m_vao->DrawInstancedIndirect(t_offset, t_drawMode);
+}
+
 void sg::ogl::resource::Mesh::EndDraw()
 {
     buffer::Vao::UnbindVao();
@@ -100,6 +100,13 @@ namespace sg::ogl::resource
          */
         void DrawInstanced(int32_t t_instanceCount, uint32_t t_drawMode = GL_TRIANGLES) const;
 
+        /**
+         * @brief Calls glDrawElementsIndirect or glDrawArraysIndirect to render.
+         * @param t_offset The byte offset of the command in the bound GL_DRAW_INDIRECT_BUFFER.
+         * @param t_drawMode Specifies what kind of primitives to render.
+         */
+        void DrawInstancedIndirect(uint64_t t_offset, uint32_t t_drawMode = GL_TRIANGLES) const;
+
         /**
          * @brief Unbind Vao.
          */
@@ -8,15 +8,24 @@
 // 2019 (c) stwe <https://github.com/stwe/SgOgl>
 
 #include <assimp/Importer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include "Model.h"
 #include "Mesh.h"
+#include "GpuInstanceCuller.h"
+#include "Impostor.h"
 #include "Material.h"
 #include "TextureManager.h"
 #include "SgOglException.h"
 #include "Application.h"
+#include "ThreadPool.h"
 #include "Core.h"
 #include "buffer/VertexAttribute.h"
 #include "buffer/BufferLayout.h"
+#include "camera/Camera.h"
+#include "resource/ShaderManager.h"
+#include "resource/shaderprogram/ComputeInstanceCull.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -37,6 +46,14 @@ sg::ogl::resource::Model::Model(const std::string& t_fullFilePath, Application*
 sg::ogl::resource::Model::~Model() noexcept
 {
     Log::SG_OGL_CORE_LOG_DEBUG("[Model::~Model()] Destruct Model.");
+
+    for (const auto vboId : m_instanceVboIds)
+    {
+        if (vboId)
+        {
+            buffer::Vbo::DeleteVbo(vboId);
+        }
+    }
 }
 
 //-------------------------------------------------
@@ -48,50 +65,418 @@ const sg::ogl::resource::Model::MeshContainer& sg::ogl::resource::Model::GetMesh
     return m_meshes;
 }
 
+const glm::vec3& sg::ogl::resource::Model::GetAabbMin() const noexcept
+{
+    return m_aabbMin;
+}
+
+const glm::vec3& sg::ogl::resource::Model::GetAabbMax() const noexcept
+{
+    return m_aabbMax;
+}
+
 //-------------------------------------------------
 // Instancing
 //-------------------------------------------------
 
 void sg::ogl::resource::Model::AddTransformVbo(const std::vector<math::Transform>& t_transforms)
 {
-    static constexpr uint32_t NUMBER_OF_FLOATS_PER_INSTANCE{ 16 };
+    const auto instances{ static_cast<uint32_t>(t_transforms.size()) };
 
-    std::vector<glm::mat4> matrices;
-    for (auto& transform : t_transforms)
+    // the bounding sphere of the model space box
+    const auto center{ (m_aabbMin + m_aabbMax) * 0.5f };
+    const auto radius{ length(m_aabbMax - m_aabbMin) * 0.5f };
+
+    auto nonUniformScale{ false };
+
+    m_instanceTransforms.resize(instances);
+    m_instanceSpheres.resize(instances);
+    for (auto i{ 0u }; i < instances; ++i)
     {
-        matrices.push_back(static_cast<glm::mat4>(transform));
+        nonUniformScale = nonUniformScale || !math::PackedTransform::HasUniformScale(t_transforms[i]);
+
+        // the sphere of the packed values; they are drawn
+        const math::PackedTransform transform{ t_transforms[i] };
+        const auto scale{ transform.GetScale() };
+
+        m_instanceTransforms[i] = transform;
+        m_instanceSpheres[i] = glm::vec4(transform.position + transform.GetRotation() * (center * scale), radius * scale);
     }
 
-    const auto instances{ static_cast<uint32_t>(matrices.size()) };
-    const auto floatCount{ NUMBER_OF_FLOATS_PER_INSTANCE * instances };
+    if (nonUniformScale)
+    {
+        Log::SG_OGL_CORE_LOG_WARN("[Model::AddTransformVbo()] Instances of the model {} have a non uniform scale. The largest component is used.", m_fullFilePath);
+    }
 
-    // create an empty Vbo for instanced data
-    const auto vbo{ buffer::Vbo::GenerateVbo() };
+    SortInstancesIntoCells();
 
-    // init empty
-    buffer::Vbo::InitEmpty(vbo, floatCount, GL_STATIC_DRAW);
+    m_visibleTransforms.resize(instances);
+    m_instanceLods.resize(instances);
+    m_cellVisibleCounts.resize(m_instanceCells.size() * NUMBER_OF_LODS);
+    m_cellFullyVisible.resize(m_instanceCells.size());
+    m_cellLods.resize(m_instanceCells.size());
+    m_gpuInstanceCuller.reset();
 
-    // store data
-    buffer::Vbo::StoreTransformationMatrices(vbo, floatCount, matrices);
+    // create a Vbo for instanced data; all instances are visible until the first CullInstances()
+    auto& vboId{ m_instanceVboIds[FULL_LOD] };
+    if (vboId)
+    {
+        buffer::Vbo::DeleteVbo(vboId);
+    }
+
+    vboId = buffer::Vbo::GenerateVbo();
+    UploadAllInstances();
 
     // bind Vbo to each mesh
-    const unsigned int pFlags{ aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_GenSmoothNormals };
-    for (auto& mesh : m_meshes)
+    for (const auto& mesh : m_meshes)
+    {
+        AddInstanceAttributes(vboId, *mesh);
+    }
+
+    Log::SG_OGL_CORE_LOG_WARN("[Model::AddTransformVbo()] The Vao for the model {} has been changed for instancing.", m_fullFilePath);
+}
+
+uint32_t sg::ogl::resource::Model::GetNumberOfInstances() const noexcept
+{
+    return static_cast<uint32_t>(m_instanceTransforms.size());
+}
+
+uint32_t sg::ogl::resource::Model::GetNumberOfInstanceCells() const noexcept
+{
+    return static_cast<uint32_t>(m_instanceCells.size());
+}
+
+uint32_t sg::ogl::resource::Model::CullInstances(
+    const PlaneContainer& t_planes,
+    const glm::vec3& t_cameraPosition,
+    const float t_maxDistance,
+    const float t_lodDistance,
+    const float t_impostorDistance
+)
+{
+    const auto nrCells{ GetNumberOfInstanceCells() };
+
+    // a distance of 0 or a missing Vbo disables a Lod
+    const auto lodDistance{ t_lodDistance > 0.0f && m_instanceVboIds[SIMPLIFIED_LOD] ? t_lodDistance : std::numeric_limits<float>::max() };
+    const auto impostorDistance{ t_impostorDistance > 0.0f && m_instanceVboIds[IMPOSTOR_LOD] ? t_impostorDistance : std::numeric_limits<float>::max() };
+
+    const auto getLod{ [&](const float t_distance) -> uint8_t
+    {
+        if (t_distance >= impostorDistance)
+        {
+            return IMPOSTOR_LOD;
+        }
+
+        return t_distance >= lodDistance ? SIMPLIFIED_LOD : FULL_LOD;
+    } };
+
+    m_application->GetThreadPool().ParallelFor(nrCells, [&](const uint32_t t_cell)
+    {
+        const auto& cell{ m_instanceCells[t_cell] };
+        auto* counts{ &m_cellVisibleCounts[static_cast<size_t>(t_cell) * NUMBER_OF_LODS] };
+
+        std::fill_n(counts, NUMBER_OF_LODS, 0u);
+        m_cellFullyVisible[t_cell] = 0;
+
+        // the planes which intersect the cell remain in the mask
+        auto planeMask{ (1u << t_planes.size()) - 1 };
+        if (!camera::Camera::IsAabbInFrustum(t_planes, cell.aabbMin, cell.aabbMax, planeMask))
+        {
+            return;
+        }
+
+        // the distances to the nearest point and to the farthest corner
+        const auto nearest{ distance(t_cameraPosition, clamp(t_cameraPosition, cell.aabbMin, cell.aabbMax)) };
+        const auto farthest{ length(max(abs(t_cameraPosition - cell.aabbMin), abs(t_cameraPosition - cell.aabbMax))) };
+
+        // a max distance of 0 disables the distance test
+        auto testDistance{ t_maxDistance > 0.0f };
+        if (testDistance)
+        {
+            if (nearest > t_maxDistance)
+            {
+                return;
+            }
+
+            testDistance = farthest > t_maxDistance;
+        }
+
+        // the sphere centers are inside the cell bounds; so are their Lods
+        const auto nearLod{ getLod(nearest) };
+        const auto farLod{ getLod(farthest) };
+
+        if (planeMask == 0 && !testDistance && nearLod == farLod)
+        {
+            counts[nearLod] = cell.count;
+            m_cellFullyVisible[t_cell] = 1;
+            m_cellLods[t_cell] = nearLod;
+
+            return;
+        }
+
+        const auto isVisible{ [&](const glm::vec4& t_sphere)
+        {
+            for (auto p{ 0u }; p < t_planes.size(); ++p)
+            {
+                const auto& plane{ t_planes[p] };
+                if ((planeMask & (1u << p)) && dot(plane.normal, glm::vec3(t_sphere)) + plane.distance < -t_sphere.w)
+                {
+                    return false;
+                }
+            }
+
+            return !testDistance || distance(t_cameraPosition, glm::vec3(t_sphere)) - t_sphere.w <= t_maxDistance;
+        } };
+
+        const auto end{ cell.first + cell.count };
+
+        if (nearLod == farLod)
+        {
+            auto visible{ cell.first };
+            for (auto i{ cell.first }; i < end; ++i)
+            {
+                if (isVisible(m_instanceSpheres[i]))
+                {
+                    m_visibleTransforms[visible++] = m_instanceTransforms[i];
+                }
+            }
+
+            counts[nearLod] = visible - cell.first;
+
+            return;
+        }
+
+        // the cell spans more than one Lod: count the visible instances per Lod first, then compact them ordered by Lod
+        for (auto i{ cell.first }; i < end; ++i)
+        {
+            const auto& sphere{ m_instanceSpheres[i] };
+
+            auto lod{ static_cast<uint8_t>(NUMBER_OF_LODS) };
+            if (isVisible(sphere))
+            {
+                lod = getLod(distance(t_cameraPosition, glm::vec3(sphere)));
+                ++counts[lod];
+            }
+
+            m_instanceLods[i] = lod;
+        }
+
+        std::array<uint32_t, NUMBER_OF_LODS> next{ cell.first, cell.first + counts[FULL_LOD], cell.first + counts[FULL_LOD] + counts[SIMPLIFIED_LOD] };
+        for (auto i{ cell.first }; i < end; ++i)
+        {
+            const auto lod{ m_instanceLods[i] };
+            if (lod < NUMBER_OF_LODS)
+            {
+                m_visibleTransforms[next[lod]++] = m_instanceTransforms[i];
+            }
+        }
+    });
+
+    m_visibleInstances.fill(0);
+    for (auto cell{ 0u }; cell < nrCells; ++cell)
+    {
+        for (auto lod{ 0u }; lod < NUMBER_OF_LODS; ++lod)
+        {
+            m_visibleInstances[lod] += m_cellVisibleCounts[static_cast<size_t>(cell) * NUMBER_OF_LODS + lod];
+        }
+    }
+
+    for (auto lod{ 0u }; lod < NUMBER_OF_LODS; ++lod)
+    {
+        if (!m_instanceVboIds[lod])
+        {
+            continue;
+        }
+
+        // orphan the old storage; then append the visible instances of each cell
+        buffer::Vbo::BindVbo(m_instanceVboIds[lod]);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<size_t>(m_visibleInstances[lod]) * sizeof(math::PackedTransform), nullptr, GL_STREAM_DRAW);
+
+        uint32_t uploaded{ 0 };
+        auto cell{ 0u };
+        while (cell < nrCells)
+        {
+            const math::PackedTransform* source{ nullptr };
+            auto count{ 0u };
+
+            if (m_cellFullyVisible[cell] && m_cellLods[cell] == lod)
+            {
+                source = &m_instanceTransforms[m_instanceCells[cell].first];
+
+                // the ranges of neighboring cells are adjacent; one upload for a run of visible cells
+                while (cell < nrCells && m_cellFullyVisible[cell] && m_cellLods[cell] == lod)
+                {
+                    count += m_instanceCells[cell].count;
+                    ++cell;
+                }
+            }
+            else
+            {
+                // the visible instances of the lower Lods are stored in front
+                const auto* counts{ &m_cellVisibleCounts[static_cast<size_t>(cell) * NUMBER_OF_LODS] };
+                count = counts[lod];
+
+                if (count > 0)
+                {
+                    auto offset{ m_instanceCells[cell].first };
+                    for (auto l{ 0u }; l < lod; ++l)
+                    {
+                        offset += counts[l];
+                    }
+
+                    source = &m_visibleTransforms[offset];
+                }
+
+                ++cell;
+            }
+
+            if (count > 0)
+            {
+                glBufferSubData(
+                    GL_ARRAY_BUFFER,
+                    static_cast<size_t>(uploaded) * sizeof(math::PackedTransform),
+                    static_cast<size_t>(count) * sizeof(math::PackedTransform),
+                    source
+                );
+
+                uploaded += count;
+            }
+        }
+    }
+
+    buffer::Vbo::UnbindVbo();
+
+    m_instanceVboContent = InstanceVboContent::CPU_CULLED;
+
+    return m_visibleInstances[FULL_LOD] + m_visibleInstances[SIMPLIFIED_LOD] + m_visibleInstances[IMPOSTOR_LOD];
+}
+
+uint32_t sg::ogl::resource::Model::GetNumberOfVisibleInstances(const uint32_t t_lod) const
+{
+    SG_OGL_CORE_ASSERT(t_lod < NUMBER_OF_LODS, "[Model::GetNumberOfVisibleInstances()] Invalid Lod.");
+    return m_visibleInstances[t_lod];
+}
+
+void sg::ogl::resource::Model::CullInstancesGpu(const PlaneContainer& t_planes, const glm::vec3& t_cameraPosition, const float t_maxDistance)
+{
+    if (GetNumberOfInstances() == 0)
+    {
+        return;
+    }
+
+    if (!m_gpuInstanceCuller)
     {
-        // get Vao of the mesh
-        auto& vao{ mesh->GetVao() };
-        vao.BindVao();
+        Log::SG_OGL_CORE_LOG_DEBUG("[Model::CullInstancesGpu()] Create GPU buffers for {} instances of the model {}.", GetNumberOfInstances(), m_fullFilePath);
+
+        std::vector<int32_t> drawCounts;
+        for (const auto& mesh : m_meshes)
+        {
+            drawCounts.push_back(mesh->GetVao().GetDrawCount());
+        }
+
+        m_gpuInstanceCuller = std::make_unique<GpuInstanceCuller>(m_instanceTransforms, m_instanceSpheres, drawCounts);
+        m_application->GetShaderManager().AddComputeShaderProgram<shaderprogram::ComputeInstanceCull>();
+    }
+
+    m_gpuInstanceCuller->frustumPlanes.clear();
+    for (const auto& plane : t_planes)
+    {
+        m_gpuInstanceCuller->frustumPlanes.emplace_back(plane.normal, plane.distance);
+    }
+
+    m_gpuInstanceCuller->cameraPosition = t_cameraPosition;
+    m_gpuInstanceCuller->maxDistance = t_maxDistance;
+
+    // the output needs room for all instances
+    if (m_instanceVboContent == InstanceVboContent::CPU_CULLED)
+    {
+        UploadAllInstances();
+    }
+
+    auto& shaderProgram{ m_application->GetShaderManager().GetComputeShaderProgram<shaderprogram::ComputeInstanceCull>() };
+    shaderProgram.Bind();
+    shaderProgram.UpdateUniforms(*m_gpuInstanceCuller);
+
+    m_gpuInstanceCuller->BeginCulling(m_instanceVboIds[FULL_LOD]);
+    glDispatchCompute(m_gpuInstanceCuller->GetNumberOfWorkGroups(), 1, 1);
+
+    // the counters are copied and read as commands; the transforms are read as vertex attributes
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+    m_gpuInstanceCuller->EndCulling();
+
+    ShaderProgram::Unbind();
+
+    m_instanceVboContent = InstanceVboContent::GPU_CULLED;
+}
+
+uint32_t sg::ogl::resource::Model::ReadNumberOfVisibleInstancesGpu() const
+{
+    return m_gpuInstanceCuller ? m_gpuInstanceCuller->ReadNumberOfVisibleInstances() : 0;
+}
 
-        // set Vbo attributes
-        buffer::Vbo::AddInstancedAttribute(vbo, 5, 4, NUMBER_OF_FLOATS_PER_INSTANCE, 0);
-        buffer::Vbo::AddInstancedAttribute(vbo, 6, 4, NUMBER_OF_FLOATS_PER_INSTANCE, 4);
-        buffer::Vbo::AddInstancedAttribute(vbo, 7, 4, NUMBER_OF_FLOATS_PER_INSTANCE, 8);
-        buffer::Vbo::AddInstancedAttribute(vbo, 8, 4, NUMBER_OF_FLOATS_PER_INSTANCE, 12);
+void sg::ogl::resource::Model::DrawInstancesIndirect(const uint32_t t_meshIndex) const
+{
+    if (m_gpuInstanceCuller)
+    {
+        m_gpuInstanceCuller->Draw(t_meshIndex, *m_meshes[t_meshIndex]);
+    }
+}
 
-        buffer::Vao::UnbindVao();
+void sg::ogl::resource::Model::ShowAllInstances()
+{
+    if (m_instanceVboContent != InstanceVboContent::ALL)
+    {
+        UploadAllInstances();
     }
+}
+
+void sg::ogl::resource::Model::UploadAllInstances()
+{
+    const auto instances{ GetNumberOfInstances() };
 
-    Log::SG_OGL_CORE_LOG_WARN("[Model::AddPositionsVbo()] The Vao for the model {} has been changed for instancing.", m_fullFilePath);
+    buffer::Vbo::BindVbo(m_instanceVboIds[FULL_LOD]);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<size_t>(instances) * sizeof(math::PackedTransform), m_instanceTransforms.data(), GL_STREAM_DRAW);
+    buffer::Vbo::UnbindVbo();
+
+    m_visibleInstances = { instances, 0, 0 };
+    m_instanceVboContent = InstanceVboContent::ALL;
+}
+
+//-------------------------------------------------
+// Lod
+//-------------------------------------------------
+
+void sg::ogl::resource::Model::AddSimplifiedLod(Model& t_simplifiedModel)
+{
+    auto& vboId{ m_instanceVboIds[SIMPLIFIED_LOD] };
+    if (!vboId)
+    {
+        vboId = buffer::Vbo::GenerateVbo();
+        buffer::Vbo::InitEmpty(vboId, 0, GL_STREAM_DRAW);
+    }
+
+    for (const auto& mesh : t_simplifiedModel.GetMeshes())
+    {
+        AddInstanceAttributes(vboId, *mesh);
+    }
+
+    Log::SG_OGL_CORE_LOG_WARN("[Model::AddSimplifiedLod()] The Vao for the model {} has been changed for instancing.", t_simplifiedModel.m_fullFilePath);
+}
+
+std::shared_ptr<sg::ogl::resource::Impostor> sg::ogl::resource::Model::CreateImpostorLod(const uint32_t t_views, const int32_t t_viewSize)
+{
+    auto impostor{ std::make_shared<Impostor>(*this, m_application, m_fullFilePath + "_impostor", t_views, t_viewSize) };
+
+    auto& vboId{ m_instanceVboIds[IMPOSTOR_LOD] };
+    if (!vboId)
+    {
+        vboId = buffer::Vbo::GenerateVbo();
+        buffer::Vbo::InitEmpty(vboId, 0, GL_STREAM_DRAW);
+    }
+
+    AddInstanceAttributes(vboId, impostor->GetMesh());
+
+    return impostor;
 }
 
 //-------------------------------------------------
@@ -122,6 +507,14 @@ void sg::ogl::resource::Model::ProcessNode(aiNode* t_node, const aiScene* t_scen
     {
         auto* mesh{ t_scene->mMeshes[t_node->mMeshes[i]] };
         m_meshes.push_back(ProcessMesh(mesh, t_scene));
+
+        // extend the bounding box for culling
+        for (auto v{ 0u }; v < mesh->mNumVertices; ++v)
+        {
+            const glm::vec3 position{ mesh->mVertices[v].x, mesh->mVertices[v].y, mesh->mVertices[v].z };
+            m_aabbMin = min(m_aabbMin, position);
+            m_aabbMax = max(m_aabbMax, position);
+        }
     }
 
     // After we've processed all of the meshes (if any) we then recursively process each of the children nodes.
@@ -330,3 +723,115 @@ sg::ogl::resource::Model::TextureContainer sg::ogl::resource::Model::LoadMateria
 
     return textures;
 }
+
+//-------------------------------------------------
+// Instancing
+//-------------------------------------------------
+
+void sg::ogl::resource::Model::SortInstancesIntoCells()
+{
+    const auto instances{ GetNumberOfInstances() };
+
+    m_instanceCells.clear();
+    if (instances == 0)
+    {
+        return;
+    }
+
+    // the xz bounds of the instance centers
+    auto minX{ std::numeric_limits<float>::max() };
+    auto minZ{ std::numeric_limits<float>::max() };
+    auto maxX{ std::numeric_limits<float>::lowest() };
+    auto maxZ{ std::numeric_limits<float>::lowest() };
+
+    for (const auto& sphere : m_instanceSpheres)
+    {
+        minX = std::min(minX, sphere.x);
+        minZ = std::min(minZ, sphere.z);
+        maxX = std::max(maxX, sphere.x);
+        maxZ = std::max(maxZ, sphere.z);
+    }
+
+    const auto cellsPerRow{ static_cast<uint32_t>(std::clamp(
+        std::ceil(std::sqrt(static_cast<double>(instances) / INSTANCES_PER_CELL)),
+        1.0,
+        static_cast<double>(MAX_CELLS_PER_ROW)
+    )) };
+
+    const auto cellsPerUnitX{ maxX > minX ? static_cast<float>(cellsPerRow) / (maxX - minX) : 0.0f };
+    const auto cellsPerUnitZ{ maxZ > minZ ? static_cast<float>(cellsPerRow) / (maxZ - minZ) : 0.0f };
+
+    // counting sort by cell index
+    std::vector<uint32_t> cellIndices(instances);
+    std::vector<uint32_t> offsets(static_cast<size_t>(cellsPerRow) * cellsPerRow + 1, 0);
+
+    for (auto i{ 0u }; i < instances; ++i)
+    {
+        const auto& sphere{ m_instanceSpheres[i] };
+        const auto x{ std::min(static_cast<uint32_t>((sphere.x - minX) * cellsPerUnitX), cellsPerRow - 1) };
+        const auto z{ std::min(static_cast<uint32_t>((sphere.z - minZ) * cellsPerUnitZ), cellsPerRow - 1) };
+
+        cellIndices[i] = z * cellsPerRow + x;
+        ++offsets[cellIndices[i] + 1];
+    }
+
+    for (auto c{ 1u }; c < offsets.size(); ++c)
+    {
+        offsets[c] += offsets[c - 1];
+    }
+
+    std::vector<math::PackedTransform> transforms(instances);
+    std::vector<glm::vec4> spheres(instances);
+
+    auto next{ offsets };
+    for (auto i{ 0u }; i < instances; ++i)
+    {
+        const auto target{ next[cellIndices[i]]++ };
+        transforms[target] = m_instanceTransforms[i];
+        spheres[target] = m_instanceSpheres[i];
+    }
+
+    m_instanceTransforms = std::move(transforms);
+    m_instanceSpheres = std::move(spheres);
+
+    // the non empty cells with the bounds of their spheres
+    for (auto c{ 0u }; c + 1 < offsets.size(); ++c)
+    {
+        if (offsets[c + 1] == offsets[c])
+        {
+            continue;
+        }
+
+        InstanceCell cell;
+        cell.first = offsets[c];
+        cell.count = offsets[c + 1] - offsets[c];
+        cell.aabbMin = glm::vec3(std::numeric_limits<float>::max());
+        cell.aabbMax = glm::vec3(std::numeric_limits<float>::lowest());
+
+        for (auto i{ cell.first }; i < cell.first + cell.count; ++i)
+        {
+            const auto& sphere{ m_instanceSpheres[i] };
+            cell.aabbMin = min(cell.aabbMin, glm::vec3(sphere) - sphere.w);
+            cell.aabbMax = max(cell.aabbMax, glm::vec3(sphere) + sphere.w);
+        }
+
+        m_instanceCells.push_back(cell);
+    }
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[Model::SortInstancesIntoCells()] {} instances of the model {} in {} cells.", instances, m_fullFilePath, m_instanceCells.size());
+}
+
+void sg::ogl::resource::Model::AddInstanceAttributes(const uint32_t t_vboId, const Mesh& t_mesh)
+{
+    // get Vao of the mesh
+    auto& vao{ t_mesh.GetVao() };
+    vao.BindVao();
+
+    // set Vbo attributes: position, rotation quaternion and uniform scale
+    const auto stride{ static_cast<int32_t>(sizeof(math::PackedTransform)) };
+    buffer::Vbo::AddInstancedAttribute(t_vboId, 5, 3, GL_FLOAT, false, stride, offsetof(math::PackedTransform, position));
+    buffer::Vbo::AddInstancedAttribute(t_vboId, 6, 4, GL_SHORT, true, stride, offsetof(math::PackedTransform, rotation));
+    buffer::Vbo::AddInstancedAttribute(t_vboId, 7, 1, GL_HALF_FLOAT, false, stride, offsetof(math::PackedTransform, scale));
+
+    buffer::Vao::UnbindVao();
+}
@@ -12,9 +12,14 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <vector>
+#include <array>
 #include <memory>
 #include <string>
+#include <limits>
+#include <glm/vec4.hpp>
 #include "math/Transform.h"
+#include "math/PackedTransform.h"
+#include "math/Plane.h"
 
 namespace sg::ogl
 {
@@ -24,6 +29,8 @@ namespace sg::ogl
 namespace sg::ogl::resource
 {
     class Mesh;
+    class GpuInstanceCuller;
+    class Impostor;
 
     class Model
     {
@@ -34,6 +41,15 @@ namespace sg::ogl::resource
         using MeshUniquePtr = std::unique_ptr<Mesh>;
         using MeshSharedPtr = std::shared_ptr<Mesh>;
         using MeshContainer = std::vector<MeshSharedPtr>;
+        using PlaneContainer = std::vector<math::Plane>;
+
+        static constexpr uint32_t INSTANCES_PER_CELL{ 2048 };
+        static constexpr uint32_t MAX_CELLS_PER_ROW{ 256 };
+
+        static constexpr uint32_t FULL_LOD{ 0 };
+        static constexpr uint32_t SIMPLIFIED_LOD{ 1 };
+        static constexpr uint32_t IMPOSTOR_LOD{ 2 };
+        static constexpr uint32_t NUMBER_OF_LODS{ 3 };
 
         //-------------------------------------------------
         // Ctors. / Dtor.
@@ -56,15 +72,132 @@ namespace sg::ogl::resource
 
         [[nodiscard]] const MeshContainer& GetMeshes() const noexcept;
 
+        /**
+         * @brief The min corner of the bounding box of all meshes in model space.
+         */
+        [[nodiscard]] const glm::vec3& GetAabbMin() const noexcept;
+
+        /**
+         * @brief The max corner of the bounding box of all meshes in model space.
+         */
+        [[nodiscard]] const glm::vec3& GetAabbMax() const noexcept;
+
         //-------------------------------------------------
         // Instancing
         //-------------------------------------------------
 
+        /**
+         * @brief Stores the instance transforms as PackedTransform and their bounding spheres on the Cpu
+         *        and creates the instance Vbo of the meshes. The instances are sorted into
+         *        the cells of a grid over xz, so that each cell is a contiguous range.
+         * @param t_transforms The instance transforms; a non uniform scale is replaced by its largest component.
+         */
         void AddTransformVbo(const std::vector<math::Transform>& t_transforms);
 
+        [[nodiscard]] uint32_t GetNumberOfInstances() const noexcept;
+
+        [[nodiscard]] uint32_t GetNumberOfInstanceCells() const noexcept;
+
+        /**
+         * @brief Tests the cells and then the bounding spheres of the instances in the intersected cells
+         *        against the given planes on the worker threads and uploads the visible instances to the
+         *        front of the instance Vbo of their Lod. Must be called on the render thread.
+         * @param t_planes The frustum planes; the normals point into the frustum.
+         * @param t_cameraPosition The position for the distance and the Lod tests.
+         * @param t_maxDistance Instances farther away are culled; 0 disables the distance test.
+         * @param t_lodDistance Instances from this distance on use the SIMPLIFIED_LOD; 0 disables the Lod.
+         * @param t_impostorDistance Instances from this distance on use the IMPOSTOR_LOD; 0 disables the Lod.
+         * @return The number of visible instances of all Lods.
+         */
+        uint32_t CullInstances(
+            const PlaneContainer& t_planes,
+            const glm::vec3& t_cameraPosition,
+            float t_maxDistance,
+            float t_lodDistance = 0.0f,
+            float t_impostorDistance = 0.0f
+        );
+
+        /**
+         * @brief The number of instances of a Lod which survived the last CullInstances() call.
+         * @param t_lod FULL_LOD, SIMPLIFIED_LOD or IMPOSTOR_LOD.
+         */
+        [[nodiscard]] uint32_t GetNumberOfVisibleInstances(uint32_t t_lod) const;
+
+        /**
+         * @brief The same test with a compute shader. The visible instances are written to the instance Vbo
+         *        and counted in the indirect draw commands, so the Cpu does no per instance work.
+         *        Draw the meshes with DrawInstancesIndirect() afterwards.
+         * @param t_planes The frustum planes; the normals point into the frustum.
+         * @param t_cameraPosition The position for the distance test.
+         * @param t_maxDistance Instances farther away are culled; 0 disables the distance test.
+         */
+        void CullInstancesGpu(const PlaneContainer& t_planes, const glm::vec3& t_cameraPosition, float t_maxDistance);
+
+        /**
+         * @brief The number of instances which survived the last CullInstancesGpu() call, read back
+         *        from the indirect draw command. Stalls until the compute shader is done; meant for tests.
+         */
+        [[nodiscard]] uint32_t ReadNumberOfVisibleInstancesGpu() const;
+
+        /**
+         * @brief Draws the instances which survived the last CullInstancesGpu() call. The Vao of the mesh must be bound.
+         * @param t_meshIndex The index of the mesh.
+         */
+        void DrawInstancesIndirect(uint32_t t_meshIndex) const;
+
+        /**
+         * @brief Uploads all instances to the Vbo of the FULL_LOD again after a culling call,
+         *        so that they can be drawn without culling.
+         */
+        void ShowAllInstances();
+
+        //-------------------------------------------------
+        // Lod
+        //-------------------------------------------------
+
+        /**
+         * @brief Binds the instance Vbo of the SIMPLIFIED_LOD to the meshes of the given model.
+         *        The Vao of the given model is changed; don't use it for other instances.
+         * @param t_simplifiedModel A model with less vertices.
+         */
+        void AddSimplifiedLod(Model& t_simplifiedModel);
+
+        /**
+         * @brief Bakes an impostor of this model and binds the instance Vbo of the IMPOSTOR_LOD to its quad.
+         * @param t_views The number of views around the y axis.
+         * @param t_viewSize The width and height of a view in pixels.
+         * @return The impostor.
+         */
+        std::shared_ptr<Impostor> CreateImpostorLod(uint32_t t_views, int32_t t_viewSize);
+
     protected:
 
     private:
+        /**
+         * @brief A grid cell with a contiguous range of instances.
+         */
+        struct InstanceCell
+        {
+            uint32_t first{ 0 };
+            uint32_t count{ 0 };
+
+            /**
+             * @brief The bounding box of the bounding spheres of the instances.
+             */
+            glm::vec3 aabbMin{ glm::vec3(0.0f) };
+            glm::vec3 aabbMax{ glm::vec3(0.0f) };
+        };
+
+        /**
+         * @brief What the Vbo of the FULL_LOD holds.
+         */
+        enum class InstanceVboContent
+        {
+            ALL,        // all instances
+            CPU_CULLED, // the visible instances; the Vbo was shrunk to their number
+            GPU_CULLED  // the visible instances; the Vbo has room for all instances
+        };
+
         Application* m_application{ nullptr };
 
         MeshContainer m_meshes;
@@ -72,6 +205,63 @@ namespace sg::ogl::resource
         std::string m_fullFilePath;
         std::string m_directory;
 
+        glm::vec3 m_aabbMin{ glm::vec3(std::numeric_limits<float>::max()) };
+        glm::vec3 m_aabbMax{ glm::vec3(std::numeric_limits<float>::lowest()) };
+
+        /**
+         * @brief The Vbos with the instance transforms of each Lod; after culling only the visible ones.
+         *        Without culling the Vbo of the FULL_LOD holds all instances.
+         */
+        std::array<uint32_t, NUMBER_OF_LODS> m_instanceVboIds{};
+
+        /**
+         * @brief The compute shader writes up to all instances into the Vbo of the FULL_LOD,
+         *        so the Vbo is filled again when switching from the Cpu to the Gpu culling.
+         */
+        InstanceVboContent m_instanceVboContent{ InstanceVboContent::ALL };
+
+        std::array<uint32_t, NUMBER_OF_LODS> m_visibleInstances{};
+
+        std::vector<math::PackedTransform> m_instanceTransforms;
+
+        /**
+         * @brief The world space bounding spheres of the instances (center, radius).
+         */
+        std::vector<glm::vec4> m_instanceSpheres;
+
+        /**
+         * @brief The non empty cells in the order of their instance ranges.
+         */
+        std::vector<InstanceCell> m_instanceCells;
+
+        /**
+         * @brief Each partially visible cell compacts its visible transforms to the start of its own range,
+         *        ordered by Lod. The counts are stored per cell and Lod.
+         */
+        std::vector<math::PackedTransform> m_visibleTransforms;
+        std::vector<uint32_t> m_cellVisibleCounts;
+
+        /**
+         * @brief The Lod of each visible instance in a cell which spans more than one Lod.
+         */
+        std::vector<uint8_t> m_instanceLods;
+
+        /**
+         * @brief The cells which are completely visible in a single Lod are uploaded directly from m_instanceTransforms.
+         */
+        std::vector<uint8_t> m_cellFullyVisible;
+        std::vector<uint8_t> m_cellLods;
+
+        /**
+         * @brief The instances on the Gpu; created with the first CullInstancesGpu() call.
+         */
+        std::unique_ptr<GpuInstanceCuller> m_gpuInstanceCuller;
+
+        /**
+         * @brief Uploads all instances to the Vbo of the FULL_LOD.
+         */
+        void UploadAllInstances();
+
         //-------------------------------------------------
         // Load Model
         //-------------------------------------------------
@@ -80,5 +270,12 @@ namespace sg::ogl::resource
         void ProcessNode(aiNode* t_node, const aiScene* t_scene);
         MeshUniquePtr ProcessMesh(aiMesh* t_mesh, const aiScene* t_scene) const;
         TextureContainer LoadMaterialTextures(aiMaterial* t_mat, aiTextureType t_type) const;
+
+        //-------------------------------------------------
+        // Instancing
+        //-------------------------------------------------
+
+        void SortInstancesIntoCells();
+        static void AddInstanceAttributes(uint32_t t_vboId, const Mesh& t_mesh);
     };
 }
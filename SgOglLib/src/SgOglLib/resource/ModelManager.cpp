@@ -110,6 +110,33 @@ sg::ogl::resource::ModelManager::VertexContainer sg::ogl::resource::ModelManager
     return vertices;
 }
 
+sg::ogl::resource::ModelManager::VertexContainer sg::ogl::resource::ModelManager::GetTerrainPatchVertices()
+{
+    VertexContainer vertices{
+        0.0f,   0.0f,
+        0.333f, 0.0f,
+        0.666f, 0.0f,
+        1.0f,   0.0f,
+
+        0.0f,   0.333f,
+        0.333f, 0.333f,
+        0.666f, 0.333f,
+        1.0f,   0.333f,
+
+        0.0f,   0.666f,
+        0.333f, 0.666f,
+        0.666f, 0.666f,
+        1.0f,   0.666f,
+
+        0.0f,   1.0f,
+        0.333f, 1.0f,
+        0.666f, 1.0f,
+        1.0f,   1.0f,
+    };
+
+    return vertices;
+}
+
 //-------------------------------------------------
 // Add
 //-------------------------------------------------
@@ -431,27 +458,7 @@ void sg::ogl::resource::ModelManager::AddTerrainPatchStaticMesh()
     };
 
     // set vertices
-    std::vector<float> vertices{
-        0.0f,   0.0f,
-        0.333f, 0.0f,
-        0.666f, 0.0f,
-        1.0f,   0.0f,
-
-        0.0f,   0.333f,
-        0.333f, 0.333f,
-        0.666f, 0.333f,
-        1.0f,   0.333f,
-
-        0.0f,   0.666f,
-        0.333f, 0.666f,
-        0.666f, 0.666f,
-        1.0f,   0.666f,
-
-        0.0f,   1.0f,
-        0.333f, 1.0f,
-        0.666f, 1.0f,
-        1.0f,   1.0f,
-    };
+    auto vertices{ GetTerrainPatchVertices() };
 
     // add Vbo
     const auto drawCount{ 16 };
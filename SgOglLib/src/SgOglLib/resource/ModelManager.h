@@ -90,6 +90,7 @@ namespace sg::ogl::resource
         SkeletalModelSharedPtr GetSkeletalModelWithFlags(const std::string& t_fullFilePath, unsigned int t_pFlags = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace | aiProcess_GenSmoothNormals);
 
         static VertexContainer GetParticleVertices();
+        static VertexContainer GetTerrainPatchVertices();
 
         //-------------------------------------------------
         // Add
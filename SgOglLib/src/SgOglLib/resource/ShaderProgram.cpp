@@ -397,6 +397,24 @@ void sg::ogl::resource::ShaderProgram::SetUniform(const std::string& t_uniformNa
     }
 }
 
+void sg::ogl::resource::ShaderProgram::SetUniform(const std::string& t_uniformName, const std::vector<glm::vec4>& t_container)
+{
+    const auto& m{ m_arrayUniformNames[t_uniformName] };
+    const auto size{ t_container.size() };
+
+    auto c{ 0u };
+    for (auto& value : m)
+    {
+        if (c == size)
+        {
+            break;
+        }
+
+        glUniform4fv(m_uniforms.at(value), 1, value_ptr(t_container[c]));
+        c++;
+    }
+}
+
 //-------------------------------------------------
 // To implement
 //-------------------------------------------------
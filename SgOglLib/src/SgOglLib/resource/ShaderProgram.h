@@ -37,6 +37,11 @@ namespace sg::ogl::light
     struct DirectionalLight;
 }
 
+namespace sg::ogl::particle
+{
+    class ParticleSystem;
+}
+
 namespace sg::ogl::terrain
 {
     class Terrain;
@@ -47,6 +52,7 @@ namespace sg::ogl::resource
 {
     struct Material;
     class Mesh;
+    class GpuInstanceCuller;
 
     class ShaderProgram
     {
@@ -139,6 +145,7 @@ namespace sg::ogl::resource
         void SetUniform(const std::string& t_uniformName, const std::vector<float>& t_container);
         void SetUniform(const std::string& t_uniformName, const std::vector<int32_t>& t_container);
         void SetUniform(const std::string& t_uniformName, const std::vector<glm::mat4>& t_container);
+        void SetUniform(const std::string& t_uniformName, const std::vector<glm::vec4>& t_container);
 
         //-------------------------------------------------
         // To implement
@@ -175,6 +182,8 @@ namespace sg::ogl::resource
 
         [[deprecated]] virtual void UpdateUniforms(const terrain::Terrain& t_terrain) {}
         virtual void UpdateUniforms(const terrain::TerrainConfig& t_terrainConfig) {}
+        virtual void UpdateUniforms(const particle::ParticleSystem& t_particleSystem) {}
+        virtual void UpdateUniforms(const GpuInstanceCuller& t_gpuInstanceCuller) {}
 
     protected:
 
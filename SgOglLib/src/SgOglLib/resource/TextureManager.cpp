@@ -97,6 +97,71 @@ uint32_t sg::ogl::resource::TextureManager::Get16BitHeightmapIdFromPath(const st
     return textureId;
 }
 
+sg::ogl::resource::TextureManager::HeightmapPixels sg::ogl::resource::TextureManager::DecodeHeightmap(const std::string& t_path, const bool t_16Bit)
+{
+    HeightmapPixels pixels;
+    int nrChannels;
+
+    if (t_16Bit)
+    {
+        auto* const image{ stbi_load_16(t_path.c_str(), &pixels.width, &pixels.height, &nrChannels, 0) };
+        if (!image)
+        {
+            throw SG_OGL_EXCEPTION("[TextureManager::DecodeHeightmap()] Heightmap failed to load at path: " + t_path);
+        }
+
+        pixels.values.resize(static_cast<size_t>(pixels.width) * pixels.height);
+        for (size_t i{ 0 }; i < pixels.values.size(); ++i)
+        {
+            pixels.values[i] = image[i * nrChannels];
+        }
+
+        stbi_image_free(image);
+    }
+    else
+    {
+        auto* const image{ stbi_load(t_path.c_str(), &pixels.width, &pixels.height, &nrChannels, 0) };
+        if (!image)
+        {
+            throw SG_OGL_EXCEPTION("[TextureManager::DecodeHeightmap()] Heightmap failed to load at path: " + t_path);
+        }
+
+        // 255 * 257 = 65535
+        pixels.values.resize(static_cast<size_t>(pixels.width) * pixels.height);
+        for (size_t i{ 0 }; i < pixels.values.size(); ++i)
+        {
+            pixels.values[i] = static_cast<uint16_t>(image[i * nrChannels] * 257);
+        }
+
+        stbi_image_free(image);
+    }
+
+    return pixels;
+}
+
+uint32_t sg::ogl::resource::TextureManager::GetHeightmapIdFromPixels(const std::string& t_path, const HeightmapPixels& t_pixels)
+{
+    uint32_t textureId;
+
+    if (m_textures.count(t_path) == 0)
+    {
+        textureId = GenerateNewTextureHandle();
+
+        LoadHeightmapFromPixels(t_path, t_pixels, textureId);
+
+        Log::SG_OGL_CORE_LOG_DEBUG("[TextureManager::GetHeightmapIdFromPixels()] A new heightmap {} was successfully uploaded and used for the new created texture handle. Id: {}", t_path, textureId);
+        m_textures.emplace(t_path, textureId);
+    }
+    else
+    {
+        textureId = m_textures.at(t_path);
+    }
+
+    SG_OGL_CORE_ASSERT(textureId, "[TextureManager::GetHeightmapIdFromPixels()] Invalid texture Id.");
+
+    return textureId;
+}
+
 uint32_t sg::ogl::resource::TextureManager::GetTextureId(const std::string& t_name)
 {
     uint32_t textureId;
@@ -331,6 +396,33 @@ void sg::ogl::resource::TextureManager::Load16BitHeightmap(const std::string& t_
     }
 }
 
+void sg::ogl::resource::TextureManager::LoadHeightmapFromPixels(const std::string& t_path, const HeightmapPixels& t_pixels, const uint32_t t_textureId)
+{
+    SG_OGL_CORE_ASSERT(t_textureId, "[TextureManager::LoadHeightmapFromPixels()] Invalid texture Id.");
+    SG_OGL_CORE_ASSERT(t_pixels.values.size() == static_cast<size_t>(t_pixels.width) * t_pixels.height, "[TextureManager::LoadHeightmapFromPixels()] Invalid number of pixels.");
+
+    Meta meta;
+    meta.nrChannels = STBI_grey;
+    meta.width = t_pixels.width;
+    meta.height = t_pixels.height;
+    m_metadata.emplace(t_path, meta);
+
+    Bind(t_textureId);
+
+    // the rows of an odd width are not 4 byte aligned
+    GLint unpackAlignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R16, t_pixels.width, t_pixels.height, 0, GL_RED, GL_UNSIGNED_SHORT, t_pixels.values.data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+
+    UseBilinearMipmapFilter();
+    UseRepeatWrapping();
+}
+
 void sg::ogl::resource::TextureManager::LoadTextureFromDdsFile(const std::string& t_path, const uint32_t t_textureId) const
 {
     auto texture{ gli::load(t_path) };
@@ -34,6 +34,20 @@ namespace sg::ogl::resource
 
         using Metadata = std::map<std::string, Meta>;
 
+        //-------------------------------------------------
+        // Heightmap pixels
+        //-------------------------------------------------
+
+        /**
+         * @brief The red channel of a heightmap, widened to 16 bit.
+         */
+        struct HeightmapPixels
+        {
+            int width{ 0 };
+            int height{ 0 };
+            std::vector<uint16_t> values;
+        };
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -84,6 +98,24 @@ namespace sg::ogl::resource
          */
         [[nodiscard]] uint32_t Get16BitHeightmapIdFromPath(const std::string& t_path);
 
+        /**
+         * @brief Decodes the red channel of an 8-bit or 16-bit heightmap file.
+         *        8-bit values are widened to the full 16-bit range (v * 257).
+         *        There are no OpenGL calls, so this can run on a worker thread.
+         * @param t_path The file path of the heightmap.
+         * @param t_16Bit True if the file stores 16 bits per channel.
+         * @return The decoded heightmap.
+         */
+        [[nodiscard]] static HeightmapPixels DecodeHeightmap(const std::string& t_path, bool t_16Bit);
+
+        /**
+         * @brief Get a single channel 16-bit texture handle for already decoded heightmap pixels.
+         * @param t_path The file path of the heightmap; used as the name of the texture.
+         * @param t_pixels The decoded heightmap.
+         * @return The texture handle.
+         */
+        [[nodiscard]] uint32_t GetHeightmapIdFromPixels(const std::string& t_path, const HeightmapPixels& t_pixels);
+
         /**
          * @brief Get the texture handle for the given name.
          * @param t_name The name of the texture.
@@ -185,6 +217,7 @@ namespace sg::ogl::resource
 
         void LoadTextureFromFile(const std::string& t_path, uint32_t t_textureId, bool t_flipVertically);
         void Load16BitHeightmap(const std::string& t_path, uint32_t t_textureId);
+        void LoadHeightmapFromPixels(const std::string& t_path, const HeightmapPixels& t_pixels, uint32_t t_textureId);
         void LoadTextureFromDdsFile(const std::string& t_path, uint32_t t_textureId) const;
 
         static void LoadTextureFromFile(const std::vector<std::string>& t_pathNames, uint32_t t_textureId);
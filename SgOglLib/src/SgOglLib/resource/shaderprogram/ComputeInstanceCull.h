@@ -0,0 +1,43 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ComputeInstanceCull.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include "resource/ShaderProgram.h"
+#include "resource/GpuInstanceCuller.h"
+
+namespace sg::ogl::resource::shaderprogram
+{
+    class ComputeInstanceCull : public ShaderProgram
+    {
+    public:
+        void UpdateUniforms(const GpuInstanceCuller& t_gpuInstanceCuller) override
+        {
+            SetUniform("numInstances", static_cast<int32_t>(t_gpuInstanceCuller.GetNumberOfInstances()));
+            SetUniform("frustumPlanes", t_gpuInstanceCuller.frustumPlanes);
+            SetUniform("cameraPosition", t_gpuInstanceCuller.cameraPosition);
+            SetUniform("maxDistance", t_gpuInstanceCuller.maxDistance);
+        }
+
+        [[nodiscard]] std::string GetFolderName() const override
+        {
+            return "instance_cull";
+        }
+
+        [[nodiscard]] bool IsBuiltIn() const override
+        {
+            return true;
+        }
+
+    protected:
+
+    private:
+
+    };
+}
@@ -0,0 +1,50 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ComputeParticleEmit.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <algorithm>
+#include "resource/ShaderProgram.h"
+#include "particle/ParticleSystem.h"
+#include "particle/GpuParticleStore.h"
+
+namespace sg::ogl::resource::shaderprogram
+{
+    class ComputeParticleEmit : public ShaderProgram
+    {
+    public:
+        void UpdateUniforms(const particle::ParticleSystem& t_particleSystem) override
+        {
+            const auto& gpuStore{ t_particleSystem.GetGpuStore() };
+
+            SetUniform("emitCount", static_cast<int32_t>(gpuStore.GetEmitCount()));
+            SetUniform("emitCenter", gpuStore.GetEmitCenter());
+            SetUniform("seed", static_cast<int32_t>(gpuStore.GetSeed()));
+            SetUniform("capacity", static_cast<int32_t>(std::min(gpuStore.GetCapacity(), t_particleSystem.GetLodCapacity())));
+            SetUniform("outIndex", static_cast<int32_t>(gpuStore.GetCurrentIndex()));
+            SetUniform("speed", t_particleSystem.GetSpeed());
+            SetUniform("lifeTime", t_particleSystem.GetLifeTime());
+        }
+
+        [[nodiscard]] std::string GetFolderName() const override
+        {
+            return "particle_emit";
+        }
+
+        [[nodiscard]] bool IsBuiltIn() const override
+        {
+            return true;
+        }
+
+    protected:
+
+    private:
+
+    };
+}
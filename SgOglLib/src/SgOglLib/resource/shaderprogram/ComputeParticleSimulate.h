@@ -0,0 +1,46 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ComputeParticleSimulate.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include "resource/ShaderProgram.h"
+#include "particle/ParticleSystem.h"
+#include "particle/GpuParticleStore.h"
+
+namespace sg::ogl::resource::shaderprogram
+{
+    class ComputeParticleSimulate : public ShaderProgram
+    {
+    public:
+        void UpdateUniforms(const particle::ParticleSystem& t_particleSystem) override
+        {
+            const auto& gpuStore{ t_particleSystem.GetGpuStore() };
+
+            SetUniform("dt", gpuStore.GetTimeStep());
+            SetUniform("gravity", particle::ParticleSystem::GRAVITY * t_particleSystem.GetGravityEffect());
+            SetUniform("inIndex", static_cast<int32_t>(gpuStore.GetCurrentIndex()));
+            SetUniform("outIndex", static_cast<int32_t>(gpuStore.GetNextIndex()));
+        }
+
+        [[nodiscard]] std::string GetFolderName() const override
+        {
+            return "particle_simulate";
+        }
+
+        [[nodiscard]] bool IsBuiltIn() const override
+        {
+            return true;
+        }
+
+    protected:
+
+    private:
+
+    };
+}
@@ -0,0 +1,37 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ImpostorBakeShaderProgram.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include "resource/ShaderProgram.h"
+
+namespace sg::ogl::resource::shaderprogram
+{
+    /**
+     * @brief The uniforms are set by the Impostor while baking.
+     */
+    class ImpostorBakeShaderProgram : public ShaderProgram
+    {
+    public:
+        [[nodiscard]] std::string GetFolderName() const override
+        {
+            return "impostor_bake";
+        }
+
+        [[nodiscard]] bool IsBuiltIn() const override
+        {
+            return true;
+        }
+
+    protected:
+
+    private:
+
+    };
+}
@@ -0,0 +1,74 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: ImpostorShaderProgram.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include "OpenGl.h"
+#include "Application.h"
+#include "Window.h"
+#include "scene/Scene.h"
+#include "camera/Camera.h"
+#include "resource/Impostor.h"
+#include "resource/ShaderProgram.h"
+#include "resource/TextureManager.h"
+#include "ecs/component/Components.h"
+
+namespace sg::ogl::resource::shaderprogram
+{
+    class ImpostorShaderProgram : public ShaderProgram
+    {
+    public:
+        void UpdateUniforms(
+            const scene::Scene& t_scene,
+            const entt::entity t_entity,
+            const Mesh& t_currentMesh,
+            const std::vector<light::PointLight>& t_pointLights,
+            const std::vector<light::DirectionalLight>& t_directionalLights
+        ) override
+        {
+            auto& modelInstancesComponent{ t_scene.GetApplicationContext()->registry.get<ecs::component::ModelInstancesComponent>(t_entity) };
+            const auto& impostor{ *modelInstancesComponent.impostor };
+
+            SetUniform("projectionMatrix", t_scene.GetApplicationContext()->GetWindow().GetProjectionMatrix());
+            SetUniform("viewMatrix", t_scene.GetCurrentCamera().GetViewMatrix());
+            SetUniform("cameraPosition", t_scene.GetCurrentCamera().GetPosition());
+
+            SetUniform("origin", impostor.GetOrigin());
+            SetUniform("size", impostor.GetSize());
+            SetUniform("numberOfViews", static_cast<float>(impostor.GetNumberOfViews()));
+
+            // the point lights are ignored at impostor range
+            SetUniform("numDirectionalLights", static_cast<int32_t>(t_directionalLights.size()));
+            if (!t_directionalLights.empty())
+            {
+                SetUniform("directionalLights", t_directionalLights);
+            }
+
+            SetUniform("ambientIntensity", t_scene.GetAmbientIntensity());
+
+            SetUniform("impostorMap", 0);
+            TextureManager::BindForReading(impostor.GetTextureId(), GL_TEXTURE0);
+        }
+
+        [[nodiscard]] std::string GetFolderName() const override
+        {
+            return "impostor";
+        }
+
+        [[nodiscard]] bool IsBuiltIn() const override
+        {
+            return true;
+        }
+
+    protected:
+
+    private:
+
+    };
+}
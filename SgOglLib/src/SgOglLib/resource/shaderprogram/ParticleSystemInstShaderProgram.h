@@ -10,7 +10,7 @@
 #pragma once
 
 #include "resource/ShaderProgram.h"
-#include "particle/ParticleSystem.h"
+#include "particle/ParticleBatch.h"
 
 namespace sg::ogl::resource::shaderprogram
 {
@@ -19,12 +19,13 @@ namespace sg::ogl::resource::shaderprogram
     public:
         void UpdateUniforms(const scene::Scene& t_scene, entt::entity t_entity, void* t_object) override
         {
-            auto& particleSystemComponent{ t_scene.GetApplicationContext()->registry.get<ecs::component::ParticleSystemComponent>(t_entity) };
+            // the instances of all systems of a batch are drawn at once; the entity is not used
+            auto* batch{ static_cast<particle::ParticleBatch*>(t_object) };
 
             SetUniform("projectionMatrix", t_scene.GetApplicationContext()->GetWindow().GetProjectionMatrix());
-            SetUniform("textureRows", particleSystemComponent.particleSystem->GetTextureRows());
+            SetUniform("viewMatrix", t_scene.GetCurrentCamera().GetViewMatrix());
             SetUniform("particleTexture", 0);
-            TextureManager::BindForReading(particleSystemComponent.particleSystem->GetTextureId(), GL_TEXTURE0);
+            TextureManager::BindForReading(batch->GetTextureId(), GL_TEXTURE0);
         }
 
         [[nodiscard]] std::string GetFolderName() const override
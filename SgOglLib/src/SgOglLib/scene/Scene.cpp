@@ -17,6 +17,7 @@
 #include "ecs/component/Components.h"
 #include "ecs/system/WaterRenderSystem.h"
 #include "particle/ParticleSystem.h"
+#include "terrain/TerrainConfig.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -66,6 +67,11 @@ glm::vec3 sg::ogl::scene::Scene::GetAmbientIntensity() const
     return m_ambientIntensity;
 }
 
+uint32_t sg::ogl::scene::Scene::GetParticleBudget() const noexcept
+{
+    return m_particleBudget;
+}
+
 //-------------------------------------------------
 // Setter
 //-------------------------------------------------
@@ -107,6 +113,11 @@ void sg::ogl::scene::Scene::SetAmbientIntensity(const glm::vec3& t_ambientIntens
     m_ambientIntensity = t_ambientIntensity;
 }
 
+void sg::ogl::scene::Scene::SetParticleBudget(const uint32_t t_particleBudget)
+{
+    m_particleBudget = t_particleBudget;
+}
+
 //-------------------------------------------------
 // Logic
 //-------------------------------------------------
@@ -131,6 +142,13 @@ void sg::ogl::scene::Scene::Input()
 void sg::ogl::scene::Scene::Update(const double t_dt)
 {
     GetCurrentCamera().Update(t_dt);
+    GetCurrentCamera().UpdateFrustumPlanes();
+
+    // the tiles of a TiledHeightmap are read by the height queries and the lod selection of the terrain
+    if (terrainConfig)
+    {
+        terrainConfig->UpdateTiles(GetCurrentCamera().GetPosition());
+    }
 
     // run the update function of all renderers
     for (auto& r : renderer)
@@ -138,6 +156,9 @@ void sg::ogl::scene::Scene::Update(const double t_dt)
         r->Update(t_dt);
     }
 
+    // the particles which survived the update count against the budget
+    UpdateParticleBudget();
+
     // run the update components
     if (m_parentLuaState)
     {
@@ -175,3 +196,28 @@ void sg::ogl::scene::Scene::Render()
         r->FinishRendering();
     }
 }
+
+uint32_t sg::ogl::scene::Scene::RequestParticles(const uint32_t t_count) const
+{
+    return std::min(t_count, m_remainingParticles);
+}
+
+void sg::ogl::scene::Scene::ConsumeParticles(const uint32_t t_count)
+{
+    m_remainingParticles -= std::min(t_count, m_remainingParticles);
+}
+
+//-------------------------------------------------
+// Particles
+//-------------------------------------------------
+
+void sg::ogl::scene::Scene::UpdateParticleBudget()
+{
+    uint32_t aliveCount{ 0 };
+    for (const auto& particleSystem : particleSystems)
+    {
+        aliveCount += particleSystem.second->GetEstimatedAliveCount();
+    }
+
+    m_remainingParticles = aliveCount < m_particleBudget ? m_particleBudget - aliveCount : 0;
+}
@@ -61,6 +61,11 @@ namespace sg::ogl::scene
         using TerrainSharedPtr = std::shared_ptr<terrain::TerrainQuadtree>;
         using TerrainConfigSharedPtr = std::shared_ptr<terrain::TerrainConfig>;
 
+        /**
+         * @brief The default max number of living particles of all ParticleSystems.
+         */
+        static constexpr uint32_t DEFAULT_PARTICLE_BUDGET{ 100000 };
+
         //-------------------------------------------------
         // Public member
         //-------------------------------------------------
@@ -98,6 +103,7 @@ namespace sg::ogl::scene
 
         [[nodiscard]] glm::vec4 GetCurrentClipPlane() const;
         [[nodiscard]] glm::vec3 GetAmbientIntensity() const;
+        [[nodiscard]] uint32_t GetParticleBudget() const noexcept;
 
         //-------------------------------------------------
         // Setter
@@ -110,6 +116,12 @@ namespace sg::ogl::scene
         void SetCurrentClipPlane(const glm::vec4& t_currentClipPlane);
         void SetAmbientIntensity(const glm::vec3& t_ambientIntensity);
 
+        /**
+         * @brief Set the max number of living particles of all ParticleSystems.
+         * @param t_particleBudget The max number of living particles.
+         */
+        void SetParticleBudget(uint32_t t_particleBudget);
+
         //-------------------------------------------------
         // Logic
         //-------------------------------------------------
@@ -118,6 +130,20 @@ namespace sg::ogl::scene
         void Update(double t_dt);
         void Render();
 
+        /**
+         * @brief Asks for new particles from the particle budget of the current frame.
+         *        The budget is not changed; see ConsumeParticles().
+         * @param t_count The number of particles a ParticleSystem wants to emit.
+         * @return The number of particles that may be emitted.
+         */
+        [[nodiscard]] uint32_t RequestParticles(uint32_t t_count) const;
+
+        /**
+         * @brief Takes the actually emitted particles from the particle budget of the current frame.
+         * @param t_count The number of emitted particles.
+         */
+        void ConsumeParticles(uint32_t t_count);
+
     protected:
 
     private:
@@ -129,5 +155,18 @@ namespace sg::ogl::scene
 
         glm::vec4 m_currentClipPlane{ glm::vec4(0.0f, -1.0f, 0.0f, 100000.0f) };
         glm::vec3 m_ambientIntensity{ glm::vec3(0.3f) };
+
+        uint32_t m_particleBudget{ DEFAULT_PARTICLE_BUDGET };
+
+        /**
+         * @brief The number of particles that can still be emitted in the current frame.
+         */
+        uint32_t m_remainingParticles{ DEFAULT_PARTICLE_BUDGET };
+
+        //-------------------------------------------------
+        // Particles
+        //-------------------------------------------------
+
+        void UpdateParticleBudget();
     };
 }
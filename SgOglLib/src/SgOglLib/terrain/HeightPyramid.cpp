@@ -0,0 +1,197 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: HeightPyramid.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <algorithm>
+#include "HeightPyramid.h"
+#include "Core.h"
+
+namespace
+{
+    // the min/max of 2 x 2 source cells for each cell of the next level
+    template <typename T, typename U>
+    void Reduce(
+        const std::vector<T>& t_srcMin, const std::vector<T>& t_srcMax, const int t_srcWidth,
+        std::vector<U>& t_min, std::vector<U>& t_max, const int t_width, const U t_scale
+    )
+    {
+        for (auto z{ 0 }; z < t_width; ++z)
+        {
+            const auto z0{ z * 2 };
+            const auto z1{ std::min(z0 + 1, t_srcWidth - 1) };
+
+            for (auto x{ 0 }; x < t_width; ++x)
+            {
+                const auto x0{ x * 2 };
+                const auto x1{ std::min(x0 + 1, t_srcWidth - 1) };
+
+                const auto min{ std::min(
+                    std::min(t_srcMin[static_cast<size_t>(z0) * t_srcWidth + x0], t_srcMin[static_cast<size_t>(z0) * t_srcWidth + x1]),
+                    std::min(t_srcMin[static_cast<size_t>(z1) * t_srcWidth + x0], t_srcMin[static_cast<size_t>(z1) * t_srcWidth + x1])
+                ) };
+
+                const auto max{ std::max(
+                    std::max(t_srcMax[static_cast<size_t>(z0) * t_srcWidth + x0], t_srcMax[static_cast<size_t>(z0) * t_srcWidth + x1]),
+                    std::max(t_srcMax[static_cast<size_t>(z1) * t_srcWidth + x0], t_srcMax[static_cast<size_t>(z1) * t_srcWidth + x1])
+                ) };
+
+                t_min[static_cast<size_t>(z) * t_width + x] = static_cast<U>(min) * t_scale;
+                t_max[static_cast<size_t>(z) * t_width + x] = static_cast<U>(max) * t_scale;
+            }
+        }
+    }
+}
+
+//-------------------------------------------------
+// Build
+//-------------------------------------------------
+
+void sg::ogl::terrain::HeightPyramid::Build(const std::vector<uint16_t>& t_heights, const int t_width, const float t_normalization)
+{
+    SG_OGL_CORE_ASSERT(t_width > 0, "[HeightPyramid::Build()] Invalid width.");
+    SG_OGL_CORE_ASSERT(t_heights.size() == static_cast<size_t>(t_width) * t_width, "[HeightPyramid::Build()] Invalid number of heights.");
+
+    m_heightmapWidth = t_width;
+    m_cellSize = 1;
+
+    BuildLevels(t_heights, t_heights, t_width, t_normalization);
+}
+
+void sg::ogl::terrain::HeightPyramid::BuildFromTiles(
+    const std::vector<uint16_t>& t_tileRanges,
+    const int t_tilesPerRow,
+    const int t_tileSize,
+    const int t_width,
+    const float t_normalization
+)
+{
+    SG_OGL_CORE_ASSERT(t_tilesPerRow > 0 && t_tileSize > 0, "[HeightPyramid::BuildFromTiles()] Invalid tiles.");
+    SG_OGL_CORE_ASSERT(t_tileRanges.size() == static_cast<size_t>(t_tilesPerRow) * t_tilesPerRow * 2, "[HeightPyramid::BuildFromTiles()] Invalid number of tile ranges.");
+
+    m_heightmapWidth = t_width;
+    m_cellSize = t_tileSize;
+
+    const auto nrTiles{ static_cast<size_t>(t_tilesPerRow) * t_tilesPerRow };
+    std::vector<uint16_t> tileMin(nrTiles);
+    std::vector<uint16_t> tileMax(nrTiles);
+    for (auto i{ 0u }; i < nrTiles; ++i)
+    {
+        tileMin[i] = t_tileRanges[i * 2];
+        tileMax[i] = t_tileRanges[i * 2 + 1];
+    }
+
+    BuildLevels(tileMin, tileMax, t_tilesPerRow, t_normalization);
+}
+
+void sg::ogl::terrain::HeightPyramid::BuildLevels(const std::vector<uint16_t>& t_min, const std::vector<uint16_t>& t_max, const int t_baseWidth, const float t_normalization)
+{
+    m_widths.clear();
+    m_min.clear();
+    m_max.clear();
+
+    // the first level reads the 16-bit base cells for min and max and normalizes the result
+    auto srcWidth{ t_baseWidth };
+
+    do
+    {
+        const auto width{ (srcWidth + 1) / 2 };
+
+        LevelContainer levelMin(static_cast<size_t>(width) * width);
+        LevelContainer levelMax(static_cast<size_t>(width) * width);
+
+        if (m_widths.empty())
+        {
+            Reduce(t_min, t_max, srcWidth, levelMin, levelMax, width, t_normalization);
+        }
+        else
+        {
+            Reduce(m_min.back(), m_max.back(), srcWidth, levelMin, levelMax, width, 1.0f);
+        }
+
+        m_widths.push_back(width);
+        m_min.push_back(std::move(levelMin));
+        m_max.push_back(std::move(levelMax));
+
+        srcWidth = width;
+    }
+    while (srcWidth > 1);
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[HeightPyramid::BuildLevels()] Created {} levels.", m_widths.size());
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+bool sg::ogl::terrain::HeightPyramid::IsEmpty() const noexcept
+{
+    return m_widths.empty();
+}
+
+int sg::ogl::terrain::HeightPyramid::GetNumberOfLevels() const noexcept
+{
+    return static_cast<int>(m_widths.size());
+}
+
+int sg::ogl::terrain::HeightPyramid::GetLevelWidth(const int t_level) const
+{
+    return m_widths[t_level];
+}
+
+float sg::ogl::terrain::HeightPyramid::GetMin(const int t_level, const int t_x, const int t_z) const
+{
+    return m_min[t_level][static_cast<size_t>(t_z) * m_widths[t_level] + t_x];
+}
+
+float sg::ogl::terrain::HeightPyramid::GetMax(const int t_level, const int t_x, const int t_z) const
+{
+    return m_max[t_level][static_cast<size_t>(t_z) * m_widths[t_level] + t_x];
+}
+
+//-------------------------------------------------
+// Query
+//-------------------------------------------------
+
+void sg::ogl::terrain::HeightPyramid::GetRange(int t_x0, int t_z0, int t_x1, int t_z1, float& t_min, float& t_max) const
+{
+    SG_OGL_CORE_ASSERT(!IsEmpty(), "[HeightPyramid::GetRange()] The pyramid was not built.");
+
+    const auto last{ m_heightmapWidth - 1 };
+    t_x0 = std::clamp(t_x0, 0, last);
+    t_z0 = std::clamp(t_z0, 0, last);
+    t_x1 = std::clamp(t_x1, t_x0, last);
+    t_z1 = std::clamp(t_z1, t_z0, last);
+
+    // texels -> base cells
+    t_x0 /= m_cellSize;
+    t_z0 /= m_cellSize;
+    t_x1 /= m_cellSize;
+    t_z1 /= m_cellSize;
+
+    // the first level on which the rectangle touches at most 2 x 2 cells
+    auto level{ 0 };
+    while (level < GetNumberOfLevels() - 1 &&
+        ((t_x1 >> (level + 1)) - (t_x0 >> (level + 1)) > 1 || (t_z1 >> (level + 1)) - (t_z0 >> (level + 1)) > 1))
+    {
+        ++level;
+    }
+
+    const auto shift{ level + 1 };
+
+    t_min = GetMin(level, t_x0 >> shift, t_z0 >> shift);
+    t_max = GetMax(level, t_x0 >> shift, t_z0 >> shift);
+
+    for (auto z{ t_z0 >> shift }; z <= t_z1 >> shift; ++z)
+    {
+        for (auto x{ t_x0 >> shift }; x <= t_x1 >> shift; ++x)
+        {
+            t_min = std::min(t_min, GetMin(level, x, z));
+            t_max = std::max(t_max, GetMax(level, x, z));
+        }
+    }
+}
@@ -0,0 +1,92 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: HeightPyramid.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace sg::ogl::terrain
+{
+    /**
+     * @brief A min/max mip chain of a heightmap. A cell of level k covers 2^(k+1) x 2^(k+1) base cells.
+     *        A base cell is a texel, or a tile if the pyramid is built from the tile ranges of a
+     *        TiledHeightmap. Answers the height range of any texel rectangle with at most 2 x 2 cell reads.
+     */
+    class HeightPyramid
+    {
+    public:
+        using LevelContainer = std::vector<float>;
+
+        //-------------------------------------------------
+        // Build
+        //-------------------------------------------------
+
+        /**
+         * @brief Creates all levels from the heightmap.
+         * @param t_heights The 16-bit heightmap values, row by row.
+         * @param t_width The width and height of the heightmap.
+         * @param t_normalization The levels store t_heights * t_normalization.
+         */
+        void Build(const std::vector<uint16_t>& t_heights, int t_width, float t_normalization);
+
+        /**
+         * @brief Creates all levels from the min/max height of each tile. The ranges are
+         *        conservative for any rectangle, but only as exact as the tiles.
+         * @param t_tileRanges The 16-bit min and max height of each tile, row by row.
+         * @param t_tilesPerRow The number of tiles per row.
+         * @param t_tileSize The width and height of a tile in texels.
+         * @param t_width The width and height of the heightmap.
+         * @param t_normalization The levels store the heights * t_normalization.
+         */
+        void BuildFromTiles(const std::vector<uint16_t>& t_tileRanges, int t_tilesPerRow, int t_tileSize, int t_width, float t_normalization);
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] bool IsEmpty() const noexcept;
+        [[nodiscard]] int GetNumberOfLevels() const noexcept;
+        [[nodiscard]] int GetLevelWidth(int t_level) const;
+
+        [[nodiscard]] float GetMin(int t_level, int t_x, int t_z) const;
+        [[nodiscard]] float GetMax(int t_level, int t_x, int t_z) const;
+
+        //-------------------------------------------------
+        // Query
+        //-------------------------------------------------
+
+        /**
+         * @brief The conservative height range of a texel rectangle.
+         * @param t_x0 The first column.
+         * @param t_z0 The first row.
+         * @param t_x1 The last column.
+         * @param t_z1 The last row.
+         * @param t_min Receives the min height.
+         * @param t_max Receives the max height.
+         */
+        void GetRange(int t_x0, int t_z0, int t_x1, int t_z1, float& t_min, float& t_max) const;
+
+    protected:
+
+    private:
+        int m_heightmapWidth{ 0 };
+
+        /**
+         * @brief The number of texels per row of a base cell.
+         */
+        int m_cellSize{ 1 };
+
+        std::vector<int> m_widths;
+        std::vector<LevelContainer> m_min;
+        std::vector<LevelContainer> m_max;
+
+        void BuildLevels(const std::vector<uint16_t>& t_min, const std::vector<uint16_t>& t_max, int t_baseWidth, float t_normalization);
+    };
+}
@@ -9,121 +9,66 @@
 
 #pragma once
 
-#include <vector>
-#include <memory>
-#include "math/Transform.h"
-#include "light/DirectionalLight.h"
-
-namespace sg::ogl::resource
-{
-    class Mesh;
-    class ShaderProgram;
-}
-
-namespace sg::ogl::scene
-{
-    class Scene;
-}
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
 
 namespace sg::ogl::terrain
 {
-    class TerrainConfig;
-
-    class Node
+    /**
+     * @brief A node of the TerrainQuadtree. The nodes live in a NodePool; the four
+     *        children of a node are stored one after another in the next lod level.
+     */
+    struct Node
     {
-    public:
-        using NodeUniquePtr = std::unique_ptr<Node>;
-        using MeshSharedPtr = std::shared_ptr<resource::Mesh>;
-        using TerrainConfigSharedPtr = std::shared_ptr<TerrainConfig>;
-
-        //-------------------------------------------------
-        // Ctors. / Dtor.
-        //-------------------------------------------------
-
-        Node(
-            scene::Scene* t_scene,
-            const TerrainConfigSharedPtr& t_terrainConfig,
-            int t_lod,
-            const glm::vec2& t_location,
-            const glm::vec2& t_index
-        );
-
-        Node(const Node& t_other) = delete;
-        Node(Node&& t_other) noexcept = delete;
-        Node& operator=(const Node& t_other) = delete;
-        Node& operator=(Node&& t_other) noexcept = delete;
-
-        virtual ~Node() noexcept = default;
-
-        //-------------------------------------------------
-        // Getter
-        //-------------------------------------------------
-
-        [[nodiscard]] float GetHeightAt(float t_x, float t_z) const;
-
-        //-------------------------------------------------
-        // Logic
-        //-------------------------------------------------
-
-        void Render(resource::ShaderProgram& t_shaderProgram, const MeshSharedPtr& t_patchMesh, const std::vector<light::DirectionalLight>& t_directionalLights);
-        void RenderWireframe(resource::ShaderProgram& t_shaderProgram, const MeshSharedPtr& t_patchMesh);
-        void Update();
-
-        //-------------------------------------------------
-        // Debug
-        //-------------------------------------------------
-
-        void NodesCount(int& t_value)
+        static constexpr uint32_t INVALID_INDEX{ 0xFFFFFFFF };
+
+        /**
+         * @brief The position in terrain space [0, 1].
+         */
+        glm::vec2 location{ glm::vec2(0.0f) };
+
+        /**
+         * @brief The position in the parent node (0 or 1 per axis).
+         */
+        glm::vec2 index{ glm::vec2(0.0f) };
+
+        /**
+         * @brief The center in world space; used for the lod selection.
+         */
+        glm::vec3 center{ glm::vec3(0.0f) };
+
+        /**
+         * @brief The world space bounding box; the heights come from the heightmap values below the node.
+         */
+        glm::vec3 aabbMin{ glm::vec3(0.0f) };
+        glm::vec3 aabbMax{ glm::vec3(0.0f) };
+
+        /**
+         * @brief The size in terrain space.
+         */
+        float gap{ 1.0f };
+
+        int lod{ 0 };
+
+        /**
+         * @brief The index of the first child in the next lod level.
+         */
+        uint32_t firstChild{ INVALID_INDEX };
+
+        /**
+         * @brief The camera odometer value up to which the lod of the subtree cannot change.
+         */
+        float nextUpdate{ 0.0f };
+
+        /**
+         * @brief The index in the leaf list of the chunk; only valid for leaves.
+         */
+        uint32_t leafSlot{ INVALID_INDEX };
+
+        [[nodiscard]] bool IsLeaf() const noexcept
         {
-            for (const auto& child : m_children)
-            {
-                t_value++;
-                child->NodesCount(t_value);
-            }
+            return firstChild == INVALID_INDEX;
         }
-
-        //-------------------------------------------------
-        // Add / Remove
-        //-------------------------------------------------
-
-        void AddChild(NodeUniquePtr t_child);
-
-    protected:
-        std::vector<NodeUniquePtr> m_children;
-
-        scene::Scene* m_scene{ nullptr };
-
-        TerrainConfigSharedPtr m_terrainConfig;
-
-    private:
-        Node* m_parent{ nullptr };
-
-        int m_lod{ 0 };
-
-        glm::vec2 m_location{ glm::vec2(0.0f) };
-        glm::vec2 m_index{ glm::vec2(0.0f) };
-        glm::vec3 m_center{ glm::vec3(0.0f) };
-
-        bool m_isLeaf{ true };
-
-        float m_gap{ 1.0f };
-
-        math::Transform m_localTransform;
-        math::Transform m_worldTransform;
-
-        glm::vec3 m_color{ glm::vec3(0.0f, 1.0f, 0.0f) };
-
-        //-------------------------------------------------
-        // Add / Remove
-        //-------------------------------------------------
-
-        void Add4Children(int t_lod);
-        void RemoveChildren();
-
-        //-------------------------------------------------
-        // Helper
-        //-------------------------------------------------
-
-        void ComputeCenterPosition();
     };
 }
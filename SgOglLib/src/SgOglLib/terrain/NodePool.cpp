@@ -0,0 +1,130 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: NodePool.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include "NodePool.h"
+#include "Core.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+sg::ogl::terrain::NodePool::NodePool(const int t_nrLods, const uint32_t t_nrRootNodes)
+    : m_nrRootNodes{ t_nrRootNodes }
+{
+    SG_OGL_CORE_ASSERT(t_nrLods > 0, "[NodePool::NodePool()] Invalid value.");
+    SG_OGL_CORE_ASSERT(t_nrRootNodes > 0, "[NodePool::NodePool()] Invalid value.");
+
+    m_levels.resize(t_nrLods);
+    m_freeBlocks.resize(t_nrLods);
+
+    m_levels[0].resize(t_nrRootNodes);
+
+    for (auto lod{ 1 }; lod < t_nrLods; ++lod)
+    {
+        Grow(lod, INITIAL_BLOCKS_PER_LOD);
+    }
+
+    // the preallocation is not counted
+    m_growths = 0;
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+sg::ogl::terrain::Node& sg::ogl::terrain::NodePool::Get(const int t_lod, const uint32_t t_index)
+{
+    return m_levels[t_lod][t_index];
+}
+
+const sg::ogl::terrain::Node& sg::ogl::terrain::NodePool::Get(const int t_lod, const uint32_t t_index) const
+{
+    return m_levels[t_lod][t_index];
+}
+
+int sg::ogl::terrain::NodePool::GetNumberOfLods() const noexcept
+{
+    return static_cast<int>(m_levels.size());
+}
+
+uint32_t sg::ogl::terrain::NodePool::GetNumberOfRootNodes() const noexcept
+{
+    return m_nrRootNodes;
+}
+
+uint32_t sg::ogl::terrain::NodePool::GetNumberOfNodes() const noexcept
+{
+    auto count{ m_nrRootNodes };
+    for (auto lod{ 1u }; lod < m_levels.size(); ++lod)
+    {
+        count += static_cast<uint32_t>(m_levels[lod].size() - m_freeBlocks[lod].size() * 4);
+    }
+
+    return count;
+}
+
+uint32_t sg::ogl::terrain::NodePool::GetNumberOfGrowths() const noexcept
+{
+    return m_growths;
+}
+
+//-------------------------------------------------
+// Allocate / Free
+//-------------------------------------------------
+
+uint32_t sg::ogl::terrain::NodePool::Allocate4(const int t_lod)
+{
+    SG_OGL_CORE_ASSERT(t_lod > 0 && t_lod < GetNumberOfLods(), "[NodePool::Allocate4()] Invalid lod.");
+
+    auto& freeBlocks{ m_freeBlocks[t_lod] };
+    if (freeBlocks.empty())
+    {
+        Grow(t_lod, static_cast<uint32_t>(m_levels[t_lod].size() / 4));
+    }
+
+    const auto block{ freeBlocks.back() };
+    freeBlocks.pop_back();
+
+    return block * 4;
+}
+
+void sg::ogl::terrain::NodePool::Free4(const int t_lod, const uint32_t t_first)
+{
+    SG_OGL_CORE_ASSERT(t_lod > 0 && t_lod < GetNumberOfLods(), "[NodePool::Free4()] Invalid lod.");
+    SG_OGL_CORE_ASSERT(t_first % 4 == 0, "[NodePool::Free4()] Invalid index.");
+
+    // the capacity of the free list is the number of blocks, so this never allocates
+    m_freeBlocks[t_lod].push_back(t_first / 4);
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void sg::ogl::terrain::NodePool::Grow(const int t_lod, const uint32_t t_nrBlocks)
+{
+    auto& nodes{ m_levels[t_lod] };
+    auto& freeBlocks{ m_freeBlocks[t_lod] };
+
+    const auto oldBlocks{ static_cast<uint32_t>(nodes.size() / 4) };
+    const auto newBlocks{ oldBlocks + t_nrBlocks };
+
+    nodes.resize(static_cast<size_t>(newBlocks) * 4);
+    freeBlocks.reserve(newBlocks);
+
+    // the lowest block is taken first
+    for (auto block{ newBlocks }; block > oldBlocks; --block)
+    {
+        freeBlocks.push_back(block - 1);
+    }
+
+    ++m_growths;
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[NodePool::Grow()] Lod {} holds {} nodes now.", t_lod, nodes.size());
+}
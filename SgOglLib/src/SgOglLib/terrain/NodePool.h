@@ -0,0 +1,108 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: NodePool.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <vector>
+#include "Node.h"
+
+namespace sg::ogl::terrain
+{
+    /**
+     * @brief Holds the nodes of a TerrainQuadtree in one flat array per lod level.
+     *        The root nodes are the first level. In all other levels, nodes are allocated
+     *        in blocks of four siblings, which are recycled through a free list. The pool
+     *        only allocates memory when a level runs out of blocks.
+     */
+    class NodePool
+    {
+    public:
+        using NodeContainer = std::vector<Node>;
+        using FreeListContainer = std::vector<uint32_t>;
+
+        /**
+         * @brief The number of blocks of four nodes, which are preallocated per lod level.
+         */
+        static constexpr uint32_t INITIAL_BLOCKS_PER_LOD{ 64 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        NodePool() = delete;
+
+        /**
+         * @brief Creates the pool.
+         * @param t_nrLods The number of lod levels.
+         * @param t_nrRootNodes The number of nodes in the first level.
+         */
+        NodePool(int t_nrLods, uint32_t t_nrRootNodes);
+
+        NodePool(const NodePool& t_other) = delete;
+        NodePool(NodePool&& t_other) noexcept = delete;
+        NodePool& operator=(const NodePool& t_other) = delete;
+        NodePool& operator=(NodePool&& t_other) noexcept = delete;
+
+        ~NodePool() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] Node& Get(int t_lod, uint32_t t_index);
+        [[nodiscard]] const Node& Get(int t_lod, uint32_t t_index) const;
+
+        [[nodiscard]] int GetNumberOfLods() const noexcept;
+        [[nodiscard]] uint32_t GetNumberOfRootNodes() const noexcept;
+
+        /**
+         * @brief The number of nodes in use.
+         */
+        [[nodiscard]] uint32_t GetNumberOfNodes() const noexcept;
+
+        /**
+         * @brief How often a lod level ran out of blocks and had to grow.
+         *        Stays constant in the steady state.
+         */
+        [[nodiscard]] uint32_t GetNumberOfGrowths() const noexcept;
+
+        //-------------------------------------------------
+        // Allocate / Free
+        //-------------------------------------------------
+
+        /**
+         * @brief Takes a block of four nodes from a level. References into other levels stay valid.
+         * @param t_lod The level; must be greater than 0.
+         * @return The index of the first node of the block.
+         */
+        uint32_t Allocate4(int t_lod);
+
+        /**
+         * @brief Gives a block of four nodes back.
+         * @param t_lod The level; must be greater than 0.
+         * @param t_first The index of the first node of the block.
+         */
+        void Free4(int t_lod, uint32_t t_first);
+
+    protected:
+
+    private:
+        std::vector<NodeContainer> m_levels;
+        std::vector<FreeListContainer> m_freeBlocks;
+
+        uint32_t m_nrRootNodes{ 0 };
+        uint32_t m_growths{ 0 };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        void Grow(int t_lod, uint32_t t_nrBlocks);
+    };
+}
@@ -7,8 +7,15 @@
 // 
 // 2020 (c) stwe <https://github.com/stwe/SgOgl>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include "TerrainConfig.h"
+#include "TerrainMaps.h"
+#include "TiledHeightmap.h"
 #include "Application.h"
+#include "ThreadPool.h"
 #include "OpenGl.h"
 #include "Core.h"
 #include "resource/TextureManager.h"
@@ -16,6 +23,215 @@
 #include "resource/shaderprogram/ComputeNormalmap.h"
 #include "resource/shaderprogram/ComputeSplatmap.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define SG_OGL_TERRAIN_HEIGHTS_SSE
+#endif
+
+namespace
+{
+    // a ray in sample space: x and z in heightmap samples, y in heightmap units
+    struct SampleRay
+    {
+        std::array<float, 3> origin;
+        std::array<float, 3> direction;
+    };
+
+    // clips [t_tMin, t_tMax] to the part of the ray inside the box
+    bool ClipToBox(const SampleRay& t_ray, const std::array<float, 3>& t_min, const std::array<float, 3>& t_max, float& t_tMin, float& t_tMax)
+    {
+        for (auto axis{ 0 }; axis < 3; ++axis)
+        {
+            if (std::abs(t_ray.direction[axis]) < 1e-12f)
+            {
+                if (t_ray.origin[axis] < t_min[axis] || t_ray.origin[axis] > t_max[axis])
+                {
+                    return false;
+                }
+
+                continue;
+            }
+
+            const auto inverse{ 1.0f / t_ray.direction[axis] };
+            auto t0{ (t_min[axis] - t_ray.origin[axis]) * inverse };
+            auto t1{ (t_max[axis] - t_ray.origin[axis]) * inverse };
+            if (t0 > t1)
+            {
+                std::swap(t0, t1);
+            }
+
+            t_tMin = std::max(t_tMin, t0);
+            t_tMax = std::min(t_tMax, t1);
+            if (t_tMin > t_tMax)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // The bilinear patch between the samples [x, x + 1] x [z, z + 1]. Along the ray the patch height
+    // is a quadratic in t, so the first point where the ray is not above the patch is a root.
+    bool IntersectPatch(
+        const SampleRay& t_ray,
+        const sg::ogl::terrain::TerrainConfig& t_terrainConfig,
+        const int t_x,
+        const int t_z,
+        const float t_tMin,
+        const float t_tMax,
+        float& t_distance
+    )
+    {
+        const auto getValue{ [&](const int t_sampleX, const int t_sampleZ)
+        {
+            return static_cast<double>(t_terrainConfig.GetHeightmapValue(t_sampleX, t_sampleZ));
+        } };
+
+        const auto h00{ getValue(t_x, t_z) };
+        const auto a{ getValue(t_x + 1, t_z) - h00 };
+        const auto b{ getValue(t_x, t_z + 1) - h00 };
+        const auto c{ h00 - getValue(t_x + 1, t_z) - getValue(t_x, t_z + 1) + getValue(t_x + 1, t_z + 1) };
+
+        const auto fu{ static_cast<double>(t_ray.origin[0]) - t_x };
+        const auto fv{ static_cast<double>(t_ray.origin[2]) - t_z };
+        const auto du{ static_cast<double>(t_ray.direction[0]) };
+        const auto dv{ static_cast<double>(t_ray.direction[2]) };
+
+        // ray height - patch height = q2 * t^2 + q1 * t + q0
+        const auto q2{ -c * du * dv };
+        const auto q1{ t_ray.direction[1] - (a * du + b * dv + c * (fu * dv + fv * du)) };
+        const auto q0{ t_ray.origin[1] - (h00 + a * fu + b * fv + c * fu * fv) };
+
+        const auto above{ [&](const double t_t) { return (q2 * t_t + q1) * t_t + q0 > 0.0; } };
+
+        if (!above(t_tMin))
+        {
+            t_distance = t_tMin;
+            return true;
+        }
+
+        std::array<double, 2> roots{ -1.0, -1.0 };
+        if (std::abs(q2) < 1e-12)
+        {
+            if (q1 != 0.0)
+            {
+                roots[0] = -q0 / q1;
+            }
+        }
+        else
+        {
+            const auto discriminant{ q1 * q1 - 4.0 * q2 * q0 };
+            if (discriminant < 0.0)
+            {
+                return false;
+            }
+
+            // the numerically stable form
+            const auto q{ -0.5 * (q1 + std::copysign(std::sqrt(discriminant), q1)) };
+            roots[0] = q / q2;
+            roots[1] = q != 0.0 ? q0 / q : roots[0];
+        }
+
+        auto hit{ false };
+        for (const auto root : roots)
+        {
+            if (root >= t_tMin && root <= t_tMax && (!hit || root < t_distance))
+            {
+                t_distance = static_cast<float>(root);
+                hit = true;
+            }
+        }
+
+        return hit;
+    }
+
+    // visits the children front to back; a node covers size x size patches starting at x, z
+    bool RaycastNode(
+        const SampleRay& t_ray,
+        const sg::ogl::terrain::TerrainConfig& t_terrainConfig,
+        const int t_x,
+        const int t_z,
+        const int t_size,
+        float t_tMin,
+        float t_tMax,
+        float& t_distance
+    )
+    {
+        const auto last{ t_terrainConfig.GetHeightmapWidth() - 1 };
+        const auto x1{ std::min(t_x + t_size, last) };
+        const auto z1{ std::min(t_z + t_size, last) };
+
+        float minHeight;
+        float maxHeight;
+        t_terrainConfig.GetHeightPyramid().GetRange(t_x, t_z, x1, z1, minHeight, maxHeight);
+
+        // everything below the surface is solid, so the box is open at the bottom
+        const std::array<float, 3> boxMin{ static_cast<float>(t_x), std::numeric_limits<float>::lowest(), static_cast<float>(t_z) };
+        const std::array<float, 3> boxMax{ static_cast<float>(x1), maxHeight, static_cast<float>(z1) };
+        if (!ClipToBox(t_ray, boxMin, boxMax, t_tMin, t_tMax))
+        {
+            return false;
+        }
+
+        if (t_size == 1)
+        {
+            return IntersectPatch(t_ray, t_terrainConfig, t_x, t_z, t_tMin, t_tMax, t_distance);
+        }
+
+        const auto half{ t_size / 2 };
+
+        std::array<std::pair<float, std::pair<int, int>>, 4> children;
+        auto nrChildren{ 0u };
+
+        for (auto z{ t_z }; z < t_z + t_size; z += half)
+        {
+            for (auto x{ t_x }; x < t_x + t_size; x += half)
+            {
+                if (x >= last || z >= last)
+                {
+                    continue;
+                }
+
+                // the entry distance into the footprint of the child
+                auto entry{ t_tMin };
+                auto exit{ t_tMax };
+                const std::array<float, 3> footprintMin{ static_cast<float>(x), boxMin[1], static_cast<float>(z) };
+                const std::array<float, 3> footprintMax{ static_cast<float>(std::min(x + half, last)), boxMax[1], static_cast<float>(std::min(z + half, last)) };
+                if (ClipToBox(t_ray, footprintMin, footprintMax, entry, exit))
+                {
+                    children[nrChildren++] = { entry, { x, z } };
+                }
+            }
+        }
+
+        std::sort(children.begin(), children.begin() + nrChildren);
+
+        for (auto i{ 0u }; i < nrChildren; ++i)
+        {
+            if (RaycastNode(t_ray, t_terrainConfig, children[i].second.first, children[i].second.second, half, t_tMin, t_tMax, t_distance))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
+
+#if defined(SG_OGL_TERRAIN_HEIGHTS_SSE)
+
+namespace
+{
+    // four gathered 16-bit heightmap values -> [0, 1]
+    inline __m128 DecodePs(const int32_t* t_values, const __m128 t_normalization)
+    {
+        return _mm_mul_ps(_mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(t_values))), t_normalization);
+    }
+}
+
+#endif
+
 //-------------------------------------------------
 // Ctors. / Dtor.
 //-------------------------------------------------
@@ -30,6 +246,12 @@ sg::ogl::terrain::TerrainConfig::TerrainConfig(Application* t_application)
 sg::ogl::terrain::TerrainConfig::~TerrainConfig() noexcept
 {
     Log::SG_OGL_CORE_LOG_DEBUG("[TerrainConfig::~TerrainConfig()] Destruct TerrainConfig.");
+
+    // the job writes into this object
+    if (m_heightPyramidJob.valid())
+    {
+        m_heightPyramidJob.wait();
+    }
 }
 
 //-------------------------------------------------
@@ -91,6 +313,26 @@ const sg::ogl::terrain::TerrainConfig::HeightmapHeightContainer& sg::ogl::terrai
     return m_heightmapData;
 }
 
+bool sg::ogl::terrain::TerrainConfig::HasHeights() const
+{
+    return m_tiledHeightmap || !m_heightmapData.empty();
+}
+
+float sg::ogl::terrain::TerrainConfig::GetHeightmapValue(const int t_x, const int t_z) const
+{
+    if (m_tiledHeightmap)
+    {
+        return static_cast<float>(m_tiledHeightmap->GetValue(t_x, t_z)) * HEIGHTMAP_NORMALIZATION;
+    }
+
+    return static_cast<float>(m_heightmapData[static_cast<size_t>(m_heightmapWidth) * t_z + t_x]) * HEIGHTMAP_NORMALIZATION;
+}
+
+const sg::ogl::terrain::HeightPyramid& sg::ogl::terrain::TerrainConfig::GetHeightPyramid() const noexcept
+{
+    return m_heightPyramid;
+}
+
 float sg::ogl::terrain::TerrainConfig::GetHeightAt(float t_x, float t_z, float t_min, float t_max) const
 {
     auto pos{ glm::vec2(t_x, t_z) };
@@ -101,15 +343,16 @@ float sg::ogl::terrain::TerrainConfig::GetHeightAt(float t_x, float t_z, float t
     pos -= floorVec;
     pos *= m_heightmapWidth;
 
-    const auto x0{ static_cast<int>(floor(pos.x)) };
-    const auto x1{ x0 + 1 };
-    const auto z0{ static_cast<int>(floor(pos.y)) };
-    const auto z1{ z0 + 1 };
+    // the fraction can be rounded up to 1; the last row and column use their own values as neighbours
+    const auto x0{ std::min(static_cast<int>(floor(pos.x)), m_heightmapWidth - 1) };
+    const auto x1{ std::min(x0 + 1, m_heightmapWidth - 1) };
+    const auto z0{ std::min(static_cast<int>(floor(pos.y)), m_heightmapWidth - 1) };
+    const auto z1{ std::min(z0 + 1, m_heightmapWidth - 1) };
 
-    const auto h0{ m_heightmapData[m_heightmapWidth * z0 + x0] };
-    const auto h1{ m_heightmapData[m_heightmapWidth * z0 + x1] };
-    const auto h2{ m_heightmapData[m_heightmapWidth * z1 + x0] };
-    const auto h3{ m_heightmapData[m_heightmapWidth * z1 + x1] };
+    const auto h0{ GetHeightmapValue(x0, z0) };
+    const auto h1{ GetHeightmapValue(x1, z0) };
+    const auto h2{ GetHeightmapValue(x0, z1) };
+    const auto h3{ GetHeightmapValue(x1, z1) };
 
     const auto percentU{ pos.x - x0 };
     const auto percentV{ pos.y - z0 };
@@ -130,7 +373,7 @@ float sg::ogl::terrain::TerrainConfig::GetHeightAt(float t_x, float t_z, float t
 
     if (h < t_min || h > t_max)
     {
-        return -900.0f;
+        return INVALID_HEIGHT;
     }
 
     h *= scaleY;
@@ -138,6 +381,250 @@ float sg::ogl::terrain::TerrainConfig::GetHeightAt(float t_x, float t_z, float t
     return h;
 }
 
+float sg::ogl::terrain::TerrainConfig::GetHeightAt(const float t_x, const float t_z) const
+{
+    const auto width{ static_cast<float>(m_heightmapWidth) };
+
+    // world space -> texel space, clamped to the heightmap
+    const auto u{ std::clamp((t_x + scaleXz * 0.5f) * width / scaleXz - 0.5f, 0.0f, width - 1.0f) };
+    const auto v{ std::clamp((t_z + scaleXz * 0.5f) * width / scaleXz - 0.5f, 0.0f, width - 1.0f) };
+
+    const auto x0{ static_cast<int>(std::min(u, std::max(width - 2.0f, 0.0f))) };
+    const auto z0{ static_cast<int>(std::min(v, std::max(width - 2.0f, 0.0f))) };
+    const auto x1{ std::min(x0 + 1, m_heightmapWidth - 1) };
+    const auto z1{ std::min(z0 + 1, m_heightmapWidth - 1) };
+
+    const auto fu{ u - static_cast<float>(x0) };
+    const auto fv{ v - static_cast<float>(z0) };
+
+    const auto top{ GetHeightmapValue(x0, z0) * (1.0f - fu) + GetHeightmapValue(x1, z0) * fu };
+    const auto bottom{ GetHeightmapValue(x0, z1) * (1.0f - fu) + GetHeightmapValue(x1, z1) * fu };
+
+    return (top + (bottom - top) * fv) * scaleY;
+}
+
+void sg::ogl::terrain::TerrainConfig::GetHeightsAt(const float* t_x, const float* t_z, float* t_heights, const uint32_t t_count) const
+{
+    SG_OGL_CORE_ASSERT(HasHeights(), "[TerrainConfig::GetHeightsAt()] No heightmap data available.");
+
+    uint32_t i{ 0 };
+
+#if defined(SG_OGL_TERRAIN_HEIGHTS_SSE)
+
+    // the tiles are read in the scalar loop
+    const auto vectorCount{ m_tiledHeightmap ? 0u : t_count };
+
+    const auto width{ static_cast<float>(m_heightmapWidth) };
+    const auto half{ _mm_set1_ps(scaleXz * 0.5f) };
+    const auto toTexel{ _mm_set1_ps(width / scaleXz) };
+    const auto texelCenter{ _mm_set1_ps(0.5f) };
+    const auto zero{ _mm_setzero_ps() };
+    const auto lastTexel{ _mm_set1_ps(width - 1.0f) };
+    const auto lastCell{ _mm_set1_ps(std::max(width - 2.0f, 0.0f)) };
+    const auto one{ _mm_set1_ps(1.0f) };
+    const auto heightScale{ _mm_set1_ps(scaleY) };
+
+    const auto normalization{ _mm_set1_ps(HEIGHTMAP_NORMALIZATION) };
+
+    alignas(16) int32_t x0[4];
+    alignas(16) int32_t z0[4];
+    alignas(16) int32_t h00[4];
+    alignas(16) int32_t h10[4];
+    alignas(16) int32_t h01[4];
+    alignas(16) int32_t h11[4];
+
+    for (; i + 4 <= vectorCount; i += 4)
+    {
+        // world space -> texel space, clamped to the heightmap
+        auto u{ _mm_sub_ps(_mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&t_x[i]), half), toTexel), texelCenter) };
+        auto v{ _mm_sub_ps(_mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&t_z[i]), half), toTexel), texelCenter) };
+        u = _mm_min_ps(_mm_max_ps(u, zero), lastTexel);
+        v = _mm_min_ps(_mm_max_ps(v, zero), lastTexel);
+
+        // the values are positive, so truncation is floor; the last texel uses the last cell with a weight of 1
+        const auto cellX{ _mm_cvttps_epi32(_mm_min_ps(u, lastCell)) };
+        const auto cellZ{ _mm_cvttps_epi32(_mm_min_ps(v, lastCell)) };
+        const auto fu{ _mm_sub_ps(u, _mm_cvtepi32_ps(cellX)) };
+        const auto fv{ _mm_sub_ps(v, _mm_cvtepi32_ps(cellZ)) };
+
+        // there is no gather in SSE2
+        _mm_store_si128(reinterpret_cast<__m128i*>(x0), cellX);
+        _mm_store_si128(reinterpret_cast<__m128i*>(z0), cellZ);
+
+        for (auto lane{ 0 }; lane < 4; ++lane)
+        {
+            const auto x1{ std::min(x0[lane] + 1, m_heightmapWidth - 1) };
+            const auto z1{ std::min(z0[lane] + 1, m_heightmapWidth - 1) };
+
+            h00[lane] = m_heightmapData[m_heightmapWidth * z0[lane] + x0[lane]];
+            h10[lane] = m_heightmapData[m_heightmapWidth * z0[lane] + x1];
+            h01[lane] = m_heightmapData[m_heightmapWidth * z1 + x0[lane]];
+            h11[lane] = m_heightmapData[m_heightmapWidth * z1 + x1];
+        }
+
+        // bilinear on the decoded values
+        const auto iu{ _mm_sub_ps(one, fu) };
+        const auto top{ _mm_add_ps(_mm_mul_ps(DecodePs(h00, normalization), iu), _mm_mul_ps(DecodePs(h10, normalization), fu)) };
+        const auto bottom{ _mm_add_ps(_mm_mul_ps(DecodePs(h01, normalization), iu), _mm_mul_ps(DecodePs(h11, normalization), fu)) };
+        const auto h{ _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), fv)) };
+
+        _mm_storeu_ps(&t_heights[i], _mm_mul_ps(h, heightScale));
+    }
+
+#endif
+
+    // the remaining positions
+    for (; i < t_count; ++i)
+    {
+        t_heights[i] = GetHeightAt(t_x[i], t_z[i]);
+    }
+}
+
+void sg::ogl::terrain::TerrainConfig::GetHeightsInRangeAt(
+    const float* t_x,
+    const float* t_z,
+    const float* t_min,
+    const float* t_max,
+    float* t_heights,
+    const uint32_t t_count
+) const
+{
+    SG_OGL_CORE_ASSERT(HasHeights(), "[TerrainConfig::GetHeightsInRangeAt()] No heightmap data available.");
+
+    uint32_t i{ 0 };
+
+#if defined(SG_OGL_TERRAIN_HEIGHTS_SSE)
+
+    // the tiles are read in the scalar loop
+    const auto vectorCount{ m_tiledHeightmap ? 0u : t_count };
+
+    const auto half{ _mm_set1_ps(scaleXz * 0.5f) };
+    const auto scale{ _mm_set1_ps(scaleXz) };
+    const auto width{ _mm_set1_ps(static_cast<float>(m_heightmapWidth)) };
+    const auto lastTexel{ _mm_set1_epi32(m_heightmapWidth - 1) };
+    const auto one{ _mm_set1_ps(1.0f) };
+    const auto heightScale{ _mm_set1_ps(scaleY) };
+    const auto invalid{ _mm_set1_ps(INVALID_HEIGHT) };
+    const auto normalization{ _mm_set1_ps(HEIGHTMAP_NORMALIZATION) };
+
+    // floor for small values: truncate and correct the negative ones
+    const auto floorPs{ [&one](const __m128 t_v)
+    {
+        const auto t{ _mm_cvtepi32_ps(_mm_cvttps_epi32(t_v)) };
+        return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, t_v), one));
+    } };
+
+    // a min for int32 lanes; SSE2 has no _mm_min_epi32
+    const auto minEpi32{ [](const __m128i t_a, const __m128i t_b)
+    {
+        const auto lower{ _mm_cmplt_epi32(t_a, t_b) };
+        return _mm_or_si128(_mm_and_si128(lower, t_a), _mm_andnot_si128(lower, t_b));
+    } };
+
+    alignas(16) int32_t x0[4];
+    alignas(16) int32_t x1[4];
+    alignas(16) int32_t z0[4];
+    alignas(16) int32_t z1[4];
+    alignas(16) int32_t h0[4];
+    alignas(16) int32_t h1[4];
+    alignas(16) int32_t h2[4];
+    alignas(16) int32_t h3[4];
+
+    for (; i + 4 <= vectorCount; i += 4)
+    {
+        // world space -> [0, 1), wrapped around
+        auto u{ _mm_div_ps(_mm_sub_ps(_mm_loadu_ps(&t_x[i]), half), scale) };
+        auto v{ _mm_div_ps(_mm_sub_ps(_mm_loadu_ps(&t_z[i]), half), scale) };
+        u = _mm_mul_ps(_mm_sub_ps(u, floorPs(u)), width);
+        v = _mm_mul_ps(_mm_sub_ps(v, floorPs(v)), width);
+
+        // u and v are positive, so truncation is floor
+        const auto cellX{ minEpi32(_mm_cvttps_epi32(u), lastTexel) };
+        const auto cellZ{ minEpi32(_mm_cvttps_epi32(v), lastTexel) };
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(x0), cellX);
+        _mm_store_si128(reinterpret_cast<__m128i*>(z0), cellZ);
+        _mm_store_si128(reinterpret_cast<__m128i*>(x1), minEpi32(_mm_add_epi32(cellX, _mm_set1_epi32(1)), lastTexel));
+        _mm_store_si128(reinterpret_cast<__m128i*>(z1), minEpi32(_mm_add_epi32(cellZ, _mm_set1_epi32(1)), lastTexel));
+
+        // there is no gather in SSE2
+        for (auto lane{ 0 }; lane < 4; ++lane)
+        {
+            h0[lane] = m_heightmapData[m_heightmapWidth * z0[lane] + x0[lane]];
+            h1[lane] = m_heightmapData[m_heightmapWidth * z0[lane] + x1[lane]];
+            h2[lane] = m_heightmapData[m_heightmapWidth * z1[lane] + x0[lane]];
+            h3[lane] = m_heightmapData[m_heightmapWidth * z1[lane] + x1[lane]];
+        }
+
+        const auto percentU{ _mm_sub_ps(u, _mm_cvtepi32_ps(cellX)) };
+        const auto percentV{ _mm_sub_ps(v, _mm_cvtepi32_ps(cellZ)) };
+
+        const auto vh0{ DecodePs(h0, normalization) };
+        const auto vh1{ DecodePs(h1, normalization) };
+        const auto vh2{ DecodePs(h2, normalization) };
+        const auto vh3{ DecodePs(h3, normalization) };
+
+        // bottom triangle: percentU > percentV; otherwise top triangle
+        const auto bottom{ _mm_cmpgt_ps(percentU, percentV) };
+        const auto dU{ _mm_or_ps(_mm_and_ps(bottom, _mm_sub_ps(vh1, vh0)), _mm_andnot_ps(bottom, _mm_sub_ps(vh3, vh2))) };
+        const auto dV{ _mm_or_ps(_mm_and_ps(bottom, _mm_sub_ps(vh3, vh1)), _mm_andnot_ps(bottom, _mm_sub_ps(vh2, vh0))) };
+
+        const auto h{ _mm_add_ps(vh0, _mm_add_ps(_mm_mul_ps(dU, percentU), _mm_mul_ps(dV, percentV))) };
+
+        // the height has to be in [min, max]
+        const auto inRange{ _mm_and_ps(_mm_cmpge_ps(h, _mm_loadu_ps(&t_min[i])), _mm_cmple_ps(h, _mm_loadu_ps(&t_max[i]))) };
+        const auto result{ _mm_or_ps(_mm_and_ps(inRange, _mm_mul_ps(h, heightScale)), _mm_andnot_ps(inRange, invalid)) };
+
+        _mm_storeu_ps(&t_heights[i], result);
+    }
+
+#endif
+
+    // the remaining positions
+    for (; i < t_count; ++i)
+    {
+        t_heights[i] = GetHeightAt(t_x[i], t_z[i], t_min[i], t_max[i]);
+    }
+}
+
+//-------------------------------------------------
+// Raycast
+//-------------------------------------------------
+
+bool sg::ogl::terrain::TerrainConfig::Raycast(const glm::vec3& t_origin, const glm::vec3& t_direction, const float t_maxDistance, float& t_distance) const
+{
+    if (m_heightPyramid.IsEmpty() || m_heightmapWidth < 2)
+    {
+        return false;
+    }
+
+    // world space -> sample space; the samples are at the texel centers
+    const auto samplesPerUnit{ static_cast<float>(m_heightmapWidth) / scaleXz };
+
+    SampleRay ray;
+    ray.origin = {
+        (t_origin.x + scaleXz * 0.5f) * samplesPerUnit - 0.5f,
+        t_origin.y / scaleY,
+        (t_origin.z + scaleXz * 0.5f) * samplesPerUnit - 0.5f
+    };
+    ray.direction = { t_direction.x * samplesPerUnit, t_direction.y / scaleY, t_direction.z * samplesPerUnit };
+
+    // the root covers all patches
+    auto rootSize{ 1 };
+    while (rootSize < m_heightmapWidth - 1)
+    {
+        rootSize *= 2;
+    }
+
+    return RaycastNode(ray, *this, 0, 0, rootSize, 0.0f, t_maxDistance, t_distance);
+}
+
+bool sg::ogl::terrain::TerrainConfig::IsVisible(const glm::vec3& t_from, const glm::vec3& t_to) const
+{
+    float distance;
+    return !Raycast(t_from, t_to - t_from, 1.0f, distance);
+}
+
 //-------------------------------------------------
 // Init
 //-------------------------------------------------
@@ -146,8 +633,73 @@ void sg::ogl::terrain::TerrainConfig::InitMapsAndMorphing(const std::string& t_h
 {
     LoadHeightmap(t_heightmapFilePath);
 
-    LoadNormalmap(t_heightmapFilePath);
-    LoadSplatmap(t_heightmapFilePath);
+    const auto useMapCache{ !mapCachePath.empty() };
+    const auto mapCacheKey{ useMapCache ? TerrainMaps::GetCacheKey(m_heightmapData, m_heightmapWidth, normalStrength, m_application->GetThreadPool()) : 0 };
+    const auto mapCacheFilePath{ useMapCache ? TerrainMaps::GetCacheFilePath(mapCachePath, t_heightmapFilePath, mapCacheKey) : "" };
+
+    TerrainMaps maps;
+
+    if (useMapCache && maps.Load(mapCacheFilePath, mapCacheKey))
+    {
+        UploadMaps(t_heightmapFilePath, maps);
+    }
+    else
+    {
+        if (cpuMapGeneration)
+        {
+            maps = TerrainMaps::Generate(m_heightmapData, m_heightmapWidth, normalStrength, m_application->GetThreadPool());
+            UploadMaps(t_heightmapFilePath, maps);
+        }
+        else
+        {
+            LoadNormalmap(t_heightmapFilePath);
+            LoadSplatmap(t_heightmapFilePath);
+
+            if (useMapCache)
+            {
+                ReadMaps(maps);
+            }
+        }
+
+        if (useMapCache)
+        {
+            maps.Save(mapCacheFilePath, mapCacheKey);
+        }
+    }
+
+    InitMorphing();
+
+    // rethrows an exception of the job
+    m_heightPyramidJob.get();
+}
+
+void sg::ogl::terrain::TerrainConfig::InitTiledMapsAndMorphing(const TiledHeightmapSharedPtr& t_tiledHeightmap)
+{
+    SG_OGL_CORE_ASSERT(t_tiledHeightmap, "[TerrainConfig::InitTiledMapsAndMorphing()] Null pointer.");
+
+    m_tiledHeightmap = t_tiledHeightmap;
+    m_heightmapWidth = m_tiledHeightmap->GetWidth();
+
+    // the tiles replace the heightmap data
+    HeightmapHeightContainer().swap(m_heightmapData);
+
+    m_heightPyramid.BuildFromTiles(
+        m_tiledHeightmap->GetTileRanges(),
+        m_tiledHeightmap->GetNumberOfTilesPerRow(),
+        m_tiledHeightmap->GetTileSize(),
+        m_heightmapWidth,
+        HEIGHTMAP_NORMALIZATION
+    );
+
+    LoadTiledHeightmap();
+
+    if (cpuMapGeneration || !mapCachePath.empty())
+    {
+        Log::SG_OGL_CORE_LOG_WARN("[TerrainConfig::InitTiledMapsAndMorphing()] The map cache and cpuMapGeneration are not available for a tiled heightmap.");
+    }
+
+    LoadNormalmap(m_tiledHeightmap->GetFilePath());
+    LoadSplatmap(m_tiledHeightmap->GetFilePath());
 
     InitMorphing();
 }
@@ -165,71 +717,137 @@ void sg::ogl::terrain::TerrainConfig::InitTextures(
     m_snowTextureId = m_application->GetTextureManager().GetTextureIdFromPath(t_snowFilePath);
 }
 
+//-------------------------------------------------
+// Update
+//-------------------------------------------------
+
+void sg::ogl::terrain::TerrainConfig::UpdateTiles(const glm::vec3& t_cameraPosition) const
+{
+    if (!m_tiledHeightmap)
+    {
+        return;
+    }
+
+    // world space -> texel space
+    const auto texelsPerUnit{ static_cast<float>(m_heightmapWidth) / scaleXz };
+    m_tiledHeightmap->Update(glm::vec2(
+        (t_cameraPosition.x + scaleXz * 0.5f) * texelsPerUnit,
+        (t_cameraPosition.z + scaleXz * 0.5f) * texelsPerUnit
+    ));
+}
+
 //-------------------------------------------------
 // Load maps
 //-------------------------------------------------
 
 void sg::ogl::terrain::TerrainConfig::LoadHeightmap(const std::string& t_heightmapFilePath)
 {
-    if (use16BitHeightmap)
+    // decode the file once on the CPU and upload the same values, instead of reading the texture back
+    auto pixels{ resource::TextureManager::DecodeHeightmap(t_heightmapFilePath, use16BitHeightmap) };
+    SG_OGL_CORE_ASSERT(pixels.width == pixels.height, "[TerrainConfig::LoadHeightmap()] Width and Height should have the same value.");
+
+    m_heightmapTextureId = m_application->GetTextureManager().GetHeightmapIdFromPixels(t_heightmapFilePath, pixels);
+    m_heightmapWidth = pixels.width;
+    m_heightmapData = std::move(pixels.values);
+
+    // the height ranges for the bounding boxes of the quadtree nodes
+    m_heightPyramidJob = m_application->GetThreadPool().Submit([this]()
     {
-        m_heightmapTextureId = m_application->GetTextureManager().Get16BitHeightmapIdFromPath(t_heightmapFilePath);
-    }
-    else
+        m_heightPyramid.Build(m_heightmapData, m_heightmapWidth, HEIGHTMAP_NORMALIZATION);
+    });
+}
+
+void sg::ogl::terrain::TerrainConfig::LoadTiledHeightmap()
+{
+    const auto tileSize{ m_tiledHeightmap->GetTileSize() };
+    const auto tilesPerRow{ m_tiledHeightmap->GetNumberOfTilesPerRow() };
+
+    m_heightmapTextureId = m_application->GetTextureManager().GetTextureId(GetFilenameWithoutExtension(m_tiledHeightmap->GetFilePath()) + "_heightmap");
+    resource::TextureManager::Bind(m_heightmapTextureId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R16, m_heightmapWidth, m_heightmapWidth, 0, GL_RED, GL_UNSIGNED_SHORT, nullptr);
+
+    // one tile at a time; the rows of a tile are tileSize values long
+    GLint unpackAlignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, tileSize);
+
+    for (auto tz{ 0 }; tz < tilesPerRow; ++tz)
     {
-        m_heightmapTextureId = m_application->GetTextureManager().GetTextureIdFromPath(t_heightmapFilePath);
+        for (auto tx{ 0 }; tx < tilesPerRow; ++tx)
+        {
+            // the border tiles are clipped to the heightmap
+            const auto x{ tx * tileSize };
+            const auto z{ tz * tileSize };
+            const auto tile{ m_tiledHeightmap->ReadTile(tx, tz) };
+
+            glTexSubImage2D(
+                GL_TEXTURE_2D, 0,
+                x, z,
+                std::min(tileSize, m_heightmapWidth - x), std::min(tileSize, m_heightmapWidth - z),
+                GL_RED, GL_UNSIGNED_SHORT, tile->data()
+            );
+        }
     }
 
-    m_heightmapWidth = m_application->GetTextureManager().GetMetadata(t_heightmapFilePath).width;
-    SG_OGL_CORE_ASSERT(m_heightmapWidth == m_application->GetTextureManager().GetMetadata(t_heightmapFilePath).height, "[TerrainConfig::LoadHeightmap()] Width and Height should have the same value.");
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+
+    glGenerateMipmap(GL_TEXTURE_2D);
+    resource::TextureManager::UseBilinearMipmapFilter();
+    resource::TextureManager::UseRepeatWrapping();
 
-    InitHeightmapData();
+    Log::SG_OGL_CORE_LOG_DEBUG("[TerrainConfig::LoadTiledHeightmap()] Uploaded {}x{} tiles of {}.", tilesPerRow, tilesPerRow, m_tiledHeightmap->GetFilePath());
 }
 
 void sg::ogl::terrain::TerrainConfig::LoadNormalmap(const std::string& t_normalmapTextureName)
 {
-    const auto textureName{ GetFilenameWithoutExtension(t_normalmapTextureName) + "_normalmap" };
-
-    m_normalmapTextureId = m_application->GetTextureManager().GetTextureId(textureName);
-    resource::TextureManager::Bind(m_normalmapTextureId);
-    resource::TextureManager::UseBilinearFilter();
-
-    const auto numMipmaps{ log(m_heightmapWidth) / log(2) };
-    glTexStorage2D(GL_TEXTURE_2D, static_cast<int32_t>(numMipmaps), GL_RGBA32F, m_heightmapWidth, m_heightmapWidth);
+    m_normalmapTextureId = CreateMapTexture(GetFilenameWithoutExtension(t_normalmapTextureName) + "_normalmap", GL_RG16_SNORM);
 
     m_application->GetShaderManager().AddComputeShaderProgram<resource::shaderprogram::ComputeNormalmap>();
     auto& normalmapShaderProgram{ m_application->GetShaderManager().GetComputeShaderProgram<resource::shaderprogram::ComputeNormalmap>() };
     normalmapShaderProgram.Bind();
     normalmapShaderProgram.UpdateUniforms(*this);
 
-    glBindImageTexture(0, m_normalmapTextureId, 0, false, 0, GL_WRITE_ONLY, GL_RGBA32F);
+    glBindImageTexture(0, m_normalmapTextureId, 0, false, 0, GL_WRITE_ONLY, GL_RG16_SNORM);
     glDispatchCompute(m_heightmapWidth / 16, m_heightmapWidth / 16, 1);
 
+    // the splatmap is computed from the normalmap
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
     resource::ShaderProgram::Unbind();
 }
 
 void sg::ogl::terrain::TerrainConfig::LoadSplatmap(const std::string& t_splatmapTextureName)
 {
-    const auto textureName{ GetFilenameWithoutExtension(t_splatmapTextureName) + "_splatmap" };
-
-    m_splatmapTextureId = m_application->GetTextureManager().GetTextureId(textureName);
-    resource::TextureManager::Bind(m_splatmapTextureId);
-    resource::TextureManager::UseBilinearFilter();
-
-    const auto numMipmaps{ log(m_heightmapWidth) / log(2) };
-    glTexStorage2D(GL_TEXTURE_2D, static_cast<int32_t>(numMipmaps), GL_RGBA32F, m_heightmapWidth, m_heightmapWidth);
+    m_splatmapTextureId = CreateMapTexture(GetFilenameWithoutExtension(t_splatmapTextureName) + "_splatmap", GL_RGBA8);
 
     m_application->GetShaderManager().AddComputeShaderProgram<resource::shaderprogram::ComputeSplatmap>();
     auto& splatmapShaderProgram{ m_application->GetShaderManager().GetComputeShaderProgram<resource::shaderprogram::ComputeSplatmap>() };
     splatmapShaderProgram.Bind();
     splatmapShaderProgram.UpdateUniforms(*this);
 
-    glBindImageTexture(0, m_splatmapTextureId, 0, false, 0, GL_WRITE_ONLY, GL_RGBA32F);
+    glBindImageTexture(0, m_splatmapTextureId, 0, false, 0, GL_WRITE_ONLY, GL_RGBA8);
     glDispatchCompute(m_heightmapWidth / 16, m_heightmapWidth / 16, 1);
 
+    // for the terrain shader and the readback of the map cache
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+
     resource::ShaderProgram::Unbind();
 }
 
+uint32_t sg::ogl::terrain::TerrainConfig::CreateMapTexture(const std::string& t_textureName, const uint32_t t_internalFormat) const
+{
+    const auto textureId{ m_application->GetTextureManager().GetTextureId(t_textureName) };
+    resource::TextureManager::Bind(textureId);
+    resource::TextureManager::UseBilinearFilter();
+
+    // only the first level is sampled
+    glTexStorage2D(GL_TEXTURE_2D, 1, t_internalFormat, m_heightmapWidth, m_heightmapWidth);
+
+    return textureId;
+}
+
 void sg::ogl::terrain::TerrainConfig::InitMorphing()
 {
     SG_OGL_CORE_ASSERT(!lodRanges.empty(), "[TerrainConfig::InitMorphing()] There are no values for the Lod Ranges.");
@@ -250,13 +868,34 @@ void sg::ogl::terrain::TerrainConfig::InitMorphing()
     }
 }
 
-void sg::ogl::terrain::TerrainConfig::InitHeightmapData()
+//-------------------------------------------------
+// Upload / Readback maps
+//-------------------------------------------------
+
+void sg::ogl::terrain::TerrainConfig::UploadMaps(const std::string& t_heightmapFilePath, const TerrainMaps& t_maps)
 {
-    resource::TextureManager::Bind(m_heightmapTextureId);
+    SG_OGL_CORE_ASSERT(t_maps.width == m_heightmapWidth, "[TerrainConfig::UploadMaps()] The maps do not fit the heightmap.");
+
+    m_normalmapTextureId = CreateMapTexture(GetFilenameWithoutExtension(t_heightmapFilePath) + "_normalmap", GL_RG16_SNORM);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_heightmapWidth, m_heightmapWidth, GL_RG, GL_SHORT, t_maps.normals.data());
+
+    m_splatmapTextureId = CreateMapTexture(GetFilenameWithoutExtension(t_heightmapFilePath) + "_splatmap", GL_RGBA8);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_heightmapWidth, m_heightmapWidth, GL_RGBA, GL_UNSIGNED_BYTE, t_maps.splats.data());
+}
+
+void sg::ogl::terrain::TerrainConfig::ReadMaps(TerrainMaps& t_maps) const
+{
+    const auto texels{ static_cast<size_t>(m_heightmapWidth) * m_heightmapWidth };
+
+    t_maps.width = m_heightmapWidth;
+    t_maps.normals.resize(texels * TerrainMaps::NORMALMAP_CHANNELS);
+    t_maps.splats.resize(texels * TerrainMaps::SPLATMAP_CHANNELS);
 
-    // Create float buffer of red channel heightmap data.
-    m_heightmapData.resize(m_heightmapWidth * m_heightmapWidth);
-    glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, m_heightmapData.data());
+    resource::TextureManager::Bind(m_normalmapTextureId);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RG, GL_SHORT, t_maps.normals.data());
+
+    resource::TextureManager::Bind(m_splatmapTextureId);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, t_maps.splats.data());
 }
 
 //-------------------------------------------------
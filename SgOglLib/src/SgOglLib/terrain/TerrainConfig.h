@@ -12,12 +12,22 @@
 #include <vector>
 #include <array>
 #include <string>
+#include <memory>
+#include <future>
+#include <glm/vec3.hpp>
+#include "HeightPyramid.h"
 
 namespace sg::ogl
 {
     class Application;
 }
 
+namespace sg::ogl::terrain
+{
+    class TerrainMaps;
+    class TiledHeightmap;
+}
+
 constexpr std::array POW2{
     1, 2, 4, 8, 16,
     32, 64, 128, 256, 512
@@ -35,12 +45,23 @@ namespace sg::ogl::terrain
     public:
         using LodRangeContainer = std::vector<int>;
         using LodMorphingAreaContainer = std::vector<int>;
-        using HeightmapHeightContainer = std::vector<float>;
+        using HeightmapHeightContainer = std::vector<uint16_t>;
+        using TiledHeightmapSharedPtr = std::shared_ptr<TiledHeightmap>;
 
         //-------------------------------------------------
         // Public member
         //-------------------------------------------------
 
+        /**
+         * @brief Returned for a height outside of the requested range.
+         */
+        static constexpr float INVALID_HEIGHT{ -900.0f };
+
+        /**
+         * @brief Converts a stored 16-bit heightmap value into the [0, 1] range of the texture.
+         */
+        static constexpr float HEIGHTMAP_NORMALIZATION{ 1.0f / 65535.0f };
+
         float scaleXz{ 1.0f };
         float scaleY{ 1.0f };
         int rootNodes{ 2 };
@@ -56,8 +77,30 @@ namespace sg::ogl::terrain
 
         LodRangeContainer lodRanges;
 
+        /**
+         * @brief A split node is merged at lodRange * (1 + lodHysteresis).
+         */
+        float lodHysteresis{ 0.1f };
+
+        /**
+         * @brief The lod is evaluated again after the camera has moved this distance or turned.
+         */
+        float lodUpdateDistance{ 1.0f };
+
         bool use16BitHeightmap{ false };
 
+        /**
+         * @brief A directory for the generated normalmap and splatmap. The maps are reloaded
+         *        from there as long as the heightmap and the normalStrength are unchanged.
+         *        An empty path disables the cache.
+         */
+        std::string mapCachePath;
+
+        /**
+         * @brief Generates the normalmap and splatmap on the worker threads instead of with compute shaders.
+         */
+        bool cpuMapGeneration{ false };
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -89,17 +132,109 @@ namespace sg::ogl::terrain
         [[nodiscard]] int GetHeightmapWidth() const;
         [[nodiscard]] const LodMorphingAreaContainer& GetLodMorphingArea() const;
 
+        /**
+         * @brief The 16-bit heightmap values, row by row. Multiply by HEIGHTMAP_NORMALIZATION for [0, 1].
+         *        Empty if the heights come from a TiledHeightmap.
+         */
         [[nodiscard]] HeightmapHeightContainer& GetHeightmapData();
         [[nodiscard]] const HeightmapHeightContainer& GetHeightmapData() const;
 
+        /**
+         * @brief True if the heights can be queried, either from the heightmap data or from a TiledHeightmap.
+         */
+        [[nodiscard]] bool HasHeights() const;
+
+        /**
+         * @brief The height of a texel in [0, 1], read from the heightmap data or from the tiles.
+         * @param t_x The column; must be in [0, width).
+         * @param t_z The row; must be in [0, width).
+         */
+        [[nodiscard]] float GetHeightmapValue(int t_x, int t_z) const;
+
+        /**
+         * @brief The min/max mip chain of the heightmap data.
+         */
+        [[nodiscard]] const HeightPyramid& GetHeightPyramid() const noexcept;
+
+        /**
+         * @brief The terrain height at a world space position, interpolated on the two triangles
+         *        of a heightmap cell. Positions outside of the terrain wrap around.
+         * @param t_x The world space x coordinate.
+         * @param t_z The world space z coordinate.
+         * @param t_min The min unscaled height.
+         * @param t_max The max unscaled height.
+         * @return The scaled world space height or INVALID_HEIGHT if the height is not in [t_min, t_max].
+         */
         [[nodiscard]] float GetHeightAt(float t_x, float t_z, float t_min, float t_max) const;
 
+        /**
+         * @brief The bilinear sampled terrain height at a world space position.
+         *        Positions outside of the terrain get the height of the nearest edge.
+         * @param t_x The world space x coordinate.
+         * @param t_z The world space z coordinate.
+         * @return The scaled world space height.
+         */
+        [[nodiscard]] float GetHeightAt(float t_x, float t_z) const;
+
+        /**
+         * @brief Resolves the terrain heights of many positions in one call (SSE2 if available).
+         *        The heightmap is sampled bilinear like on the GPU; positions outside of the
+         *        terrain get the height of the nearest edge.
+         * @param t_x The world space x coordinates.
+         * @param t_z The world space z coordinates.
+         * @param t_heights Receives the scaled world space heights.
+         * @param t_count The number of positions.
+         */
+        void GetHeightsAt(const float* t_x, const float* t_z, float* t_heights, uint32_t t_count) const;
+
+        /**
+         * @brief The batch version of GetHeightAt(x, z, min, max) (SSE2 if available).
+         *        Like there, the heights are interpolated on the triangles of a cell and
+         *        positions outside of the terrain wrap around.
+         * @param t_x The world space x coordinates.
+         * @param t_z The world space z coordinates.
+         * @param t_min The min unscaled height for each position.
+         * @param t_max The max unscaled height for each position.
+         * @param t_heights Receives the scaled heights or INVALID_HEIGHT.
+         * @param t_count The number of positions.
+         */
+        void GetHeightsInRangeAt(const float* t_x, const float* t_z, const float* t_min, const float* t_max, float* t_heights, uint32_t t_count) const;
+
+        /**
+         * @brief The first intersection of a ray with the bilinear sampled terrain surface.
+         *        The ray descends the height pyramid, so only the nodes near the ray are visited.
+         * @param t_origin The world space origin of the ray.
+         * @param t_direction The world space direction of the ray.
+         * @param t_maxDistance The max distance in multiples of t_direction.
+         * @param t_distance Receives the distance of the intersection in multiples of t_direction.
+         * @return True if the ray hits the terrain within t_maxDistance.
+         */
+        bool Raycast(const glm::vec3& t_origin, const glm::vec3& t_direction, float t_maxDistance, float& t_distance) const;
+
+        /**
+         * @brief Checks if the terrain is between two world space positions.
+         * @param t_from The first position.
+         * @param t_to The second position.
+         * @return True if the line from t_from to t_to does not hit the terrain.
+         */
+        [[nodiscard]] bool IsVisible(const glm::vec3& t_from, const glm::vec3& t_to) const;
+
         //-------------------------------------------------
         // Init
         //-------------------------------------------------
 
         void InitMapsAndMorphing(const std::string& t_heightmapFilePath);
 
+        /**
+         * @brief Uses a TiledHeightmap as the height source instead of a heightmap image; the heights
+         *        are never held in memory as a whole. The height queries read the tiles, the
+         *        HeightPyramid is built from the tile ranges and the heightmap texture is uploaded
+         *        one tile at a time. The map cache and cpuMapGeneration need all heights, so the
+         *        normalmap and splatmap are always computed on the GPU.
+         * @param t_tiledHeightmap The tiled heightmap.
+         */
+        void InitTiledMapsAndMorphing(const TiledHeightmapSharedPtr& t_tiledHeightmap);
+
         void InitTextures(
             const std::string& t_sandFilePath,
             const std::string& t_grassFilePath,
@@ -107,6 +242,16 @@ namespace sg::ogl::terrain
             const std::string& t_snowFilePath
         );
 
+        //-------------------------------------------------
+        // Update
+        //-------------------------------------------------
+
+        /**
+         * @brief Pages in the tiles around the camera if the heights come from a TiledHeightmap.
+         * @param t_cameraPosition The world space position of the camera.
+         */
+        void UpdateTiles(const glm::vec3& t_cameraPosition) const;
+
     protected:
 
     private:
@@ -125,19 +270,38 @@ namespace sg::ogl::terrain
 
         LodMorphingAreaContainer m_lodMorphingArea;
         HeightmapHeightContainer m_heightmapData;
+        HeightPyramid m_heightPyramid;
+
+        /**
+         * @brief Optional; replaces the heightmap data.
+         */
+        TiledHeightmapSharedPtr m_tiledHeightmap;
+
+        /**
+         * @brief Builds the pyramid on a worker thread while the normalmap and splatmap are computed.
+         */
+        std::future<void> m_heightPyramidJob;
 
         //-------------------------------------------------
         // Load maps
         //-------------------------------------------------
 
         void LoadHeightmap(const std::string& t_heightmapFilePath);
+        void LoadTiledHeightmap();
 
         void LoadNormalmap(const std::string& t_normalmapTextureName);
         void LoadSplatmap(const std::string& t_splatmapTextureName);
 
+        [[nodiscard]] uint32_t CreateMapTexture(const std::string& t_textureName, uint32_t t_internalFormat) const;
+
         void InitMorphing();
 
-        void InitHeightmapData();
+        //-------------------------------------------------
+        // Upload / Readback maps
+        //-------------------------------------------------
+
+        void UploadMaps(const std::string& t_heightmapFilePath, const TerrainMaps& t_maps);
+        void ReadMaps(TerrainMaps& t_maps) const;
 
         //-------------------------------------------------
         // Helper
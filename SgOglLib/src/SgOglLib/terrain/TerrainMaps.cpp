@@ -0,0 +1,469 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: TerrainMaps.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "TerrainMaps.h"
+#include "ThreadPool.h"
+#include "Core.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define SG_OGL_TERRAIN_MAPS_SSE
+#endif
+
+namespace
+{
+    constexpr char CACHE_MAGIC[4]{ 'S', 'G', 'T', 'M' };
+
+    struct CacheHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t width;
+        uint32_t reserved;
+        uint64_t key;
+    };
+
+    constexpr uint64_t FNV_OFFSET_BASIS{ 14695981039346656037ull };
+    constexpr uint64_t FNV_PRIME{ 1099511628211ull };
+
+    uint64_t Fnv1a(const void* t_data, const size_t t_size, uint64_t t_hash = FNV_OFFSET_BASIS)
+    {
+        const auto* bytes{ static_cast<const uint8_t*>(t_data) };
+        for (size_t i{ 0 }; i < t_size; ++i)
+        {
+            t_hash ^= bytes[i];
+            t_hash *= FNV_PRIME;
+        }
+
+        return t_hash;
+    }
+
+    // the same over 64-bit words, eight times fewer multiplications; the rest is hashed byte by byte
+    uint64_t Fnv1aWords(const void* t_data, const size_t t_size, uint64_t t_hash = FNV_OFFSET_BASIS)
+    {
+        const auto* bytes{ static_cast<const uint8_t*>(t_data) };
+        const auto nrWords{ t_size / sizeof(uint64_t) };
+        for (size_t i{ 0 }; i < nrWords; ++i)
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(uint64_t));
+            t_hash ^= word;
+            t_hash *= FNV_PRIME;
+        }
+
+        return Fnv1a(bytes + nrWords * sizeof(uint64_t), t_size % sizeof(uint64_t), t_hash);
+    }
+
+    constexpr float HEIGHT_NORMALIZATION{ 1.0f / 65535.0f };
+    constexpr float SNORM16_MAX{ 32767.0f };
+
+    // the textures use repeat wrapping
+    int Wrap(const int t_i, const int t_width)
+    {
+        return ((t_i % t_width) + t_width) % t_width;
+    }
+
+    // a row of normalized heights for the columns [-2, width]
+    void FillHeightRow(const std::vector<uint16_t>& t_heights, const int t_width, const int t_row, float* t_dst)
+    {
+        const auto* src{ &t_heights[static_cast<size_t>(Wrap(t_row, t_width)) * t_width] };
+
+        t_dst[0] = src[Wrap(-2, t_width)] * HEIGHT_NORMALIZATION;
+        t_dst[1] = src[Wrap(-1, t_width)] * HEIGHT_NORMALIZATION;
+        for (auto x{ 0 }; x < t_width; ++x)
+        {
+            t_dst[x + 2] = src[x] * HEIGHT_NORMALIZATION;
+        }
+        t_dst[t_width + 2] = src[Wrap(t_width, t_width)] * HEIGHT_NORMALIZATION;
+    }
+
+    // The compute shaders sample at texel corners, so every bilinear fetch is the mean of 2 x 2 texels.
+    // Writes the t_count corner values of two rows: t_dst[k] = mean(t_a[k], t_a[k + 1], t_b[k], t_b[k + 1]).
+    void AverageCorners(const float* t_a, const float* t_b, const int t_count, float* t_dst)
+    {
+        auto k{ 0 };
+
+#if defined(SG_OGL_TERRAIN_MAPS_SSE)
+        const auto quarter{ _mm_set1_ps(0.25f) };
+        for (; k + 4 <= t_count; k += 4)
+        {
+            const auto a{ _mm_add_ps(_mm_loadu_ps(&t_a[k]), _mm_loadu_ps(&t_a[k + 1])) };
+            const auto b{ _mm_add_ps(_mm_loadu_ps(&t_b[k]), _mm_loadu_ps(&t_b[k + 1])) };
+            _mm_storeu_ps(&t_dst[k], _mm_mul_ps(_mm_add_ps(a, b), quarter));
+        }
+#endif
+
+        for (; k < t_count; ++k)
+        {
+            t_dst[k] = ((t_a[k] + t_a[k + 1]) + (t_b[k] + t_b[k + 1])) * 0.25f;
+        }
+    }
+
+    int16_t ToSnorm16(const float t_value)
+    {
+        return static_cast<int16_t>(std::nearbyint(std::clamp(t_value, -1.0f, 1.0f) * SNORM16_MAX));
+    }
+
+    float FromSnorm16(const int16_t t_value)
+    {
+        return std::max(static_cast<float>(t_value) / SNORM16_MAX, -1.0f);
+    }
+
+    // the weights of sand/snow, grass, rock and snow as one RGBA8 texel
+    uint32_t GetSplatTexel(const float t_slope)
+    {
+        if (t_slope > 0.82f)
+        {
+            return 0x000000FFu;
+        }
+
+        if (t_slope > 0.62f)
+        {
+            return 0x0000FF00u;
+        }
+
+        if (t_slope > 0.32f)
+        {
+            return 0x00FF0000u;
+        }
+
+        return 0xFF000000u;
+    }
+}
+
+//-------------------------------------------------
+// Generate
+//-------------------------------------------------
+
+sg::ogl::terrain::TerrainMaps sg::ogl::terrain::TerrainMaps::Generate(
+    const std::vector<uint16_t>& t_heights,
+    const int t_width,
+    const float t_normalStrength,
+    ThreadPool& t_threadPool
+)
+{
+    SG_OGL_CORE_ASSERT(t_width > 0, "[TerrainMaps::Generate()] Invalid width.");
+    SG_OGL_CORE_ASSERT(t_heights.size() == static_cast<size_t>(t_width) * t_width, "[TerrainMaps::Generate()] Invalid number of heights.");
+
+    TerrainMaps maps;
+    maps.width = t_width;
+    maps.normals.resize(static_cast<size_t>(t_width) * t_width * NORMALMAP_CHANNELS);
+    maps.splats.resize(static_cast<size_t>(t_width) * t_width * SPLATMAP_CHANNELS);
+
+    const auto nrTiles{ static_cast<uint32_t>((t_width + TILE_ROWS - 1) / TILE_ROWS) };
+
+    // the splatmap reads the normals of the neighbouring tiles
+    t_threadPool.ParallelFor(nrTiles, [&](const uint32_t t_tile)
+    {
+        const auto firstRow{ static_cast<int>(t_tile) * TILE_ROWS };
+        maps.GenerateNormalmapRows(t_heights, t_normalStrength, firstRow, std::min(firstRow + TILE_ROWS, t_width));
+    });
+
+    t_threadPool.ParallelFor(nrTiles, [&](const uint32_t t_tile)
+    {
+        const auto firstRow{ static_cast<int>(t_tile) * TILE_ROWS };
+        maps.GenerateSplatmapRows(firstRow, std::min(firstRow + TILE_ROWS, t_width));
+    });
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[TerrainMaps::Generate()] Generated the maps of a {}x{} heightmap in {} tiles.", t_width, t_width, nrTiles);
+
+    return maps;
+}
+
+void sg::ogl::terrain::TerrainMaps::GenerateNormalmapRows(
+    const std::vector<uint16_t>& t_heights,
+    const float t_normalStrength,
+    const int t_firstRow,
+    const int t_lastRow
+)
+{
+    // t0 -- t1 -- t2
+    // |     |     |
+    // t3 -- h  -- t4
+    // |     |     |
+    // t5 -- t6 -- t7
+
+    // the height rows hold the columns [-2, width], the corner rows the columns [-1, width]
+    const auto heightRowSize{ static_cast<size_t>(width) + 3 };
+    const auto cornerRowSize{ static_cast<size_t>(width) + 2 };
+
+    std::vector<float> heightRows(2 * heightRowSize);
+    std::vector<float> cornerRows(3 * cornerRowSize);
+
+    auto* previousHeights{ &heightRows[0] };
+    auto* currentHeights{ &heightRows[heightRowSize] };
+    auto* top{ &cornerRows[0] };
+    auto* middle{ &cornerRows[cornerRowSize] };
+    auto* bottom{ &cornerRows[2 * cornerRowSize] };
+
+    const auto cornerCount{ width + 2 };
+
+    // the corner rows firstRow - 1 and firstRow
+    FillHeightRow(t_heights, width, t_firstRow - 2, previousHeights);
+    FillHeightRow(t_heights, width, t_firstRow - 1, currentHeights);
+    AverageCorners(previousHeights, currentHeights, cornerCount, top);
+
+    std::swap(previousHeights, currentHeights);
+    FillHeightRow(t_heights, width, t_firstRow, currentHeights);
+    AverageCorners(previousHeights, currentHeights, cornerCount, middle);
+
+    const auto nz{ 1.0f / t_normalStrength };
+
+    for (auto row{ t_firstRow }; row < t_lastRow; ++row)
+    {
+        std::swap(previousHeights, currentHeights);
+        FillHeightRow(t_heights, width, row + 1, currentHeights);
+        AverageCorners(previousHeights, currentHeights, cornerCount, bottom);
+
+        auto* dst{ &normals[static_cast<size_t>(row) * width * NORMALMAP_CHANNELS] };
+        auto x{ 0 };
+
+#if defined(SG_OGL_TERRAIN_MAPS_SSE)
+        const auto two{ _mm_set1_ps(2.0f) };
+        const auto vnz2{ _mm_set1_ps(nz * nz) };
+        const auto snormMax{ _mm_set1_ps(SNORM16_MAX) };
+
+        for (; x + 4 <= width; x += 4)
+        {
+            const auto t0{ _mm_loadu_ps(&top[x]) };
+            const auto t1{ _mm_loadu_ps(&top[x + 1]) };
+            const auto t2{ _mm_loadu_ps(&top[x + 2]) };
+            const auto t3{ _mm_loadu_ps(&middle[x]) };
+            const auto t4{ _mm_loadu_ps(&middle[x + 2]) };
+            const auto t5{ _mm_loadu_ps(&bottom[x]) };
+            const auto t6{ _mm_loadu_ps(&bottom[x + 1]) };
+            const auto t7{ _mm_loadu_ps(&bottom[x + 2]) };
+
+            // nx = t0 + 2 * t3 + t5 - t2 - 2 * t4 - t7
+            // ny = t0 + 2 * t1 + t2 - t5 - 2 * t6 - t7
+            const auto nx{ _mm_sub_ps(
+                _mm_add_ps(_mm_add_ps(t0, _mm_mul_ps(two, t3)), t5),
+                _mm_add_ps(_mm_add_ps(t2, _mm_mul_ps(two, t4)), t7)
+            ) };
+            const auto ny{ _mm_sub_ps(
+                _mm_add_ps(_mm_add_ps(t0, _mm_mul_ps(two, t1)), t2),
+                _mm_add_ps(_mm_add_ps(t5, _mm_mul_ps(two, t6)), t7)
+            ) };
+
+            const auto length{ _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), vnz2)) };
+
+            // the normalized components are in [-1, 1], so the conversion cannot overflow
+            const auto ix{ _mm_cvtps_epi32(_mm_mul_ps(_mm_div_ps(nx, length), snormMax)) };
+            const auto iy{ _mm_cvtps_epi32(_mm_mul_ps(_mm_div_ps(ny, length), snormMax)) };
+
+            // x0 x1 x2 x3 y0 y1 y2 y3 -> x0 y0 x1 y1 x2 y2 x3 y3
+            const auto packed{ _mm_packs_epi32(ix, iy) };
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[x * NORMALMAP_CHANNELS]), _mm_unpacklo_epi16(packed, _mm_srli_si128(packed, 8)));
+        }
+#endif
+
+        for (; x < width; ++x)
+        {
+            // the same order of the operations as above, so both paths give the same maps
+            const auto nx{ (top[x] + 2.0f * middle[x] + bottom[x]) - (top[x + 2] + 2.0f * middle[x + 2] + bottom[x + 2]) };
+            const auto ny{ (top[x] + 2.0f * top[x + 1] + top[x + 2]) - (bottom[x] + 2.0f * bottom[x + 1] + bottom[x + 2]) };
+            const auto length{ std::sqrt(nx * nx + ny * ny + nz * nz) };
+
+            dst[x * NORMALMAP_CHANNELS] = ToSnorm16(nx / length);
+            dst[x * NORMALMAP_CHANNELS + 1] = ToSnorm16(ny / length);
+        }
+
+        std::swap(top, middle);
+        std::swap(middle, bottom);
+    }
+}
+
+void sg::ogl::terrain::TerrainMaps::GenerateSplatmapRows(const int t_firstRow, const int t_lastRow)
+{
+    // the decoded normal xy of the columns [-1, width - 1]
+    const auto rowSize{ static_cast<size_t>(width) + 1 };
+    std::vector<float> rows(4 * rowSize);
+
+    auto* previousX{ &rows[0] };
+    auto* previousY{ &rows[rowSize] };
+    auto* currentX{ &rows[2 * rowSize] };
+    auto* currentY{ &rows[3 * rowSize] };
+
+    const auto fillRow{ [this](const int t_row, float* t_x, float* t_y)
+    {
+        const auto* src{ &normals[static_cast<size_t>(Wrap(t_row, width)) * width * NORMALMAP_CHANNELS] };
+        for (auto k{ 0 }; k <= width; ++k)
+        {
+            const auto x{ Wrap(k - 1, width) };
+            t_x[k] = FromSnorm16(src[x * NORMALMAP_CHANNELS]);
+            t_y[k] = FromSnorm16(src[x * NORMALMAP_CHANNELS + 1]);
+        }
+    } };
+
+    fillRow(t_firstRow - 1, currentX, currentY);
+
+    for (auto row{ t_firstRow }; row < t_lastRow; ++row)
+    {
+        std::swap(previousX, currentX);
+        std::swap(previousY, currentY);
+        fillRow(row, currentX, currentY);
+
+        auto* dst{ reinterpret_cast<uint32_t*>(&splats[static_cast<size_t>(row) * width * SPLATMAP_CHANNELS]) };
+        auto x{ 0 };
+
+#if defined(SG_OGL_TERRAIN_MAPS_SSE)
+        const auto quarter{ _mm_set1_ps(0.25f) };
+        const auto zero{ _mm_setzero_ps() };
+        const auto one{ _mm_set1_ps(1.0f) };
+        const auto sandOrSnowLimit{ _mm_set1_ps(0.82f) };
+        const auto grassLimit{ _mm_set1_ps(0.62f) };
+        const auto rockLimit{ _mm_set1_ps(0.32f) };
+
+        for (; x + 4 <= width; x += 4)
+        {
+            const auto nx{ _mm_mul_ps(_mm_add_ps(
+                _mm_add_ps(_mm_loadu_ps(&previousX[x]), _mm_loadu_ps(&previousX[x + 1])),
+                _mm_add_ps(_mm_loadu_ps(&currentX[x]), _mm_loadu_ps(&currentX[x + 1]))
+            ), quarter) };
+            const auto ny{ _mm_mul_ps(_mm_add_ps(
+                _mm_add_ps(_mm_loadu_ps(&previousY[x]), _mm_loadu_ps(&previousY[x + 1])),
+                _mm_add_ps(_mm_loadu_ps(&currentY[x]), _mm_loadu_ps(&currentY[x + 1]))
+            ), quarter) };
+
+            // the reconstructed z
+            const auto slope{ _mm_sqrt_ps(_mm_max_ps(zero, _mm_sub_ps(one, _mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny))))) };
+
+            const auto sandOrSnow{ _mm_castps_si128(_mm_cmpgt_ps(slope, sandOrSnowLimit)) };
+            const auto grassOrAbove{ _mm_castps_si128(_mm_cmpgt_ps(slope, grassLimit)) };
+            const auto rockOrAbove{ _mm_castps_si128(_mm_cmpgt_ps(slope, rockLimit)) };
+
+            // exactly one of the four masks is set for each texel
+            const auto r{ _mm_and_si128(sandOrSnow, _mm_set1_epi32(0x000000FF)) };
+            const auto g{ _mm_and_si128(_mm_andnot_si128(sandOrSnow, grassOrAbove), _mm_set1_epi32(0x0000FF00)) };
+            const auto b{ _mm_and_si128(_mm_andnot_si128(grassOrAbove, rockOrAbove), _mm_set1_epi32(0x00FF0000)) };
+            const auto a{ _mm_andnot_si128(rockOrAbove, _mm_set1_epi32(static_cast<int>(0xFF000000u))) };
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[x]), _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a)));
+        }
+#endif
+
+        for (; x < width; ++x)
+        {
+            const auto nx{ ((previousX[x] + previousX[x + 1]) + (currentX[x] + currentX[x + 1])) * 0.25f };
+            const auto ny{ ((previousY[x] + previousY[x + 1]) + (currentY[x] + currentY[x + 1])) * 0.25f };
+
+            dst[x] = GetSplatTexel(std::sqrt(std::max(0.0f, 1.0f - (nx * nx + ny * ny))));
+        }
+    }
+}
+
+//-------------------------------------------------
+// Cache
+//-------------------------------------------------
+
+uint64_t sg::ogl::terrain::TerrainMaps::GetCacheKey(const std::vector<uint16_t>& t_heights, const int t_width, const float t_normalStrength, ThreadPool& t_threadPool)
+{
+    SG_OGL_CORE_ASSERT(t_width > 0, "[TerrainMaps::GetCacheKey()] Invalid width.");
+    SG_OGL_CORE_ASSERT(t_heights.size() == static_cast<size_t>(t_width) * t_width, "[TerrainMaps::GetCacheKey()] Invalid number of heights.");
+
+    auto hash{ Fnv1a(&VERSION, sizeof(VERSION)) };
+    hash = Fnv1a(&t_width, sizeof(t_width), hash);
+    hash = Fnv1a(&t_normalStrength, sizeof(t_normalStrength), hash);
+
+    // the rows are hashed in parallel and their hashes are combined in order, so the key doesn't depend on the threads
+    std::vector<uint64_t> rowHashes(t_width);
+    t_threadPool.ParallelFor(static_cast<uint32_t>(t_width), [&](const uint32_t t_row)
+    {
+        rowHashes[t_row] = Fnv1aWords(&t_heights[static_cast<size_t>(t_row) * t_width], static_cast<size_t>(t_width) * sizeof(uint16_t));
+    });
+
+    return Fnv1aWords(rowHashes.data(), rowHashes.size() * sizeof(uint64_t), hash);
+}
+
+std::string sg::ogl::terrain::TerrainMaps::GetCacheFilePath(const std::string& t_cacheDirectory, const std::string& t_heightmapFilePath, const uint64_t t_key)
+{
+    std::stringstream key;
+    key << std::hex << t_key;
+
+    const auto fileName{ std::filesystem::path(t_heightmapFilePath).stem().string() + "_" + key.str() + ".maps" };
+
+    return (std::filesystem::path(t_cacheDirectory) / fileName).string();
+}
+
+bool sg::ogl::terrain::TerrainMaps::Load(const std::string& t_filePath, const uint64_t t_key)
+{
+    std::ifstream file{ t_filePath, std::ios::binary };
+    if (!file)
+    {
+        Log::SG_OGL_CORE_LOG_DEBUG("[TerrainMaps::Load()] No cached maps at {}.", t_filePath);
+        return false;
+    }
+
+    CacheHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(CacheHeader));
+
+    if (!file ||
+        std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.version != VERSION ||
+        header.key != t_key ||
+        header.width == 0)
+    {
+        Log::SG_OGL_CORE_LOG_WARN("[TerrainMaps::Load()] The cached maps at {} are out of date.", t_filePath);
+        return false;
+    }
+
+    const auto texels{ static_cast<size_t>(header.width) * header.width };
+    NormalContainer loadedNormals(texels * NORMALMAP_CHANNELS);
+    SplatContainer loadedSplats(texels * SPLATMAP_CHANNELS);
+
+    file.read(reinterpret_cast<char*>(loadedNormals.data()), static_cast<std::streamsize>(loadedNormals.size() * sizeof(int16_t)));
+    file.read(reinterpret_cast<char*>(loadedSplats.data()), static_cast<std::streamsize>(loadedSplats.size()));
+
+    if (!file)
+    {
+        Log::SG_OGL_CORE_LOG_WARN("[TerrainMaps::Load()] The cached maps at {} are truncated.", t_filePath);
+        return false;
+    }
+
+    width = static_cast<int>(header.width);
+    normals = std::move(loadedNormals);
+    splats = std::move(loadedSplats);
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[TerrainMaps::Load()] The normalmap and the splatmap were loaded from {}.", t_filePath);
+
+    return true;
+}
+
+bool sg::ogl::terrain::TerrainMaps::Save(const std::string& t_filePath, const uint64_t t_key) const
+{
+    CacheHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = VERSION;
+    header.width = static_cast<uint32_t>(width);
+    header.key = t_key;
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(std::filesystem::path(t_filePath).parent_path(), errorCode);
+
+    std::ofstream file{ t_filePath, std::ios::binary | std::ios::trunc };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+    file.write(reinterpret_cast<const char*>(normals.data()), static_cast<std::streamsize>(normals.size() * sizeof(int16_t)));
+    file.write(reinterpret_cast<const char*>(splats.data()), static_cast<std::streamsize>(splats.size()));
+
+    if (!file)
+    {
+        Log::SG_OGL_CORE_LOG_WARN("[TerrainMaps::Save()] The maps could not be written to {}.", t_filePath);
+        return false;
+    }
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[TerrainMaps::Save()] The normalmap and the splatmap were written to {}.", t_filePath);
+
+    return true;
+}
@@ -0,0 +1,117 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: TerrainMaps.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace sg::ogl
+{
+    class ThreadPool;
+}
+
+namespace sg::ogl::terrain
+{
+    /**
+     * @brief The normalmap and the splatmap of a terrain in their resident formats:
+     *        the normal xy as RG16_SNORM (z is reconstructed) and the splat weights as RGBA8.
+     *        Nothing in here needs an OpenGL context, so the maps can be generated and
+     *        cached by a headless build step.
+     */
+    class TerrainMaps
+    {
+    public:
+        using NormalContainer = std::vector<int16_t>;
+        using SplatContainer = std::vector<uint8_t>;
+
+        static constexpr uint32_t NORMALMAP_CHANNELS{ 2 };
+        static constexpr uint32_t SPLATMAP_CHANNELS{ 4 };
+
+        /**
+         * @brief Increase if the content of the maps changes.
+         */
+        static constexpr uint32_t VERSION{ 1 };
+
+        /**
+         * @brief The number of rows of a tile of the CPU generation.
+         */
+        static constexpr int TILE_ROWS{ 32 };
+
+        //-------------------------------------------------
+        // Public member
+        //-------------------------------------------------
+
+        int width{ 0 };
+        NormalContainer normals;
+        SplatContainer splats;
+
+        //-------------------------------------------------
+        // Generate
+        //-------------------------------------------------
+
+        /**
+         * @brief Computes both maps on the CPU like the normalmap and splatmap compute shaders do.
+         *        The rows are split into tiles which are processed in parallel; the inner loops use SSE2 if available.
+         * @param t_heights The 16-bit heightmap values, row by row.
+         * @param t_width The width and height of the heightmap.
+         * @param t_normalStrength The z of the unnormalized normal is 1 / t_normalStrength.
+         * @param t_threadPool The worker threads.
+         * @return The maps.
+         */
+        static TerrainMaps Generate(const std::vector<uint16_t>& t_heights, int t_width, float t_normalStrength, ThreadPool& t_threadPool);
+
+        //-------------------------------------------------
+        // Cache
+        //-------------------------------------------------
+
+        /**
+         * @brief An FNV-1a hash of everything the maps depend on. The rows are hashed
+         *        in parallel over 64-bit words; the row hashes are combined in order.
+         * @param t_heights The 16-bit heightmap values, row by row.
+         * @param t_width The width and height of the heightmap.
+         * @param t_normalStrength The normal strength.
+         * @param t_threadPool The worker threads.
+         * @return The key of the cache file.
+         */
+        static uint64_t GetCacheKey(const std::vector<uint16_t>& t_heights, int t_width, float t_normalStrength, ThreadPool& t_threadPool);
+
+        /**
+         * @brief The name of the cache file for a heightmap.
+         * @param t_cacheDirectory The directory of the cache files.
+         * @param t_heightmapFilePath The file path of the heightmap.
+         * @param t_key The key of the cache file.
+         * @return The file path.
+         */
+        static std::string GetCacheFilePath(const std::string& t_cacheDirectory, const std::string& t_heightmapFilePath, uint64_t t_key);
+
+        /**
+         * @brief Reads the maps from a cache file.
+         * @param t_filePath The file path.
+         * @param t_key The expected key.
+         * @return False if there is no file or the file is out of date or truncated.
+         */
+        bool Load(const std::string& t_filePath, uint64_t t_key);
+
+        /**
+         * @brief Writes the maps to a cache file; creates the directory if necessary.
+         * @param t_filePath The file path.
+         * @param t_key The key of the maps.
+         * @return False if the file could not be written.
+         */
+        bool Save(const std::string& t_filePath, uint64_t t_key) const;
+
+    protected:
+
+    private:
+        void GenerateNormalmapRows(const std::vector<uint16_t>& t_heights, float t_normalStrength, int t_firstRow, int t_lastRow);
+        void GenerateSplatmapRows(int t_firstRow, int t_lastRow);
+    };
+}
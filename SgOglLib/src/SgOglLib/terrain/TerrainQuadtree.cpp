@@ -0,0 +1,721 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: TerrainQuadtree.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <algorithm>
+#include <limits>
+#include <glm/gtc/matrix_transform.hpp>
+#include "TerrainQuadtree.h"
+#include "TerrainConfig.h"
+#include "OpenGl.h"
+#include "Core.h"
+#include "Application.h"
+#include "Window.h"
+#include "camera/Camera.h"
+#include "buffer/Vao.h"
+#include "buffer/Vbo.h"
+#include "resource/Mesh.h"
+#include "resource/ModelManager.h"
+#include "resource/ShaderProgram.h"
+#include "resource/TextureManager.h"
+#include "scene/Scene.h"
+#include "ThreadPool.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+sg::ogl::terrain::TerrainQuadtree::TerrainQuadtree(scene::Scene* t_scene, const TerrainConfigSharedPtr& t_terrainConfig)
+    : m_scene{ t_scene }
+    , m_terrainConfig{ t_terrainConfig }
+{
+    SG_OGL_CORE_ASSERT(t_scene, "[TerrainQuadtree::TerrainQuadtree()] Null pointer.");
+    SG_OGL_CORE_ASSERT(t_terrainConfig, "[TerrainQuadtree::TerrainQuadtree()] Null pointer.");
+    SG_OGL_CORE_ASSERT(!t_terrainConfig->GetLodMorphingArea().empty(), "[TerrainQuadtree::TerrainQuadtree()] No Morphing Area values / Call the Init Function.");
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[TerrainQuadtree::TerrainQuadtree()] Create TerrainQuadtree.");
+
+    m_worldTransform.scale = glm::vec3(m_terrainConfig->scaleXz, m_terrainConfig->scaleY, m_terrainConfig->scaleXz);
+    m_worldTransform.position.x = -m_terrainConfig->scaleXz * 0.5f;
+    m_worldTransform.position.z = -m_terrainConfig->scaleXz * 0.5f;
+    m_worldTransform.position.y = 0.0f;
+
+    InitChunks();
+    InitPatchMesh();
+}
+
+sg::ogl::terrain::TerrainQuadtree::~TerrainQuadtree() noexcept
+{
+    Log::SG_OGL_CORE_LOG_DEBUG("[TerrainQuadtree::~TerrainQuadtree()] Destruct TerrainQuadtree.");
+
+    // the worker threads use the chunks
+    for (auto& chunk : m_chunks)
+    {
+        chunk->job->Wait();
+    }
+
+    buffer::Vbo::DeleteVbo(m_vboId);
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+uint32_t sg::ogl::terrain::TerrainQuadtree::GetNumberOfChunks() const noexcept
+{
+    return static_cast<uint32_t>(m_chunks.size());
+}
+
+uint32_t sg::ogl::terrain::TerrainQuadtree::GetNumberOfVisibleLeaves() const noexcept
+{
+    return m_instanceCount;
+}
+
+uint32_t sg::ogl::terrain::TerrainQuadtree::GetNumberOfEvaluatedNodes() const noexcept
+{
+    return m_evaluatedNodes;
+}
+
+uint32_t sg::ogl::terrain::TerrainQuadtree::GetNumberOfSplits() const noexcept
+{
+    return m_splits;
+}
+
+uint32_t sg::ogl::terrain::TerrainQuadtree::GetNumberOfMerges() const noexcept
+{
+    return m_merges;
+}
+
+//-------------------------------------------------
+// Init
+//-------------------------------------------------
+
+void sg::ogl::terrain::TerrainQuadtree::InitChunks()
+{
+    const auto rootNodes{ m_terrainConfig->rootNodes };
+    const auto nrRootNodes{ static_cast<uint32_t>(rootNodes * rootNodes) };
+    const auto nrLods{ static_cast<int>(m_terrainConfig->lodRanges.size()) };
+
+    // one chunk per worker thread
+    const auto nrChunks{ std::max(1u, std::min(nrRootNodes, m_scene->GetApplicationContext()->GetThreadPool().GetNumberOfThreads())) };
+
+    // the root nodes are interleaved, so that the nodes near the camera are spread over all chunks
+    for (auto c{ 0u }; c < nrChunks; ++c)
+    {
+        auto& chunk{ m_chunks.emplace_back(std::make_unique<Chunk>(nrLods, (nrRootNodes - c + nrChunks - 1) / nrChunks)) };
+        chunk->job = std::make_unique<ThreadPool::Job>([this, &chunk = *chunk]() { UpdateChunk(chunk); });
+    }
+
+    for (auto i{ 0 }; i < rootNodes; ++i)
+    {
+        for (auto j{ 0 }; j < rootNodes; ++j)
+        {
+            const auto root{ static_cast<uint32_t>(i * rootNodes + j) };
+            auto& chunk{ *m_chunks[root % nrChunks] };
+            const auto index{ root / nrChunks };
+
+            auto& node{ chunk.nodePool.Get(START_LOD, index) };
+            InitNode(
+                node,
+                START_LOD,
+                glm::vec2(i / static_cast<float>(rootNodes), j / static_cast<float>(rootNodes)),
+                glm::vec2(i, j)
+            );
+
+            AddLeaf(chunk, node, index);
+        }
+    }
+
+    // the root nodes are drawn until the first update is finished
+    for (auto& chunk : m_chunks)
+    {
+        ApplyDeltas(*chunk);
+    }
+}
+
+void sg::ogl::terrain::TerrainQuadtree::InitPatchMesh()
+{
+    // create Mesh
+    m_patchMesh = std::make_unique<resource::Mesh>();
+    SG_OGL_CORE_ASSERT(m_patchMesh, "[TerrainQuadtree::InitPatchMesh()] Null pointer.");
+
+    // create BufferLayout
+    const buffer::BufferLayout bufferLayout{
+        { buffer::VertexAttributeType::POSITION_2D, "aPosition" },
+    };
+
+    // add Vbo
+    auto vertices{ resource::ModelManager::GetTerrainPatchVertices() };
+    m_patchMesh->GetVao().AddVertexDataVbo(vertices.data(), static_cast<int32_t>(vertices.size()) / 2, bufferLayout);
+
+    // create an additional empty Vbo for instanced data
+    m_vboId = buffer::Vbo::GenerateVbo();
+
+    // init empty
+    m_vboSize = static_cast<uint32_t>(m_terrainConfig->rootNodes * m_terrainConfig->rootNodes) * 4;
+    buffer::Vbo::InitEmpty(m_vboId, NUMBER_OF_FLOATS_PER_INSTANCE * m_vboSize, GL_STREAM_DRAW);
+
+    // add the empty Vbo to the Mesh
+    auto& vao{ m_patchMesh->GetVao() };
+    vao.BindVao();
+
+    // and set the layout
+    buffer::Vbo::AddInstancedAttribute(m_vboId, 1, 4, NUMBER_OF_FLOATS_PER_INSTANCE, 0);
+    buffer::Vbo::AddInstancedAttribute(m_vboId, 2, 2, NUMBER_OF_FLOATS_PER_INSTANCE, 4);
+
+    buffer::Vao::UnbindVao();
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void sg::ogl::terrain::TerrainQuadtree::UpdateQuadtree()
+{
+    // the last update is used when it is finished; otherwise the render thread keeps the older leaves
+    if (IsUpdateRunning())
+    {
+        return;
+    }
+
+    PublishUpdate();
+
+    // the frustum planes were updated by the Scene
+    const auto& camera{ m_scene->GetCurrentCamera() };
+
+    const auto moved{ glm::distance(camera.GetPosition(), m_lastCameraPosition) };
+    const auto turned{ camera.GetYaw() != m_lastCameraYaw || camera.GetPitch() != m_lastCameraPitch };
+
+    // nothing to do for an idle or a slowly moving camera
+    if (!m_firstUpdate && !turned && moved < m_terrainConfig->lodUpdateDistance)
+    {
+        return;
+    }
+
+    // the distance to any node changes at most by the distance moved
+    m_odometer += m_firstUpdate ? 0.0f : moved;
+
+    m_lastCameraPosition = camera.GetPosition();
+    m_lastCameraYaw = camera.GetYaw();
+    m_lastCameraPitch = camera.GetPitch();
+    m_firstUpdate = false;
+
+    m_snapshot.cameraPosition = camera.GetPosition();
+    m_snapshot.frustumPlanes = camera.GetFrustumPlanes();
+    m_snapshot.odometer = m_odometer;
+
+    auto& threadPool{ m_scene->GetApplicationContext()->GetThreadPool() };
+    for (auto& chunk : m_chunks)
+    {
+        threadPool.Run(*chunk->job);
+    }
+
+    m_updateRunning = true;
+}
+
+void sg::ogl::terrain::TerrainQuadtree::WaitForUpdate()
+{
+    PublishUpdate();
+}
+
+void sg::ogl::terrain::TerrainQuadtree::Render(resource::ShaderProgram& t_shaderProgram, const std::vector<light::DirectionalLight>& t_directionalLights)
+{
+    CollectLeaves();
+
+    if (m_instanceCount == 0)
+    {
+        return;
+    }
+
+    UploadLeaves();
+
+    SetSharedUniforms(t_shaderProgram);
+
+    t_shaderProgram.SetUniform("viewMatrix", m_scene->GetCurrentCamera().GetViewMatrix());
+
+    t_shaderProgram.SetUniform("normalmap", 1);
+    resource::TextureManager::BindForReading(m_terrainConfig->GetNormalmapTextureId(), GL_TEXTURE1);
+    resource::TextureManager::UseBilinearFilter();
+
+    t_shaderProgram.SetUniform("splatmap", 2);
+    resource::TextureManager::BindForReading(m_terrainConfig->GetSplatmapTextureId(), GL_TEXTURE2);
+    resource::TextureManager::UseBilinearFilter();
+
+    t_shaderProgram.SetUniform("sand", 3);
+    resource::TextureManager::BindForReading(m_terrainConfig->GetSandTextureId(), GL_TEXTURE3);
+
+    t_shaderProgram.SetUniform("grass", 4);
+    resource::TextureManager::BindForReading(m_terrainConfig->GetGrassTextureId(), GL_TEXTURE4);
+
+    t_shaderProgram.SetUniform("rock", 5);
+    resource::TextureManager::BindForReading(m_terrainConfig->GetRockTextureId(), GL_TEXTURE5);
+
+    t_shaderProgram.SetUniform("snow", 6);
+    resource::TextureManager::BindForReading(m_terrainConfig->GetSnowTextureId(), GL_TEXTURE6);
+
+    t_shaderProgram.SetUniform("ambientIntensity", m_scene->GetAmbientIntensity());
+    t_shaderProgram.SetUniform("numDirectionalLights", static_cast<int32_t>(t_directionalLights.size()));
+    t_shaderProgram.SetUniform("directionalLights", t_directionalLights);
+
+    DrawLeaves();
+}
+
+void sg::ogl::terrain::TerrainQuadtree::RenderWireframe(resource::ShaderProgram& t_shaderProgram)
+{
+    CollectLeaves();
+
+    if (m_instanceCount == 0)
+    {
+        return;
+    }
+
+    UploadLeaves();
+
+    SetSharedUniforms(t_shaderProgram);
+
+    DrawLeaves();
+}
+
+//-------------------------------------------------
+// Jobs
+//-------------------------------------------------
+
+bool sg::ogl::terrain::TerrainQuadtree::IsUpdateRunning() const
+{
+    for (const auto& chunk : m_chunks)
+    {
+        if (!chunk->job->IsDone())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void sg::ogl::terrain::TerrainQuadtree::PublishUpdate()
+{
+    if (!m_updateRunning)
+    {
+        return;
+    }
+
+    // rethrows an exception of a worker thread
+    for (auto& chunk : m_chunks)
+    {
+        chunk->job->Get();
+    }
+
+    m_updateRunning = false;
+
+    m_evaluatedNodes = 0;
+    m_splits = 0;
+    m_merges = 0;
+
+    for (auto& chunk : m_chunks)
+    {
+        ApplyDeltas(*chunk);
+
+        m_evaluatedNodes += chunk->evaluatedNodes;
+        m_splits += chunk->splits;
+        m_merges += chunk->merges;
+    }
+}
+
+void sg::ogl::terrain::TerrainQuadtree::ApplyDeltas(Chunk& t_chunk)
+{
+    auto& leaves{ t_chunk.frontLeaves };
+
+    for (const auto& delta : t_chunk.deltas)
+    {
+        if (delta.type == LeafDelta::Type::ADD)
+        {
+            leaves.push_back(delta.leaf);
+        }
+        else
+        {
+            leaves[delta.slot] = leaves.back();
+            leaves.pop_back();
+        }
+    }
+
+    // the capacity is kept for the next update
+    t_chunk.deltas.clear();
+}
+
+//-------------------------------------------------
+// Update
+//-------------------------------------------------
+
+void sg::ogl::terrain::TerrainQuadtree::UpdateChunk(Chunk& t_chunk) const
+{
+    t_chunk.evaluatedNodes = 0;
+    t_chunk.splits = 0;
+    t_chunk.merges = 0;
+
+    for (auto i{ 0u }; i < t_chunk.nodePool.GetNumberOfRootNodes(); ++i)
+    {
+        UpdateNode(t_chunk, START_LOD, i, camera::Camera::ALL_FRUSTUM_PLANES);
+    }
+}
+
+float sg::ogl::terrain::TerrainQuadtree::UpdateNode(Chunk& t_chunk, const int t_lod, const uint32_t t_index, uint32_t t_planeMask) const
+{
+    // the children are allocated in the next level, so this reference stays valid
+    auto& node{ t_chunk.nodePool.Get(t_lod, t_index) };
+
+    // no lod range of the subtree can be reached yet
+    if (node.nextUpdate > m_snapshot.odometer)
+    {
+        return node.nextUpdate;
+    }
+
+    t_chunk.evaluatedNodes++;
+
+    const auto distance{ glm::distance(m_snapshot.cameraPosition, node.center) };
+    const auto splitRange{ static_cast<float>(m_terrainConfig->lodRanges[t_lod]) };
+    const auto mergeRange{ splitRange * (1.0f + m_terrainConfig->lodHysteresis) };
+    const auto lastLod{ t_lod == t_chunk.nodePool.GetNumberOfLods() - 1 };
+
+    // merging is cheap and gives the nodes back to the pool, also outside of the frustum
+    if (distance >= (node.IsLeaf() ? splitRange : mergeRange))
+    {
+        Merge(t_chunk, node, t_index);
+        node.nextUpdate = lastLod ? std::numeric_limits<float>::max() : m_snapshot.odometer + distance - splitRange;
+
+        return node.nextUpdate;
+    }
+
+    // the visibility is tested again at the next evaluation
+    if (!IsVisible(node, t_planeMask))
+    {
+        MergeOutOfRange(t_chunk, node);
+        node.nextUpdate = m_snapshot.odometer;
+
+        return node.nextUpdate;
+    }
+
+    if (lastLod)
+    {
+        node.nextUpdate = std::numeric_limits<float>::max();
+
+        return node.nextUpdate;
+    }
+
+    Split(t_chunk, node);
+
+    auto nextUpdate{ m_snapshot.odometer + mergeRange - distance };
+    for (auto c{ 0u }; c < 4; ++c)
+    {
+        nextUpdate = std::min(nextUpdate, UpdateNode(t_chunk, t_lod + 1, node.firstChild + c, t_planeMask));
+    }
+
+    node.nextUpdate = nextUpdate;
+
+    return node.nextUpdate;
+}
+
+void sg::ogl::terrain::TerrainQuadtree::MergeOutOfRange(Chunk& t_chunk, Node& t_node) const
+{
+    if (t_node.IsLeaf())
+    {
+        return;
+    }
+
+    const auto lod{ t_node.lod + 1 };
+    const auto mergeRange{ static_cast<float>(m_terrainConfig->lodRanges[lod]) * (1.0f + m_terrainConfig->lodHysteresis) };
+
+    for (auto c{ 0u }; c < 4; ++c)
+    {
+        const auto index{ t_node.firstChild + c };
+        auto& child{ t_chunk.nodePool.Get(lod, index) };
+
+        if (child.IsLeaf())
+        {
+            continue;
+        }
+
+        t_chunk.evaluatedNodes++;
+
+        // the subtree has changed, so the child is evaluated again when it becomes visible
+        child.nextUpdate = m_snapshot.odometer;
+
+        if (glm::distance(m_snapshot.cameraPosition, child.center) >= mergeRange)
+        {
+            Merge(t_chunk, child, index);
+        }
+        else
+        {
+            MergeOutOfRange(t_chunk, child);
+        }
+    }
+}
+
+//-------------------------------------------------
+// Render
+//-------------------------------------------------
+
+void sg::ogl::terrain::TerrainQuadtree::CollectLeaves()
+{
+    // the camera may have been moved for a reflection pass
+    auto& camera{ m_scene->GetCurrentCamera() };
+    camera.UpdateFrustumPlanes();
+
+    // the capacity of the last frames is kept
+    m_instancedData.clear();
+    m_instanceCount = 0;
+
+    for (const auto& chunk : m_chunks)
+    {
+        for (const auto& leaf : chunk->frontLeaves)
+        {
+            auto planeMask{ camera::Camera::ALL_FRUSTUM_PLANES };
+            if (!camera.IsAabbInFrustum(leaf.aabbMin, leaf.aabbMax, planeMask))
+            {
+                continue;
+            }
+
+            // location + index
+            m_instancedData.push_back(leaf.location.x);
+            m_instancedData.push_back(leaf.location.y);
+            m_instancedData.push_back(leaf.index.x);
+            m_instancedData.push_back(leaf.index.y);
+
+            // gap + lod
+            m_instancedData.push_back(leaf.gap);
+            m_instancedData.push_back(leaf.lod);
+
+            m_instanceCount++;
+        }
+    }
+}
+
+void sg::ogl::terrain::TerrainQuadtree::UploadLeaves()
+{
+    glBindBuffer(GL_ARRAY_BUFFER, m_vboId);
+
+    // grow the Vbo if necessary; otherwise orphan the old storage
+    if (m_vboSize < m_instanceCount)
+    {
+        m_vboSize = std::max(m_instanceCount, m_vboSize * 2);
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, NUMBER_OF_FLOATS_PER_INSTANCE * static_cast<size_t>(m_vboSize) * sizeof(float), nullptr, GL_STREAM_DRAW);
+
+    glBufferSubData(
+        GL_ARRAY_BUFFER,
+        0,
+        NUMBER_OF_FLOATS_PER_INSTANCE * static_cast<size_t>(m_instanceCount) * sizeof(float),
+        m_instancedData.data()
+    );
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void sg::ogl::terrain::TerrainQuadtree::SetSharedUniforms(resource::ShaderProgram& t_shaderProgram) const
+{
+    const auto projectionMatrix{ m_scene->GetApplicationContext()->GetWindow().GetProjectionMatrix() };
+
+    t_shaderProgram.SetUniform("worldMatrix", static_cast<glm::mat4>(m_worldTransform));
+    t_shaderProgram.SetUniform("viewProjectionMatrix", projectionMatrix * m_scene->GetCurrentCamera().GetViewMatrix());
+
+    t_shaderProgram.SetUniform("cameraPosition", m_scene->GetCurrentCamera().GetPosition());
+    t_shaderProgram.SetUniform("scaleXz", m_terrainConfig->scaleXz);
+    t_shaderProgram.SetUniform("scaleY", m_terrainConfig->scaleY);
+    t_shaderProgram.SetUniform("lodMorphArea", m_terrainConfig->GetLodMorphingArea());
+
+    t_shaderProgram.SetUniform("tessellationFactor", m_terrainConfig->tessellationFactor);
+    t_shaderProgram.SetUniform("tessellationSlope", m_terrainConfig->tessellationSlope);
+    t_shaderProgram.SetUniform("tessellationShift", m_terrainConfig->tessellationShift);
+
+    t_shaderProgram.SetUniform("tessellationEnabled", m_terrainConfig->tessellationEnabled);
+    t_shaderProgram.SetUniform("morphingEnabled", m_terrainConfig->morphingEnabled);
+
+    t_shaderProgram.SetUniform("heightmap", 0);
+    resource::TextureManager::BindForReading(m_terrainConfig->GetHeightmapTextureId(), GL_TEXTURE0);
+    resource::TextureManager::UseBilinearFilter();
+}
+
+void sg::ogl::terrain::TerrainQuadtree::DrawLeaves() const
+{
+    m_patchMesh->InitDraw();
+    glPatchParameteri(GL_PATCH_VERTICES, 16);
+    m_patchMesh->DrawInstanced(static_cast<int32_t>(m_instanceCount), GL_PATCHES);
+    resource::Mesh::EndDraw();
+}
+
+//-------------------------------------------------
+// Culling
+//-------------------------------------------------
+
+bool sg::ogl::terrain::TerrainQuadtree::IsVisible(const Node& t_node, uint32_t& t_planeMask) const
+{
+    // the parent is completely inside of the frustum
+    if (t_planeMask == 0)
+    {
+        return true;
+    }
+
+    return camera::Camera::IsAabbInFrustum(m_snapshot.frustumPlanes, t_node.aabbMin, t_node.aabbMax, t_planeMask);
+}
+
+//-------------------------------------------------
+// Add / Remove
+//-------------------------------------------------
+
+void sg::ogl::terrain::TerrainQuadtree::InitNode(Node& t_node, const int t_lod, const glm::vec2& t_location, const glm::vec2& t_index) const
+{
+    t_node.lod = t_lod;
+    t_node.location = t_location;
+    t_node.index = t_index;
+    t_node.gap = 1.0f / (static_cast<float>(m_terrainConfig->rootNodes) * POW2_F[t_lod]);
+    t_node.firstChild = Node::INVALID_INDEX;
+    t_node.nextUpdate = 0.0f;
+    t_node.leafSlot = Node::INVALID_INDEX;
+
+    // the center in world space
+    auto loc{ t_location + t_node.gap * 0.5f };
+    loc *= m_terrainConfig->scaleXz;
+    loc -= m_terrainConfig->scaleXz * 0.5f;
+
+    t_node.center = glm::vec3(loc.x, m_terrainConfig->GetHeightAt(loc.x, loc.y), loc.y);
+
+    // the heightmap values below the node + one texel for the bilinear filter
+    const auto width{ static_cast<float>(m_terrainConfig->GetHeightmapWidth()) };
+
+    float minHeight, maxHeight;
+    m_terrainConfig->GetHeightPyramid().GetRange(
+        static_cast<int>(floor(t_location.x * width)) - 1,
+        static_cast<int>(floor(t_location.y * width)) - 1,
+        static_cast<int>(ceil((t_location.x + t_node.gap) * width)),
+        static_cast<int>(ceil((t_location.y + t_node.gap) * width)),
+        minHeight,
+        maxHeight
+    );
+
+    const auto scaleXz{ m_terrainConfig->scaleXz };
+    const auto scaleY{ m_terrainConfig->scaleY };
+
+    t_node.aabbMin = glm::vec3(t_location.x * scaleXz - scaleXz * 0.5f, minHeight * scaleY, t_location.y * scaleXz - scaleXz * 0.5f);
+    t_node.aabbMax = glm::vec3((t_location.x + t_node.gap) * scaleXz - scaleXz * 0.5f, maxHeight * scaleY, (t_location.y + t_node.gap) * scaleXz - scaleXz * 0.5f);
+}
+
+void sg::ogl::terrain::TerrainQuadtree::Split(Chunk& t_chunk, Node& t_node) const
+{
+    if (!t_node.IsLeaf())
+    {
+        return;
+    }
+
+    RemoveLeaf(t_chunk, t_node);
+    Add4Children(t_chunk, t_node);
+
+    t_chunk.splits++;
+}
+
+void sg::ogl::terrain::TerrainQuadtree::Merge(Chunk& t_chunk, Node& t_node, const uint32_t t_index) const
+{
+    if (t_node.IsLeaf())
+    {
+        return;
+    }
+
+    RemoveChildren(t_chunk, t_node);
+    AddLeaf(t_chunk, t_node, t_index);
+
+    t_chunk.merges++;
+}
+
+void sg::ogl::terrain::TerrainQuadtree::Add4Children(Chunk& t_chunk, Node& t_node) const
+{
+    const auto lod{ t_node.lod + 1 };
+    t_node.firstChild = t_chunk.nodePool.Allocate4(lod);
+
+    for (auto i{ 0 }; i < 2; ++i)
+    {
+        for (auto j{ 0 }; j < 2; ++j)
+        {
+            const auto index{ t_node.firstChild + i * 2 + j };
+            auto& child{ t_chunk.nodePool.Get(lod, index) };
+
+            const auto loc{ t_node.location + glm::vec2(i * t_node.gap / 2.0f, j * t_node.gap / 2.0f) };
+            InitNode(child, lod, loc, glm::vec2(i, j));
+
+            AddLeaf(t_chunk, child, index);
+        }
+    }
+}
+
+void sg::ogl::terrain::TerrainQuadtree::RemoveChildren(Chunk& t_chunk, Node& t_node) const
+{
+    const auto lod{ t_node.lod + 1 };
+
+    for (auto c{ 0u }; c < 4; ++c)
+    {
+        auto& child{ t_chunk.nodePool.Get(lod, t_node.firstChild + c) };
+
+        if (child.IsLeaf())
+        {
+            RemoveLeaf(t_chunk, child);
+        }
+        else
+        {
+            RemoveChildren(t_chunk, child);
+        }
+    }
+
+    t_chunk.nodePool.Free4(lod, t_node.firstChild);
+    t_node.firstChild = Node::INVALID_INDEX;
+}
+
+void sg::ogl::terrain::TerrainQuadtree::AddLeaf(Chunk& t_chunk, Node& t_node, const uint32_t t_index)
+{
+    t_node.leafSlot = static_cast<uint32_t>(t_chunk.leaves.size());
+
+    Leaf leaf;
+    leaf.location = t_node.location;
+    leaf.index = t_node.index;
+    leaf.gap = t_node.gap;
+    leaf.lod = static_cast<float>(t_node.lod);
+    leaf.aabbMin = t_node.aabbMin;
+    leaf.aabbMax = t_node.aabbMax;
+
+    t_chunk.leaves.push_back(leaf);
+    t_chunk.leafOwners.push_back({ t_node.lod, t_index });
+
+    LeafDelta delta;
+    delta.type = LeafDelta::Type::ADD;
+    delta.leaf = leaf;
+    t_chunk.deltas.push_back(delta);
+}
+
+void sg::ogl::terrain::TerrainQuadtree::RemoveLeaf(Chunk& t_chunk, Node& t_node)
+{
+    const auto slot{ t_node.leafSlot };
+    const auto last{ static_cast<uint32_t>(t_chunk.leaves.size()) - 1 };
+
+    // move the last leaf into the gap
+    if (slot != last)
+    {
+        t_chunk.leaves[slot] = t_chunk.leaves[last];
+        t_chunk.leafOwners[slot] = t_chunk.leafOwners[last];
+
+        const auto& owner{ t_chunk.leafOwners[slot] };
+        t_chunk.nodePool.Get(owner.lod, owner.index).leafSlot = slot;
+    }
+
+    t_chunk.leaves.pop_back();
+    t_chunk.leafOwners.pop_back();
+
+    LeafDelta delta;
+    delta.type = LeafDelta::Type::REMOVE;
+    delta.slot = slot;
+    t_chunk.deltas.push_back(delta);
+
+    t_node.leafSlot = Node::INVALID_INDEX;
+}
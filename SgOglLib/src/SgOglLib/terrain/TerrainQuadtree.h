@@ -9,82 +9,368 @@
 
 #pragma once
 
-#include "Node.h"
-#include "TerrainConfig.h"
-#include "scene/Scene.h"
+#include <vector>
+#include <memory>
+#include "NodePool.h"
+#include "ThreadPool.h"
+#include "math/Transform.h"
+#include "math/Plane.h"
+#include "light/DirectionalLight.h"
+
+namespace sg::ogl::resource
+{
+    class Mesh;
+    class ShaderProgram;
+}
+
+namespace sg::ogl::scene
+{
+    class Scene;
+}
 
 namespace sg::ogl::terrain
 {
-    class TerrainQuadtree : public Node
+    class TerrainConfig;
+
+    /**
+     * @brief Selects the lod of the terrain patches and draws all visible leaves
+     *        with a single instanced draw call.
+     *        The root nodes are distributed over chunks, which are updated in parallel
+     *        on the worker threads. Each chunk keeps its leaves in a list, which is
+     *        changed by the splits and merges only. The changes are recorded as leaf
+     *        deltas, which the render thread applies to its own copy of the leaves one
+     *        frame later.
+     */
+    class TerrainQuadtree
     {
     public:
+        using MeshUniquePtr = std::unique_ptr<resource::Mesh>;
+        using TerrainConfigSharedPtr = std::shared_ptr<TerrainConfig>;
+        using InstancedDataContainer = std::vector<float>;
+
         static constexpr auto START_LOD{ 0 };
 
+        /**
+         * @brief Instanced data: location + index, gap + lod.
+         */
+        static constexpr uint32_t NUMBER_OF_FLOATS_PER_INSTANCE{ 6 };
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
 
-        explicit TerrainQuadtree(scene::Scene* t_scene, const TerrainConfigSharedPtr& t_terrainConfig)
-            : Node(t_scene, t_terrainConfig, START_LOD, glm::vec2(0.0f), glm::vec2(0.0f))
-        {
-            SG_OGL_CORE_ASSERT(t_terrainConfig, "[TerrainQuadtree::TerrainQuadtree()] Null pointer.");
-            SG_OGL_CORE_ASSERT(!t_terrainConfig->GetLodMorphingArea().empty(), "[TerrainQuadtree::TerrainQuadtree()] No Morphing Area values / Call the Init Function.");
-            Log::SG_OGL_CORE_LOG_DEBUG("[TerrainQuadtree::TerrainQuadtree()] Create TerrainQuadtree.");
+        TerrainQuadtree() = delete;
 
-            for (auto i{ 0 }; i < m_terrainConfig->rootNodes; ++i)
-            {
-                for (auto j{ 0 }; j < m_terrainConfig->rootNodes; ++j)
-                {
-                    AddChild(std::make_unique<Node>(
-                        t_scene,
-                        m_terrainConfig,
-                        START_LOD,
-                        glm::vec2(i / static_cast<float>(m_terrainConfig->rootNodes), j / static_cast<float>(m_terrainConfig->rootNodes)),
-                        glm::vec2(i, j)
-                        )
-                    );
-                }
-            }
-        }
+        TerrainQuadtree(scene::Scene* t_scene, const TerrainConfigSharedPtr& t_terrainConfig);
 
         TerrainQuadtree(const TerrainQuadtree& t_other) = delete;
         TerrainQuadtree(TerrainQuadtree&& t_other) noexcept = delete;
         TerrainQuadtree& operator=(const TerrainQuadtree& t_other) = delete;
         TerrainQuadtree& operator=(TerrainQuadtree&& t_other) noexcept = delete;
 
-        virtual ~TerrainQuadtree() noexcept
-        {
-            Log::SG_OGL_CORE_LOG_DEBUG("[TerrainQuadtree::~TerrainQuadtree()] Destruct TerrainQuadtree.");
-        }
+        /**
+         * @brief Waits for a running update.
+         */
+        ~TerrainQuadtree() noexcept;
 
         //-------------------------------------------------
-        // Update
+        // Getter
         //-------------------------------------------------
 
-        void UpdateQuadtree()
-        {
-            for (const auto& child : m_children)
-            {
-                child->Update();
-            }
-        }
+        [[nodiscard]] uint32_t GetNumberOfChunks() const noexcept;
+
+        /**
+         * @brief The number of patches drawn by the last render call.
+         */
+        [[nodiscard]] uint32_t GetNumberOfVisibleLeaves() const noexcept;
+
+        /**
+         * @brief The number of nodes evaluated by the last finished update.
+         */
+        [[nodiscard]] uint32_t GetNumberOfEvaluatedNodes() const noexcept;
+
+        /**
+         * @brief The number of splits of the last finished update.
+         */
+        [[nodiscard]] uint32_t GetNumberOfSplits() const noexcept;
+
+        /**
+         * @brief The number of merges of the last finished update.
+         */
+        [[nodiscard]] uint32_t GetNumberOfMerges() const noexcept;
 
         //-------------------------------------------------
-        // Debug
+        // Logic
         //-------------------------------------------------
 
-        void Count(int& t_value)
-        {
-            for (const auto& child : m_children)
-            {
-                child->NodesCount(t_value);
-                t_value++;
-            }
-        }
+        /**
+         * @brief Publishes the result of the last update if it is finished and starts
+         *        a new update on the worker threads. Does not wait.
+         */
+        void UpdateQuadtree();
+
+        /**
+         * @brief Waits for a running update and publishes its result.
+         */
+        void WaitForUpdate();
+
+        void Render(resource::ShaderProgram& t_shaderProgram, const std::vector<light::DirectionalLight>& t_directionalLights);
+        void RenderWireframe(resource::ShaderProgram& t_shaderProgram);
 
     protected:
 
     private:
+        /**
+         * @brief A leaf as it is used by the render thread.
+         */
+        struct Leaf
+        {
+            // the instanced data
+            glm::vec2 location{ glm::vec2(0.0f) };
+            glm::vec2 index{ glm::vec2(0.0f) };
+            float gap{ 1.0f };
+            float lod{ 0.0f };
+
+            // for the culling
+            glm::vec3 aabbMin{ glm::vec3(0.0f) };
+            glm::vec3 aabbMax{ glm::vec3(0.0f) };
+        };
+
+        /**
+         * @brief The node of a leaf.
+         */
+        struct LeafOwner
+        {
+            int lod{ 0 };
+            uint32_t index{ 0 };
+        };
+
+        /**
+         * @brief A change of the leaf list. The render thread repeats the changes in the
+         *        same order, so that its leaves keep the same slots.
+         */
+        struct LeafDelta
+        {
+            enum class Type
+            {
+                ADD,
+                REMOVE
+            };
+
+            Type type{ Type::ADD };
+
+            /**
+             * @brief The slot of a removed leaf; the last leaf is moved into it.
+             */
+            uint32_t slot{ 0 };
+
+            /**
+             * @brief An added leaf; it is appended.
+             */
+            Leaf leaf;
+        };
+
+        using LeafContainer = std::vector<Leaf>;
+        using LeafOwnerContainer = std::vector<LeafOwner>;
+        using LeafDeltaContainer = std::vector<LeafDelta>;
+
+        /**
+         * @brief A part of the root nodes with their subtrees; only one thread works on a chunk.
+         */
+        struct Chunk
+        {
+            Chunk(const int t_nrLods, const uint32_t t_nrRootNodes)
+                : nodePool{ t_nrLods, t_nrRootNodes }
+            {}
+
+            NodePool nodePool;
+
+            /**
+             * @brief The current leaves; changed by the splits and merges of the worker thread.
+             */
+            LeafContainer leaves;
+            LeafOwnerContainer leafOwners;
+
+            /**
+             * @brief The changes of the leaves since the last published update.
+             */
+            LeafDeltaContainer deltas;
+
+            /**
+             * @brief The leaves used by the render thread.
+             */
+            LeafContainer frontLeaves;
+
+            uint32_t evaluatedNodes{ 0 };
+            uint32_t splits{ 0 };
+            uint32_t merges{ 0 };
+
+            /**
+             * @brief Runs the update of the chunk on a worker thread; created once, so that an update doesn't allocate.
+             */
+            std::unique_ptr<ThreadPool::Job> job;
+        };
+
+        using ChunkContainer = std::vector<std::unique_ptr<Chunk>>;
+
+        /**
+         * @brief The camera values used by a running update.
+         */
+        struct LodSnapshot
+        {
+            glm::vec3 cameraPosition{ glm::vec3(0.0f) };
+            std::vector<math::Plane> frustumPlanes;
+            float odometer{ 0.0f };
+        };
+
+        scene::Scene* m_scene{ nullptr };
+
+        TerrainConfigSharedPtr m_terrainConfig;
+
+        ChunkContainer m_chunks;
+
+        /**
+         * @brief The world transform is the same for all nodes.
+         */
+        math::Transform m_worldTransform;
+
+        /**
+         * @brief The distance the camera has moved between the lod evaluations, summed up.
+         */
+        float m_odometer{ 0.0f };
+
+        glm::vec3 m_lastCameraPosition{ glm::vec3(0.0f) };
+        float m_lastCameraYaw{ 0.0f };
+        float m_lastCameraPitch{ 0.0f };
+        bool m_firstUpdate{ true };
+
+        /**
+         * @brief Read by the worker threads; only written while no update is running.
+         */
+        LodSnapshot m_snapshot;
+
+        /**
+         * @brief True from the start of an update until it is published.
+         */
+        bool m_updateRunning{ false };
+
+        uint32_t m_evaluatedNodes{ 0 };
+        uint32_t m_splits{ 0 };
+        uint32_t m_merges{ 0 };
+
+        /**
+         * @brief The patch Mesh with an additional Vbo for the instanced data.
+         */
+        MeshUniquePtr m_patchMesh;
+
+        /**
+         * @brief Vbo Id of instanced data.
+         */
+        uint32_t m_vboId{ 0 };
+
+        /**
+         * @brief Number of instances the Vbo can hold.
+         */
+        uint32_t m_vboSize{ 0 };
+
+        /**
+         * @brief The visible leaves of the current frame.
+         */
+        InstancedDataContainer m_instancedData;
+
+        uint32_t m_instanceCount{ 0 };
+
+        //-------------------------------------------------
+        // Init
+        //-------------------------------------------------
+
+        void InitChunks();
+        void InitPatchMesh();
+
+        //-------------------------------------------------
+        // Jobs
+        //-------------------------------------------------
+
+        [[nodiscard]] bool IsUpdateRunning() const;
+
+        /**
+         * @brief Waits for the running update and applies the leaf deltas of each chunk.
+         */
+        void PublishUpdate();
+
+        /**
+         * @brief Applies the leaf deltas of a chunk to the leaves used by the render thread.
+         */
+        static void ApplyDeltas(Chunk& t_chunk);
+
+        //-------------------------------------------------
+        // Update
+        //-------------------------------------------------
+
+        /**
+         * @brief Runs on a worker thread.
+         */
+        void UpdateChunk(Chunk& t_chunk) const;
+
+        /**
+         * @brief Merges the node if it is out of range. Nodes outside of the view frustum are
+         *        not split; only the out of range nodes of their subtree are merged. A subtree
+         *        is skipped if the camera has not moved far enough to reach one of its lod ranges.
+         * @return The odometer value of the next evaluation of the subtree.
+         */
+        float UpdateNode(Chunk& t_chunk, int t_lod, uint32_t t_index, uint32_t t_planeMask) const;
+
+        /**
+         * @brief Merges the out of range nodes below a node outside of the view frustum.
+         */
+        void MergeOutOfRange(Chunk& t_chunk, Node& t_node) const;
+
+        //-------------------------------------------------
+        // Render
+        //-------------------------------------------------
+
+        /**
+         * @brief Collects the visible leaves of the current camera into the instanced data.
+         */
+        void CollectLeaves();
+
+        /**
+         * @brief Uploads the instanced data.
+         */
+        void UploadLeaves();
+
+        /**
+         * @brief Sets the uniforms used by both, the default and the wireframe shader program.
+         */
+        void SetSharedUniforms(resource::ShaderProgram& t_shaderProgram) const;
+
+        void DrawLeaves() const;
+
+        //-------------------------------------------------
+        // Culling
+        //-------------------------------------------------
+
+        /**
+         * @brief Tests the bounding box of a node against the frustum of the snapshot.
+         * @param t_node The node.
+         * @param t_planeMask The planes which intersect the parent; receives the planes which intersect the node.
+         * @return False if the node and its subtree are outside of the frustum.
+         */
+        bool IsVisible(const Node& t_node, uint32_t& t_planeMask) const;
+
+        //-------------------------------------------------
+        // Add / Remove
+        //-------------------------------------------------
+
+        void InitNode(Node& t_node, int t_lod, const glm::vec2& t_location, const glm::vec2& t_index) const;
+
+        void Split(Chunk& t_chunk, Node& t_node) const;
+        void Merge(Chunk& t_chunk, Node& t_node, uint32_t t_index) const;
+
+        void Add4Children(Chunk& t_chunk, Node& t_node) const;
+        void RemoveChildren(Chunk& t_chunk, Node& t_node) const;
 
+        static void AddLeaf(Chunk& t_chunk, Node& t_node, uint32_t t_index);
+        static void RemoveLeaf(Chunk& t_chunk, Node& t_node);
     };
 }
@@ -0,0 +1,577 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: TiledHeightmap.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include "TiledHeightmap.h"
+#include "Application.h"
+#include "ThreadPool.h"
+#include "SgOglException.h"
+#include "Core.h"
+
+#if defined(_WIN64)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+namespace
+{
+    constexpr char FILE_MAGIC[4]{ 'S', 'G', 'T', 'H' };
+
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t width;
+        uint32_t tileSize;
+        uint32_t tilesPerRow;
+        uint32_t tileStride;
+        uint64_t tileDataOffset;
+    };
+
+    // each tile starts on a page boundary, so that the pages of a tile can be released
+    constexpr size_t PAGE_SIZE{ 4096 };
+
+    constexpr float HEIGHT_NORMALIZATION{ 1.0f / 65535.0f };
+
+    size_t GetTileBytes(const int t_tileSize)
+    {
+        return static_cast<size_t>(t_tileSize) * t_tileSize * sizeof(uint16_t);
+    }
+
+    // the tiles are padded to whole pages
+    size_t GetTileStride(const int t_tileSize)
+    {
+        return (GetTileBytes(t_tileSize) + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    }
+
+    // gives the pages of a copied tile back to the OS
+    void ReleasePages(const uint8_t* t_data, const size_t t_size)
+    {
+#if defined(_WIN64)
+        // the pages of a read-only file mapping are trimmed from the working set by the OS
+        (void)t_data;
+        (void)t_size;
+#else
+        const auto begin{ (reinterpret_cast<uintptr_t>(t_data) + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1) };
+        const auto end{ (reinterpret_cast<uintptr_t>(t_data) + t_size) & ~(PAGE_SIZE - 1) };
+        if (end > begin)
+        {
+            madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+        }
+#endif
+    }
+}
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+sg::ogl::terrain::TiledHeightmap::TiledHeightmap(Application* t_application, const std::string& t_filePath)
+    : m_application{ t_application }
+    , m_filePath{ t_filePath }
+{
+    SG_OGL_CORE_ASSERT(m_application, "[TiledHeightmap::TiledHeightmap()] Null pointer.");
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[TiledHeightmap::TiledHeightmap()] Create TiledHeightmap.");
+
+    Map(t_filePath);
+}
+
+sg::ogl::terrain::TiledHeightmap::~TiledHeightmap() noexcept
+{
+    Log::SG_OGL_CORE_LOG_DEBUG("[TiledHeightmap::~TiledHeightmap()] Destruct TiledHeightmap.");
+
+    // the jobs read the mapping and write into the cache
+    for (auto& job : m_jobs)
+    {
+        job.wait();
+    }
+
+    Unmap();
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+const std::string& sg::ogl::terrain::TiledHeightmap::GetFilePath() const noexcept
+{
+    return m_filePath;
+}
+
+int sg::ogl::terrain::TiledHeightmap::GetWidth() const noexcept
+{
+    return m_width;
+}
+
+int sg::ogl::terrain::TiledHeightmap::GetTileSize() const noexcept
+{
+    return m_tileSize;
+}
+
+int sg::ogl::terrain::TiledHeightmap::GetNumberOfTilesPerRow() const noexcept
+{
+    return m_tilesPerRow;
+}
+
+uint32_t sg::ogl::terrain::TiledHeightmap::GetNumberOfResidentTiles() const
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    return static_cast<uint32_t>(m_tiles.size());
+}
+
+uint32_t sg::ogl::terrain::TiledHeightmap::GetNumberOfPendingTiles() const
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    return static_cast<uint32_t>(m_pendingTiles.size());
+}
+
+void sg::ogl::terrain::TiledHeightmap::GetTileRange(const int t_tileX, const int t_tileZ, float& t_min, float& t_max) const
+{
+    const auto index{ static_cast<size_t>(std::clamp(t_tileZ, 0, m_tilesPerRow - 1)) * m_tilesPerRow + std::clamp(t_tileX, 0, m_tilesPerRow - 1) };
+
+    t_min = m_tileRanges[index * 2] * HEIGHT_NORMALIZATION;
+    t_max = m_tileRanges[index * 2 + 1] * HEIGHT_NORMALIZATION;
+}
+
+const sg::ogl::terrain::TiledHeightmap::TileRangeContainer& sg::ogl::terrain::TiledHeightmap::GetTileRanges() const noexcept
+{
+    return m_tileRanges;
+}
+
+//-------------------------------------------------
+// Paging
+//-------------------------------------------------
+
+void sg::ogl::terrain::TiledHeightmap::Update(const glm::vec2& t_cameraTexel)
+{
+    // forget the finished jobs; rethrows an exception of a job
+    for (auto it{ m_jobs.begin() }; it != m_jobs.end();)
+    {
+        if (it->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            auto job{ std::move(*it) };
+            it = m_jobs.erase(it);
+            job.get();
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    const auto u{ t_cameraTexel.x };
+    const auto v{ t_cameraTexel.y };
+
+    const auto centerTileX{ std::clamp(static_cast<int>(std::floor(u / static_cast<float>(m_tileSize))), 0, m_tilesPerRow - 1) };
+    const auto centerTileZ{ std::clamp(static_cast<int>(std::floor(v / static_cast<float>(m_tileSize))), 0, m_tilesPerRow - 1) };
+
+    // the set of wanted tiles changes only if the camera enters another tile
+    if (centerTileX == m_centerTileX && centerTileZ == m_centerTileZ)
+    {
+        return;
+    }
+
+    m_centerTileX = centerTileX;
+    m_centerTileZ = centerTileZ;
+
+    const auto radius{ pageRadius };
+    const auto radiusTiles{ static_cast<int>(std::ceil(radius / static_cast<float>(m_tileSize))) };
+
+    // the missing tiles, nearest first
+    std::vector<std::pair<float, uint32_t>> requests;
+    uint32_t nrWantedTiles{ 0 };
+
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+
+        for (auto tz{ std::max(centerTileZ - radiusTiles, 0) }; tz <= std::min(centerTileZ + radiusTiles, m_tilesPerRow - 1); ++tz)
+        {
+            for (auto tx{ std::max(centerTileX - radiusTiles, 0) }; tx <= std::min(centerTileX + radiusTiles, m_tilesPerRow - 1); ++tx)
+            {
+                // the distance to the nearest point of the tile
+                const auto dx{ std::max({ static_cast<float>(tx * m_tileSize) - u, 0.0f, u - static_cast<float>((tx + 1) * m_tileSize) }) };
+                const auto dz{ std::max({ static_cast<float>(tz * m_tileSize) - v, 0.0f, v - static_cast<float>((tz + 1) * m_tileSize) }) };
+                const auto distance{ std::sqrt(dx * dx + dz * dz) };
+                if (distance > radius)
+                {
+                    continue;
+                }
+
+                const auto index{ static_cast<uint32_t>(tz * m_tilesPerRow + tx) };
+                ++nrWantedTiles;
+
+                if (auto it{ m_tiles.find(index) }; it != m_tiles.end())
+                {
+                    Touch(it->second);
+                }
+                else if (m_pendingTiles.insert(index).second)
+                {
+                    requests.emplace_back(distance, index);
+                }
+            }
+        }
+    }
+
+    std::sort(requests.begin(), requests.end());
+
+    for (const auto& request : requests)
+    {
+        const auto index{ request.second };
+        m_jobs.push_back(m_application->GetThreadPool().Submit([this, index]()
+        {
+            Insert(index, LoadTile(index));
+        }));
+    }
+
+    if (nrWantedTiles > maxResidentTiles)
+    {
+        Log::SG_OGL_CORE_LOG_WARN("[TiledHeightmap::Update()] The page radius needs {} tiles, but only {} tiles can be resident.", nrWantedTiles, maxResidentTiles);
+    }
+}
+
+//-------------------------------------------------
+// Query
+//-------------------------------------------------
+
+uint16_t sg::ogl::terrain::TiledHeightmap::GetValue(const int t_x, const int t_z)
+{
+    SG_OGL_CORE_ASSERT(t_x >= 0 && t_x < m_width && t_z >= 0 && t_z < m_width, "[TiledHeightmap::GetValue()] Invalid texel.");
+
+    const auto index{ static_cast<uint32_t>((t_z / m_tileSize) * m_tilesPerRow + t_x / m_tileSize) };
+    const auto tile{ GetTile(index) };
+
+    return (*tile)[static_cast<size_t>(t_z % m_tileSize) * m_tileSize + t_x % m_tileSize];
+}
+
+sg::ogl::terrain::TiledHeightmap::TileSharedPtr sg::ogl::terrain::TiledHeightmap::ReadTile(const int t_tileX, const int t_tileZ) const
+{
+    SG_OGL_CORE_ASSERT(t_tileX >= 0 && t_tileX < m_tilesPerRow && t_tileZ >= 0 && t_tileZ < m_tilesPerRow, "[TiledHeightmap::ReadTile()] Invalid tile.");
+
+    return LoadTile(static_cast<uint32_t>(t_tileZ * m_tilesPerRow + t_tileX));
+}
+
+//-------------------------------------------------
+// Create
+//-------------------------------------------------
+
+void sg::ogl::terrain::TiledHeightmap::Write(const std::string& t_filePath, const std::vector<uint16_t>& t_heights, const int t_width, const int t_tileSize)
+{
+    if (t_width <= 0 || t_heights.size() != static_cast<size_t>(t_width) * t_width)
+    {
+        throw SG_OGL_EXCEPTION("[TiledHeightmap::Write()] Invalid number of heights.");
+    }
+
+    WriteTiles(t_filePath, t_width, t_tileSize, [&](const int t_row, uint16_t* t_values)
+    {
+        std::memcpy(t_values, &t_heights[static_cast<size_t>(t_row) * t_width], static_cast<size_t>(t_width) * sizeof(uint16_t));
+    });
+}
+
+void sg::ogl::terrain::TiledHeightmap::ConvertRaw(const std::string& t_filePath, const std::string& t_rawFilePath, const int t_width, const int t_tileSize)
+{
+    std::ifstream rawFile{ t_rawFilePath, std::ios::binary | std::ios::ate };
+    if (!rawFile || t_width <= 0 || static_cast<size_t>(rawFile.tellg()) != static_cast<size_t>(t_width) * t_width * sizeof(uint16_t))
+    {
+        throw SG_OGL_EXCEPTION("[TiledHeightmap::ConvertRaw()] Invalid raw heightmap at path: " + t_rawFilePath);
+    }
+
+    rawFile.seekg(0);
+
+    // the rows are read in order
+    WriteTiles(t_filePath, t_width, t_tileSize, [&](const int, uint16_t* t_values)
+    {
+        rawFile.read(reinterpret_cast<char*>(t_values), static_cast<std::streamsize>(t_width * sizeof(uint16_t)));
+        if (!rawFile)
+        {
+            throw SG_OGL_EXCEPTION("[TiledHeightmap::ConvertRaw()] Error while reading the raw heightmap at path: " + t_rawFilePath);
+        }
+    });
+}
+
+//-------------------------------------------------
+// Mapping
+//-------------------------------------------------
+
+void sg::ogl::terrain::TiledHeightmap::Map(const std::string& t_filePath)
+{
+#if defined(_WIN64)
+    m_fileHandle = CreateFileA(t_filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_fileHandle == INVALID_HANDLE_VALUE)
+    {
+        m_fileHandle = nullptr;
+        throw SG_OGL_EXCEPTION("[TiledHeightmap::Map()] Tiled heightmap failed to open at path: " + t_filePath);
+    }
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(m_fileHandle, &fileSize);
+    m_mappedSize = static_cast<size_t>(fileSize.QuadPart);
+
+    m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m_mappedData = m_mappingHandle ? static_cast<const uint8_t*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+#else
+    m_fileDescriptor = open(t_filePath.c_str(), O_RDONLY);
+    if (m_fileDescriptor < 0)
+    {
+        throw SG_OGL_EXCEPTION("[TiledHeightmap::Map()] Tiled heightmap failed to open at path: " + t_filePath);
+    }
+
+    struct stat fileStat{};
+    fstat(m_fileDescriptor, &fileStat);
+    m_mappedSize = static_cast<size_t>(fileStat.st_size);
+
+    auto* data{ m_mappedSize > 0 ? mmap(nullptr, m_mappedSize, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0) : MAP_FAILED };
+    m_mappedData = data == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(data);
+#endif
+
+    if (!m_mappedData || m_mappedSize < sizeof(FileHeader))
+    {
+        Unmap();
+        throw SG_OGL_EXCEPTION("[TiledHeightmap::Map()] Tiled heightmap failed to map at path: " + t_filePath);
+    }
+
+    FileHeader header{};
+    std::memcpy(&header, m_mappedData, sizeof(FileHeader));
+
+    const auto nrTiles{ static_cast<size_t>(header.tilesPerRow) * header.tilesPerRow };
+    const auto tileRangesEnd{ sizeof(FileHeader) + nrTiles * 2 * sizeof(uint16_t) };
+
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        header.version != VERSION ||
+        header.width == 0 ||
+        header.tileSize == 0 ||
+        header.tilesPerRow != (header.width + header.tileSize - 1) / header.tileSize ||
+        header.tileStride != GetTileStride(static_cast<int>(header.tileSize)) ||
+        header.tileDataOffset < tileRangesEnd ||
+        header.tileDataOffset % PAGE_SIZE != 0 ||
+        m_mappedSize < header.tileDataOffset + nrTiles * header.tileStride)
+    {
+        Unmap();
+        throw SG_OGL_EXCEPTION("[TiledHeightmap::Map()] Invalid tiled heightmap at path: " + t_filePath);
+    }
+
+    m_width = static_cast<int>(header.width);
+    m_tileSize = static_cast<int>(header.tileSize);
+    m_tilesPerRow = static_cast<int>(header.tilesPerRow);
+    m_tileDataOffset = static_cast<size_t>(header.tileDataOffset);
+    m_tileStride = header.tileStride;
+
+    m_tileRanges.resize(nrTiles * 2);
+    std::memcpy(m_tileRanges.data(), m_mappedData + sizeof(FileHeader), m_tileRanges.size() * sizeof(uint16_t));
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[TiledHeightmap::Map()] Mapped a {}x{} heightmap with {}x{} tiles from {}.", m_width, m_width, m_tilesPerRow, m_tilesPerRow, t_filePath);
+}
+
+void sg::ogl::terrain::TiledHeightmap::Unmap() noexcept
+{
+#if defined(_WIN64)
+    if (m_mappedData)
+    {
+        UnmapViewOfFile(m_mappedData);
+    }
+
+    if (m_mappingHandle)
+    {
+        CloseHandle(m_mappingHandle);
+        m_mappingHandle = nullptr;
+    }
+
+    if (m_fileHandle)
+    {
+        CloseHandle(m_fileHandle);
+        m_fileHandle = nullptr;
+    }
+#else
+    if (m_mappedData)
+    {
+        munmap(const_cast<uint8_t*>(m_mappedData), m_mappedSize);
+    }
+
+    if (m_fileDescriptor >= 0)
+    {
+        close(m_fileDescriptor);
+        m_fileDescriptor = -1;
+    }
+#endif
+
+    m_mappedData = nullptr;
+    m_mappedSize = 0;
+}
+
+//-------------------------------------------------
+// Cache
+//-------------------------------------------------
+
+sg::ogl::terrain::TiledHeightmap::TileSharedPtr sg::ogl::terrain::TiledHeightmap::LoadTile(const uint32_t t_index) const
+{
+    const auto tileBytes{ GetTileBytes(m_tileSize) };
+    const auto* src{ m_mappedData + m_tileDataOffset + t_index * m_tileStride };
+
+    auto tile{ std::make_shared<std::vector<uint16_t>>(static_cast<size_t>(m_tileSize) * m_tileSize) };
+    std::memcpy(tile->data(), src, tileBytes);
+
+    // only the copy counts against the resident memory
+    ReleasePages(src, m_tileStride);
+
+    return tile;
+}
+
+sg::ogl::terrain::TiledHeightmap::TileSharedPtr sg::ogl::terrain::TiledHeightmap::GetTile(const uint32_t t_index)
+{
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+
+        if (auto it{ m_tiles.find(t_index) }; it != m_tiles.end())
+        {
+            Touch(it->second);
+            return it->second.tile;
+        }
+    }
+
+    // not resident yet; a job may load the same tile, the first one wins
+    auto tile{ LoadTile(t_index) };
+    Insert(t_index, tile);
+
+    return tile;
+}
+
+void sg::ogl::terrain::TiledHeightmap::Insert(const uint32_t t_index, const TileSharedPtr& t_tile)
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+
+    m_pendingTiles.erase(t_index);
+
+    if (auto it{ m_tiles.find(t_index) }; it != m_tiles.end())
+    {
+        Touch(it->second);
+        return;
+    }
+
+    m_lru.push_front(t_index);
+    m_tiles.emplace(t_index, CacheEntry{ t_tile, m_lru.begin() });
+
+    EvictTiles();
+}
+
+void sg::ogl::terrain::TiledHeightmap::Touch(CacheEntry& t_entry)
+{
+    m_lru.splice(m_lru.begin(), m_lru, t_entry.lruPosition);
+}
+
+void sg::ogl::terrain::TiledHeightmap::EvictTiles()
+{
+    // a tile still used by a query is freed with the last reference
+    while (m_tiles.size() > std::max(maxResidentTiles, 1u))
+    {
+        m_tiles.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+}
+
+//-------------------------------------------------
+// Create
+//-------------------------------------------------
+
+void sg::ogl::terrain::TiledHeightmap::WriteTiles(const std::string& t_filePath, const int t_width, const int t_tileSize, const RowReader& t_readRow)
+{
+    if (t_tileSize <= 0)
+    {
+        throw SG_OGL_EXCEPTION("[TiledHeightmap::WriteTiles()] Invalid tile size.");
+    }
+
+    const auto tilesPerRow{ (t_width + t_tileSize - 1) / t_tileSize };
+    const auto nrTiles{ static_cast<size_t>(tilesPerRow) * tilesPerRow };
+    const auto tileRangesEnd{ sizeof(FileHeader) + nrTiles * 2 * sizeof(uint16_t) };
+
+    FileHeader header{};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = VERSION;
+    header.width = static_cast<uint32_t>(t_width);
+    header.tileSize = static_cast<uint32_t>(t_tileSize);
+    header.tilesPerRow = static_cast<uint32_t>(tilesPerRow);
+    header.tileStride = static_cast<uint32_t>(GetTileStride(t_tileSize));
+    header.tileDataOffset = (tileRangesEnd + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+
+    std::ofstream file{ t_filePath, std::ios::binary | std::ios::trunc };
+    if (!file)
+    {
+        throw SG_OGL_EXCEPTION("[TiledHeightmap::WriteTiles()] Tiled heightmap failed to open at path: " + t_filePath);
+    }
+
+    // the tile ranges are written when all tiles are known
+    std::vector<uint16_t> tileRanges(nrTiles * 2);
+    const std::vector<char> padding(header.tileDataOffset - sizeof(FileHeader), 0);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+    // one row of tiles; the last row and column are repeated to fill the border tiles
+    std::vector<uint16_t> band(static_cast<size_t>(t_width) * t_tileSize);
+    std::vector<uint16_t> tile(static_cast<size_t>(t_tileSize) * t_tileSize);
+    const std::vector<char> tilePadding(header.tileStride - GetTileBytes(t_tileSize), 0);
+
+    for (auto tz{ 0 }; tz < tilesPerRow; ++tz)
+    {
+        for (auto row{ 0 }; row < t_tileSize; ++row)
+        {
+            auto* dst{ &band[static_cast<size_t>(row) * t_width] };
+            if (tz * t_tileSize + row < t_width)
+            {
+                t_readRow(tz * t_tileSize + row, dst);
+            }
+            else
+            {
+                std::memcpy(dst, dst - t_width, static_cast<size_t>(t_width) * sizeof(uint16_t));
+            }
+        }
+
+        for (auto tx{ 0 }; tx < tilesPerRow; ++tx)
+        {
+            uint16_t min{ UINT16_MAX };
+            uint16_t max{ 0 };
+
+            for (auto z{ 0 }; z < t_tileSize; ++z)
+            {
+                for (auto x{ 0 }; x < t_tileSize; ++x)
+                {
+                    const auto value{ band[static_cast<size_t>(z) * t_width + std::min(tx * t_tileSize + x, t_width - 1)] };
+                    tile[static_cast<size_t>(z) * t_tileSize + x] = value;
+                    min = std::min(min, value);
+                    max = std::max(max, value);
+                }
+            }
+
+            const auto index{ static_cast<size_t>(tz) * tilesPerRow + tx };
+            tileRanges[index * 2] = min;
+            tileRanges[index * 2 + 1] = max;
+
+            file.write(reinterpret_cast<const char*>(tile.data()), static_cast<std::streamsize>(tile.size() * sizeof(uint16_t)));
+            file.write(tilePadding.data(), static_cast<std::streamsize>(tilePadding.size()));
+        }
+    }
+
+    file.seekp(sizeof(FileHeader));
+    file.write(reinterpret_cast<const char*>(tileRanges.data()), static_cast<std::streamsize>(tileRanges.size() * sizeof(uint16_t)));
+
+    if (!file)
+    {
+        throw SG_OGL_EXCEPTION("[TiledHeightmap::WriteTiles()] Error while writing the tiled heightmap at path: " + t_filePath);
+    }
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[TiledHeightmap::WriteTiles()] Wrote a {}x{} heightmap with {}x{} tiles to {}.", t_width, t_width, tilesPerRow, tilesPerRow, t_filePath);
+}
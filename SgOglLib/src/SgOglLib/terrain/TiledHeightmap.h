@@ -0,0 +1,250 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: TiledHeightmap.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <functional>
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace sg::ogl
+{
+    class Application;
+}
+
+namespace sg::ogl::terrain
+{
+    /**
+     * @brief A heightmap that does not have to fit into memory. The 16-bit heights are
+     *        stored in square tiles in a memory-mapped file. The tiles around the camera are
+     *        copied into an LRU cache on the worker threads; all other tiles are released,
+     *        so the memory of the cache is bounded by maxResidentTiles. The min/max height
+     *        of every tile is stored in the file and is always available.
+     *        Used as the height source of a TerrainConfig, see TerrainConfig::InitTiledMapsAndMorphing().
+     *        All coordinates are heightmap texels; the TerrainConfig converts from world space.
+     */
+    class TiledHeightmap
+    {
+    public:
+        using TileSharedPtr = std::shared_ptr<const std::vector<uint16_t>>;
+        using TileRangeContainer = std::vector<uint16_t>;
+        using RowReader = std::function<void(int, uint16_t*)>;
+
+        static constexpr uint32_t VERSION{ 2 };
+        static constexpr int DEFAULT_TILE_SIZE{ 256 };
+
+        //-------------------------------------------------
+        // Public member
+        //-------------------------------------------------
+
+        /**
+         * @brief The max number of tiles in the cache.
+         */
+        uint32_t maxResidentTiles{ 64 };
+
+        /**
+         * @brief The tiles within this distance in texels of the camera are paged in.
+         */
+        float pageRadius{ 512.0f };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        TiledHeightmap() = delete;
+
+        /**
+         * @brief Maps a file created with Write() or ConvertRaw().
+         * @param t_application The Application to get the thread pool.
+         * @param t_filePath The file path of the tiled heightmap.
+         */
+        TiledHeightmap(Application* t_application, const std::string& t_filePath);
+
+        TiledHeightmap(const TiledHeightmap& t_other) = delete;
+        TiledHeightmap(TiledHeightmap&& t_other) noexcept = delete;
+        TiledHeightmap& operator=(const TiledHeightmap& t_other) = delete;
+        TiledHeightmap& operator=(TiledHeightmap&& t_other) noexcept = delete;
+
+        ~TiledHeightmap() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        [[nodiscard]] const std::string& GetFilePath() const noexcept;
+        [[nodiscard]] int GetWidth() const noexcept;
+        [[nodiscard]] int GetTileSize() const noexcept;
+        [[nodiscard]] int GetNumberOfTilesPerRow() const noexcept;
+
+        [[nodiscard]] uint32_t GetNumberOfResidentTiles() const;
+        [[nodiscard]] uint32_t GetNumberOfPendingTiles() const;
+
+        /**
+         * @brief The height range of a tile without paging it in.
+         * @param t_tileX The column of the tile.
+         * @param t_tileZ The row of the tile.
+         * @param t_min Receives the min height in heightmap units [0, 1].
+         * @param t_max Receives the max height in heightmap units [0, 1].
+         */
+        void GetTileRange(int t_tileX, int t_tileZ, float& t_min, float& t_max) const;
+
+        /**
+         * @brief The 16-bit min and max height of each tile, row by row.
+         */
+        [[nodiscard]] const TileRangeContainer& GetTileRanges() const noexcept;
+
+        //-------------------------------------------------
+        // Paging
+        //-------------------------------------------------
+
+        /**
+         * @brief Requests the missing tiles around the camera from the worker threads
+         *        and evicts the least recently used tiles.
+         * @param t_cameraTexel The position of the camera in heightmap texels.
+         */
+        void Update(const glm::vec2& t_cameraTexel);
+
+        //-------------------------------------------------
+        // Query
+        //-------------------------------------------------
+
+        /**
+         * @brief The 16-bit height of a texel. A tile which is not resident is loaded immediately.
+         *        Can be called from any thread.
+         * @param t_x The column; must be in [0, width).
+         * @param t_z The row; must be in [0, width).
+         */
+        [[nodiscard]] uint16_t GetValue(int t_x, int t_z);
+
+        /**
+         * @brief Copies a tile without adding it to the cache, e.g. for the upload to the GPU.
+         * @param t_tileX The column of the tile.
+         * @param t_tileZ The row of the tile.
+         * @return The tileSize x tileSize heights, row by row.
+         */
+        [[nodiscard]] TileSharedPtr ReadTile(int t_tileX, int t_tileZ) const;
+
+        //-------------------------------------------------
+        // Create
+        //-------------------------------------------------
+
+        /**
+         * @brief Writes a tiled heightmap file from heights in memory.
+         * @param t_filePath The file path of the tiled heightmap.
+         * @param t_heights The 16-bit heights, row by row.
+         * @param t_width The width and height of the heightmap.
+         * @param t_tileSize The width and height of a tile.
+         */
+        static void Write(const std::string& t_filePath, const std::vector<uint16_t>& t_heights, int t_width, int t_tileSize = DEFAULT_TILE_SIZE);
+
+        /**
+         * @brief Writes a tiled heightmap file from a raw file of 16-bit little-endian heights, row by row.
+         *        Only one row of tiles is held in memory.
+         * @param t_filePath The file path of the tiled heightmap.
+         * @param t_rawFilePath The file path of the raw heights.
+         * @param t_width The width and height of the heightmap.
+         * @param t_tileSize The width and height of a tile.
+         */
+        static void ConvertRaw(const std::string& t_filePath, const std::string& t_rawFilePath, int t_width, int t_tileSize = DEFAULT_TILE_SIZE);
+
+    protected:
+
+    private:
+        using LruContainer = std::list<uint32_t>;
+
+        struct CacheEntry
+        {
+            TileSharedPtr tile;
+            LruContainer::iterator lruPosition;
+        };
+
+        Application* m_application{ nullptr };
+
+        std::string m_filePath;
+
+        int m_width{ 0 };
+        int m_tileSize{ 0 };
+        int m_tilesPerRow{ 0 };
+
+        /**
+         * @brief The min and max height of each tile.
+         */
+        TileRangeContainer m_tileRanges;
+
+        //-------------------------------------------------
+        // Mapping
+        //-------------------------------------------------
+
+        const uint8_t* m_mappedData{ nullptr };
+        size_t m_mappedSize{ 0 };
+        size_t m_tileDataOffset{ 0 };
+
+        /**
+         * @brief The bytes of a tile, padded to a multiple of the page size.
+         */
+        size_t m_tileStride{ 0 };
+
+#if defined(_WIN64)
+        void* m_fileHandle{ nullptr };
+        void* m_mappingHandle{ nullptr };
+#else
+        int m_fileDescriptor{ -1 };
+#endif
+
+        //-------------------------------------------------
+        // Cache
+        //-------------------------------------------------
+
+        /**
+         * @brief The front is the most recently used tile.
+         */
+        LruContainer m_lru;
+
+        std::unordered_map<uint32_t, CacheEntry> m_tiles;
+        std::unordered_set<uint32_t> m_pendingTiles;
+        std::vector<std::future<void>> m_jobs;
+
+        mutable std::mutex m_mutex;
+
+        int m_centerTileX{ -1 };
+        int m_centerTileZ{ -1 };
+
+        //-------------------------------------------------
+        // Mapping
+        //-------------------------------------------------
+
+        void Map(const std::string& t_filePath);
+        void Unmap() noexcept;
+
+        //-------------------------------------------------
+        // Cache
+        //-------------------------------------------------
+
+        [[nodiscard]] TileSharedPtr LoadTile(uint32_t t_index) const;
+        [[nodiscard]] TileSharedPtr GetTile(uint32_t t_index);
+
+        void Insert(uint32_t t_index, const TileSharedPtr& t_tile);
+        void Touch(CacheEntry& t_entry);
+        void EvictTiles();
+
+        //-------------------------------------------------
+        // Create
+        //-------------------------------------------------
+
+        static void WriteTiles(const std::string& t_filePath, int t_width, int t_tileSize, const RowReader& t_readRow);
+    };
+}
@@ -0,0 +1,212 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: VegetationScatter.cpp
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#include <algorithm>
+#include <cmath>
+#include "VegetationScatter.h"
+#include "TerrainConfig.h"
+#include "Application.h"
+#include "ThreadPool.h"
+#include "Core.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+sg::ogl::terrain::VegetationScatter::VegetationScatter(Application* t_application)
+    : m_application{ t_application }
+{
+    SG_OGL_CORE_ASSERT(t_application, "[VegetationScatter::VegetationScatter()] Null pointer.");
+}
+
+//-------------------------------------------------
+// Scatter
+//-------------------------------------------------
+
+sg::ogl::terrain::VegetationScatter::TransformContainer sg::ogl::terrain::VegetationScatter::Scatter(const TerrainConfig& t_terrainConfig) const
+{
+    SG_OGL_CORE_ASSERT(t_terrainConfig.HasHeights(), "[VegetationScatter::Scatter()] No heightmap data available.");
+
+    TransformContainer transforms;
+    if (count == 0)
+    {
+        return transforms;
+    }
+
+    auto& threadPool{ m_application->GetThreadPool() };
+
+    std::vector<CandidateContainer> rows;
+    auto cells{ static_cast<double>(count) * INITIAL_OVERSAMPLING };
+    size_t accepted{ 0 };
+
+    for (auto refinement{ 0u }; refinement <= MAX_REFINEMENTS; ++refinement)
+    {
+        // the cell index has to fit into 32 bits
+        const auto gridSize{ static_cast<uint32_t>(std::clamp(std::ceil(std::sqrt(cells)), 1.0, 65535.0)) };
+
+        rows.assign(gridSize, {});
+        threadPool.ParallelFor(gridSize, [&](const uint32_t t_row)
+        {
+            ScatterRow(t_terrainConfig, gridSize, t_row, rows[t_row]);
+        });
+
+        accepted = 0;
+        for (const auto& row : rows)
+        {
+            accepted += row.size();
+        }
+
+        if (accepted >= count || accepted == 0)
+        {
+            break;
+        }
+
+        // the acceptance rate of this grid + 10%
+        cells *= 1.1 * static_cast<double>(count) / static_cast<double>(accepted);
+    }
+
+    CandidateContainer candidates;
+    candidates.reserve(accepted);
+    for (auto& row : rows)
+    {
+        candidates.insert(candidates.end(), row.begin(), row.end());
+    }
+
+    // a random subset is still uniformly distributed
+    if (candidates.size() > count)
+    {
+        std::nth_element(candidates.begin(), candidates.begin() + count, candidates.end(), [](const Candidate& t_lhs, const Candidate& t_rhs)
+        {
+            return t_lhs.key < t_rhs.key;
+        });
+
+        candidates.resize(count);
+    }
+
+    transforms.reserve(candidates.size());
+    for (const auto& candidate : candidates)
+    {
+        transforms.push_back(candidate.transform);
+    }
+
+    if (transforms.size() < count)
+    {
+        Log::SG_OGL_CORE_LOG_WARN("[VegetationScatter::Scatter()] Only {} of {} instances fit into the height and slope bands.", transforms.size(), count);
+    }
+
+    Log::SG_OGL_CORE_LOG_DEBUG("[VegetationScatter::Scatter()] Created {} instances.", transforms.size());
+
+    return transforms;
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void sg::ogl::terrain::VegetationScatter::ScatterRow(
+    const TerrainConfig& t_terrainConfig,
+    const uint32_t t_gridSize,
+    const uint32_t t_row,
+    CandidateContainer& t_candidates
+) const
+{
+    const auto scaleXz{ t_terrainConfig.scaleXz };
+    const auto start{ -scaleXz * 0.5f + border };
+    const auto cellSize{ (scaleXz - 2.0f * border) / static_cast<float>(t_gridSize) };
+
+    // the distance of the samples for the slope
+    const auto texel{ scaleXz / static_cast<float>(t_terrainConfig.GetHeightmapWidth()) };
+
+    const auto n{ static_cast<size_t>(t_gridSize) };
+    std::vector<float> buffer(11 * n);
+
+    auto* x{ &buffer[0] };
+    auto* z{ &buffer[n] };
+    auto* xLeft{ &buffer[2 * n] };
+    auto* xRight{ &buffer[3 * n] };
+    auto* zDown{ &buffer[4 * n] };
+    auto* zUp{ &buffer[5 * n] };
+    auto* height{ &buffer[6 * n] };
+    auto* heightLeft{ &buffer[7 * n] };
+    auto* heightRight{ &buffer[8 * n] };
+    auto* heightDown{ &buffer[9 * n] };
+    auto* heightUp{ &buffer[10 * n] };
+
+    const auto firstCell{ t_row * t_gridSize };
+
+    for (auto c{ 0u }; c < t_gridSize; ++c)
+    {
+        x[c] = start + (static_cast<float>(c) + ToFloat(Hash(seed, firstCell + c, 0), 0.0f, 1.0f)) * cellSize;
+        z[c] = start + (static_cast<float>(t_row) + ToFloat(Hash(seed, firstCell + c, 1), 0.0f, 1.0f)) * cellSize;
+
+        xLeft[c] = x[c] - texel;
+        xRight[c] = x[c] + texel;
+        zDown[c] = z[c] - texel;
+        zUp[c] = z[c] + texel;
+    }
+
+    // the height and the four neighbours for the slope in five batch calls
+    t_terrainConfig.GetHeightsAt(x, z, height, t_gridSize);
+    t_terrainConfig.GetHeightsAt(xLeft, z, heightLeft, t_gridSize);
+    t_terrainConfig.GetHeightsAt(xRight, z, heightRight, t_gridSize);
+    t_terrainConfig.GetHeightsAt(x, zDown, heightDown, t_gridSize);
+    t_terrainConfig.GetHeightsAt(x, zUp, heightUp, t_gridSize);
+
+    const auto scaleY{ t_terrainConfig.scaleY };
+
+    for (auto c{ 0u }; c < t_gridSize; ++c)
+    {
+        const auto h{ height[c] / scaleY };
+        if (h < minHeight || h > maxHeight)
+        {
+            continue;
+        }
+
+        const auto dx{ (heightRight[c] - heightLeft[c]) / (2.0f * texel) };
+        const auto dz{ (heightUp[c] - heightDown[c]) / (2.0f * texel) };
+        const auto slope{ glm::degrees(std::atan(std::sqrt(dx * dx + dz * dz))) };
+        if (slope < minSlope || slope > maxSlope)
+        {
+            continue;
+        }
+
+        const auto cell{ firstCell + c };
+        const auto scale{ ToFloat(Hash(seed, cell, 2), minScale, maxScale) };
+
+        Candidate candidate;
+        candidate.transform.position = glm::vec3(x[c], height[c] + scale * heightOffset, z[c]);
+        candidate.transform.rotation = baseRotation + glm::vec3(0.0f, ToFloat(Hash(seed, cell, 3), minRotation, maxRotation), 0.0f);
+        candidate.transform.scale = glm::vec3(scale);
+        candidate.key = Hash(seed, cell, 4);
+
+        t_candidates.push_back(candidate);
+    }
+}
+
+uint32_t sg::ogl::terrain::VegetationScatter::Hash(const uint32_t t_seed, const uint32_t t_cell, const uint32_t t_stream)
+{
+    auto h{ t_cell * 0x9E3779B9u + t_stream * 0x85EBCA6Bu + t_seed * 0xC2B2AE35u };
+
+    // lowbias32 finalizer
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+
+    return h;
+}
+
+float sg::ogl::terrain::VegetationScatter::ToFloat(const uint32_t t_random, const float t_min, const float t_max)
+{
+    // the upper 24 bits are exact in a float
+    const auto unit{ static_cast<float>(t_random >> 8) * (1.0f / 16777216.0f) };
+
+    return t_min + unit * (t_max - t_min);
+}
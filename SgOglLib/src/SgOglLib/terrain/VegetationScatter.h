@@ -0,0 +1,162 @@
+// This file is part of the SgOgl package.
+// 
+// Filename: VegetationScatter.h
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2020 (c) stwe <https://github.com/stwe/SgOgl>
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "math/Transform.h"
+
+namespace sg::ogl
+{
+    class Application;
+}
+
+namespace sg::ogl::terrain
+{
+    class TerrainConfig;
+
+    /**
+     * @brief Places model instances on the terrain. The candidates lie on a jittered grid
+     *        and are filtered by height and slope bands. The rows of the grid are processed
+     *        in parallel; every cell has its own random numbers derived from the seed, so the
+     *        result does not depend on the number of threads.
+     */
+    class VegetationScatter
+    {
+    public:
+        using TransformContainer = std::vector<math::Transform>;
+
+        /**
+         * @brief Scatter gives up if the grid had to be refined this often.
+         */
+        static constexpr uint32_t MAX_REFINEMENTS{ 4 };
+
+        /**
+         * @brief The size of the first grid is count * this value cells.
+         */
+        static constexpr float INITIAL_OVERSAMPLING{ 2.0f };
+
+        //-------------------------------------------------
+        // Public member
+        //-------------------------------------------------
+
+        /**
+         * @brief The number of instances.
+         */
+        uint32_t count{ 0 };
+
+        /**
+         * @brief The height band in heightmap units [0, 1].
+         */
+        float minHeight{ 0.0f };
+        float maxHeight{ 1.0f };
+
+        /**
+         * @brief The slope band in degrees.
+         */
+        float minSlope{ 0.0f };
+        float maxSlope{ 90.0f };
+
+        /**
+         * @brief The uniform scale range.
+         */
+        float minScale{ 1.0f };
+        float maxScale{ 1.0f };
+
+        /**
+         * @brief The rotation around the y axis in degrees.
+         */
+        float minRotation{ 0.0f };
+        float maxRotation{ 360.0f };
+
+        /**
+         * @brief Added to the random rotation of each instance.
+         */
+        glm::vec3 baseRotation{ glm::vec3(0.0f) };
+
+        /**
+         * @brief The instances are raised by scale * heightOffset.
+         */
+        float heightOffset{ 0.0f };
+
+        /**
+         * @brief The distance to the terrain border in world units.
+         */
+        float border{ 20.0f };
+
+        uint32_t seed{ 0 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        VegetationScatter() = delete;
+
+        explicit VegetationScatter(Application* t_application);
+
+        VegetationScatter(const VegetationScatter& t_other) = delete;
+        VegetationScatter(VegetationScatter&& t_other) noexcept = delete;
+        VegetationScatter& operator=(const VegetationScatter& t_other) = delete;
+        VegetationScatter& operator=(VegetationScatter&& t_other) noexcept = delete;
+
+        ~VegetationScatter() noexcept = default;
+
+        //-------------------------------------------------
+        // Scatter
+        //-------------------------------------------------
+
+        /**
+         * @brief Creates the instance transforms on the worker threads.
+         * @param t_terrainConfig The terrain with its heightmap data.
+         * @return Up to count transforms; less if the bands are too narrow for the terrain.
+         */
+        [[nodiscard]] TransformContainer Scatter(const TerrainConfig& t_terrainConfig) const;
+
+    protected:
+
+    private:
+        /**
+         * @brief An accepted candidate with a random key for the thinning.
+         */
+        struct Candidate
+        {
+            math::Transform transform;
+            uint32_t key{ 0 };
+        };
+
+        using CandidateContainer = std::vector<Candidate>;
+
+        Application* m_application{ nullptr };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * @brief Creates the accepted candidates of one grid row.
+         */
+        void ScatterRow(
+            const TerrainConfig& t_terrainConfig,
+            uint32_t t_gridSize,
+            uint32_t t_row,
+            CandidateContainer& t_candidates
+        ) const;
+
+        /**
+         * @brief A random number for each (cell, stream); the same for every thread.
+         */
+        static uint32_t Hash(uint32_t t_seed, uint32_t t_cell, uint32_t t_stream);
+
+        /**
+         * @brief Maps a random number to [t_min, t_max).
+         */
+        static float ToFloat(uint32_t t_random, float t_min, float t_max);
+    };
+}
@@ -122,3 +122,49 @@ project "Sandbox"
     filter "configurations:Release"
         runtime "Release"
         optimize "On"
+
+project "Benchmark"
+    location "Benchmark"
+    architecture "x64"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+
+    targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+    objdir ("obj/" .. outputdir .. "/%{prj.name}")
+
+    files
+    {
+        "%{prj.name}/src/**.h",
+        "%{prj.name}/src/**.cpp"
+    }
+
+    includedirs
+    {
+        "%{prj.name}/src",
+        "SgOglLib/src",
+        "SgOglLib/src/SgOglLib",
+        "SgOglLib/vendor",
+    }
+
+    links
+    {
+        "SgOglLib"
+    }
+
+    linkoptions
+    {
+        "/IGNORE:4099"
+    }
+
+    filter "system:windows"
+        systemversion "latest"
+
+    filter "configurations:Debug"
+        defines "SG_OGL_DEBUG_BUILD"
+        runtime "Debug"
+        symbols "On"
+
+    filter "configurations:Release"
+        runtime "Release"
+        optimize "On"